@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include "bench.h"
+#include "core/node.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+
+// libraft_alloc_bench is a binary of its own, as it replaces the global
+// operator new to count the allocations of the process, which would skew
+// the other benchmarks. The allocations are counted only while allocCounting
+// is set, so that the application side (storage) can be excluded.
+static bool allocCounting = false;
+static uint64_t allocCount = 0;
+
+void* operator new(size_t size) {
+  if (allocCounting) {
+    ++allocCount;
+  }
+  void *p = malloc(size == 0 ? 1 : size);
+  if (p == NULL) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+namespace libraft {
+
+static const int kWarmupProposals = 1000;
+static const int kProposals = 10000;
+
+static NodeImpl*
+newLeaderNode(int replicas, MemoryStorage *s, Logger *logger) {
+  Config c;
+  c.id = 1;
+  int i;
+  for (i = 0; i < replicas; ++i) {
+    c.peers.push_back(i + 1);
+  }
+  c.storage = s;
+  c.logger = logger;
+  c.maxInflightMsgs = 256;
+  c.readOnlyOption = ReadOnlySafe;
+
+  raft *r = newRaft(&c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  for (i = 2; i <= replicas; ++i) {
+    r->progressMap_[i]->becomeReplicate();
+  }
+  return new NodeImpl(logger, r);
+}
+
+// handleReady persists the Ready and acks the appended entries from all followers.
+static void
+handleReady(NodeImpl *n, Ready *ready, MemoryStorage *s, vector<Message> *resps) {
+  while (ready != NULL) {
+    allocCounting = false;
+    s->Append(ready->entries);
+    resps->clear();
+    size_t i;
+    for (i = 0; i < ready->messages.size(); ++i) {
+      const Message *msg = ready->messages[i];
+      if (msg->type() != MsgApp) {
+        continue;
+      }
+      resps->push_back(Message());
+      Message& resp = resps->back();
+      resp.set_type(MsgAppResp);
+      resp.set_from(msg->to());
+      resp.set_to(1);
+      resp.set_term(msg->term());
+      resp.set_index(msg->index() + msg->entries_size());
+    }
+    allocCounting = true;
+
+    n->Advance();
+    ready = NULL;
+    for (i = 0; i < resps->size(); ++i) {
+      Ready *r;
+      n->Step((*resps)[i], &r);
+      if (r != NULL) {
+        ready = r;
+      }
+    }
+  }
+}
+
+static void
+benchReplicas(int replicas) {
+  // owned by the node
+  Logger *logger = new nullLogger();
+  MemoryStorage *s = new MemoryStorage(logger);
+  NodeImpl *n = newLeaderNode(replicas, s, logger);
+  vector<Message> resps;
+  resps.reserve(replicas);
+
+  int i;
+  uint64_t allocs = 0;
+  for (i = 0; i < kWarmupProposals + kProposals; ++i) {
+    allocCount = 0;
+    allocCounting = true;
+    Ready *ready;
+    n->Propose("somedata", &ready);
+    handleReady(n, ready, s, &resps);
+    allocCounting = false;
+    if (i >= kWarmupProposals) {
+      allocs += allocCount;
+    }
+  }
+
+  printf("replicas=%d: %d proposals, %.2f allocations per proposal\n",
+         replicas, kProposals, (double)allocs / kProposals);
+  delete n;
+}
+
+}; // namespace libraft
+
+int main(int argc, char* argv[]) {
+  printf("== Allocations\n");
+  libraft::benchReplicas(3);
+  libraft::benchReplicas(5);
+  return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_BENCH_H__
+#define __LIBRAFT_BENCH_H__
+
+#include <stdint.h>
+#include <sys/time.h>
+#include "libraft.h"
+
+namespace libraft {
+
+// benchmarks, run by bench/main.cc
+extern void benchEncodeMessages();
+extern void benchTick();
+extern void benchConcurrentPropose();
+extern void benchQuorumCommit();
+extern void benchReadIndex();
+
+// nullLogger drops all the logs, raft logs on every append
+// which would otherwise dominate the benchmarks.
+class nullLogger : public Logger {
+public:
+  void Debugf(const char *file, int line, const char *fmt, ...) {}
+  void Infof(const char *file, int line, const char *fmt, ...) {}
+  void Warningf(const char *file, int line, const char *fmt, ...) {}
+  void Errorf(const char *file, int line, const char *fmt, ...) {}
+  void Fatalf(const char *file, int line, const char *fmt, ...) { abort(); }
+};
+
+static inline uint64_t
+nowMicros() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_BENCH_H__
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include "bench.h"
+#include "core/progress.h"
+
+namespace libraft {
+
+static const int kAcks = 1000000;
+
+// benchQuorumCommit measures the computation of the index replicated on a
+// quorum after each ack, by sorting the match indexes of all the voters as
+// maybeCommit used to, and by the incremental quorumTracker.
+void
+benchQuorumCommit() {
+  const int votersList[] = {3, 5, 9, 51};
+  size_t n;
+  for (n = 0; n < sizeof(votersList) / sizeof(votersList[0]); ++n) {
+    int voters = votersList[n];
+    int quorum = voters / 2 + 1;
+    nullLogger logger;
+    vector<Progress*> prs;
+    quorumTracker tracker;
+    int i;
+    for (i = 0; i < voters; ++i) {
+      prs.push_back(new Progress(1, 256, &logger));
+    }
+
+    // the voters ack in turn, one entry per ack
+    vector<uint64_t> matches;
+    uint64_t sum = 0;
+    uint64_t start = nowMicros();
+    for (i = 0; i < kAcks; ++i) {
+      Progress *pr = prs[i % voters];
+      pr->setMatch(pr->match_ + 1);
+      matches.clear();
+      size_t j;
+      for (j = 0; j < prs.size(); ++j) {
+        matches.push_back(prs[j]->match_);
+      }
+      sort(matches.begin(), matches.end(), greater<uint64_t>());
+      sum += matches[quorum - 1];
+    }
+    uint64_t sortElapsed = nowMicros() - start;
+
+    for (i = 0; i < voters; ++i) {
+      prs[i]->setMatch(0);
+      tracker.add(prs[i]);
+    }
+    start = nowMicros();
+    for (i = 0; i < kAcks; ++i) {
+      Progress *pr = prs[i % voters];
+      pr->maybeUpdate(pr->match_ + 1);
+      sum -= tracker.quorumIndex(quorum);
+    }
+    uint64_t trackerElapsed = nowMicros() - start;
+
+    printf("voters=%d: sort %.1f ns per ack, tracker %.1f ns per ack%s\n",
+           voters, sortElapsed * 1000.0 / kAcks, trackerElapsed * 1000.0 / kAcks,
+           sum == 0 ? "" : " (MISMATCH)");
+    for (i = 0; i < voters; ++i) {
+      delete prs[i];
+    }
+  }
+}
+
+}; // namespace libraft
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "bench.h"
+#include "core/concurrent_node.h"
+#include "core/node.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+
+namespace libraft {
+
+static const int kProposeThreads = 32;
+static const int kProposalsPerThread = 20000;
+
+static NodeImpl*
+newSingleNode(MemoryStorage **storage) {
+  Config c;
+  c.id = 1;
+  c.peers.push_back(1);
+  c.logger = new nullLogger();
+  c.storage = *storage = new MemoryStorage(c.logger);
+  c.readOnlyOption = ReadOnlySafe;
+  c.maxSizePerMsg = kNoLimit;
+
+  raft *r = newRaft(&c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  return new NodeImpl(c.logger, r);
+}
+
+// saveReady saves the entries of ready and returns the number of proposals applied
+static int
+saveReady(MemoryStorage *s, const Ready& ready) {
+  s->Append(ready.entries);
+  int applied = 0;
+  size_t i;
+  for (i = 0; i < ready.committedEntries.size(); ++i) {
+    if (!ready.committedEntries[i]->data().empty()) {
+      ++applied;
+    }
+  }
+  return applied;
+}
+
+struct countingHandler : public ReadyHandler {
+  MemoryStorage *storage;
+  std::atomic<int> applied;
+
+  countingHandler() : storage(NULL), applied(0) {}
+
+  void HandleReady(const Ready& ready) {
+    applied += saveReady(storage, ready);
+  }
+};
+
+static void
+benchConcurrentNode() {
+  countingHandler handler;
+  ConcurrentNodeConfig c;
+  c.node = newSingleNode(&handler.storage);
+  c.handler = &handler;
+  ConcurrentNode *node = NewConcurrentNode(c);
+
+  const int total = kProposeThreads * kProposalsPerThread;
+  uint64_t start = nowMicros();
+  vector<std::thread> threads;
+  int t;
+  for (t = 0; t < kProposeThreads; ++t) {
+    threads.push_back(std::thread([node]() {
+      int i;
+      for (i = 0; i < kProposalsPerThread; ++i) {
+        node->Propose("somedata");
+      }
+    }));
+  }
+  for (t = 0; t < kProposeThreads; ++t) {
+    threads[t].join();
+  }
+  while (handler.applied < total) {
+    usleep(100);
+  }
+  uint64_t elapsed = nowMicros() - start;
+
+  ConcurrentNodeImpl *impl = static_cast<ConcurrentNodeImpl*>(node);
+  printf("concurrent node: %d threads, %.0f proposals/s, %.1f proposals per Ready\n",
+         kProposeThreads, total * 1e6 / elapsed, (double)total / impl->readies_);
+  delete node;
+}
+
+// the Node behind a big mutex, each proposal takes its own Ready
+static void
+benchMutexNode() {
+  MemoryStorage *storage;
+  NodeImpl *node = newSingleNode(&storage);
+  std::mutex mutex;
+
+  const int total = kProposeThreads * kProposalsPerThread;
+  uint64_t start = nowMicros();
+  vector<std::thread> threads;
+  int t;
+  for (t = 0; t < kProposeThreads; ++t) {
+    threads.push_back(std::thread([node, storage, &mutex]() {
+      int i;
+      for (i = 0; i < kProposalsPerThread; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Ready *ready;
+        node->Propose("somedata", &ready);
+        while (ready != NULL) {
+          saveReady(storage, *ready);
+          node->Advance();
+          node->PollReady(&ready);
+        }
+      }
+    }));
+  }
+  for (t = 0; t < kProposeThreads; ++t) {
+    threads[t].join();
+  }
+  uint64_t elapsed = nowMicros() - start;
+
+  printf("mutex node:      %d threads, %.0f proposals/s\n",
+         kProposeThreads, total * 1e6 / elapsed);
+  delete node;
+}
+
+void
+benchConcurrentPropose() {
+  benchMutexNode();
+  benchConcurrentNode();
+}
+
+}; // namespace libraft
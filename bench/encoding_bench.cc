@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+
+namespace libraft {
+
+static const int kRounds = 2000;
+static const int kEntriesPerRound = 16;
+static const int kEntrySize = 1024;
+
+static raft*
+newLeader(int replicas, MemoryStorage *s, Logger *logger) {
+  Config c;
+  c.id = 1;
+  int i;
+  for (i = 0; i < replicas; ++i) {
+    c.peers.push_back(i + 1);
+  }
+  c.storage = s;
+  c.logger = logger;
+  c.readOnlyOption = ReadOnlySafe;
+
+  raft *r = newRaft(&c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  for (i = 2; i <= replicas; ++i) {
+    r->progressMap_[i]->becomeReplicate();
+  }
+  return r;
+}
+
+static void
+clearMessages(raft *r) {
+  MessageVec msgs;
+  r->readMessages(&msgs);
+  size_t i;
+  for (i = 0; i < msgs.size(); ++i) {
+    delete msgs[i];
+  }
+}
+
+// ack acknowledges the appended entries from all followers and persists them,
+// so the leader keeps replicating in ProgressStateReplicate.
+static void
+ack(raft *r, MemoryStorage *s, int replicas) {
+  SharedEntryVec unstable;
+  r->raftLog_->unstableEntries(&unstable);
+  s->Append(unstable);
+  r->raftLog_->stableTo(r->raftLog_->lastIndex(), r->raftLog_->lastTerm());
+
+  int i;
+  for (i = 2; i <= replicas; ++i) {
+    Message resp;
+    resp.set_type(MsgAppResp);
+    resp.set_from(i);
+    resp.set_to(1);
+    resp.set_term(r->term_);
+    resp.set_index(r->raftLog_->lastIndex());
+    r->step(resp);
+  }
+  clearMessages(r);
+}
+
+static void
+benchReplicas(int replicas) {
+  nullLogger logger;
+  MemoryStorage *s = new MemoryStorage(&logger);
+  raft *r = newLeader(replicas, s, &logger);
+  clearMessages(r);
+
+  string data(kEntrySize, 'x');
+  uint64_t naive = 0, shared = 0, bytes = 0;
+  int round;
+  for (round = 0; round < kRounds; ++round) {
+    EntryVec entries(kEntriesPerRound);
+    int i;
+    for (i = 0; i < kEntriesPerRound; ++i) {
+      entries[i].set_type(EntryNormal);
+      entries[i].set_data(data);
+    }
+    r->propose(&entries);
+
+    MessageVec msgs;
+    r->readMessages(&msgs);
+
+    uint64_t start = nowMicros();
+    size_t j;
+    for (j = 0; j < msgs.size(); ++j) {
+      string out;
+      msgs[j]->SerializeToString(&out);
+      bytes += out.size();
+    }
+    naive += nowMicros() - start;
+
+    start = nowMicros();
+    vector<EncodedMessage> encoded;
+    EncodeMessages(msgs, &encoded);
+    shared += nowMicros() - start;
+
+    for (j = 0; j < msgs.size(); ++j) {
+      delete msgs[j];
+    }
+    ack(r, s, replicas);
+  }
+
+  printf("replicas=%d: %d rounds of %d x %dB entries, %llu bytes encoded, "
+         "SerializeToString %.2f us/round, EncodeMessages %.2f us/round, speedup %.2fx\n",
+         replicas, kRounds, kEntriesPerRound, kEntrySize, (unsigned long long)bytes,
+         (double)naive / kRounds, (double)shared / kRounds,
+         shared > 0 ? (double)naive / shared : 0.0);
+  delete r;
+}
+
+void
+benchEncodeMessages() {
+  benchReplicas(3);
+  benchReplicas(5);
+  benchReplicas(7);
+}
+
+}; // namespace libraft
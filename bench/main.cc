@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+using namespace libraft;
+
+struct benchmark {
+  const char* name;
+  void (*fun)();
+};
+
+static benchmark kBenchmarks[] = {
+  {"EncodeMessages", benchEncodeMessages},
+  {"Tick",           benchTick},
+  {"ConcurrentPropose", benchConcurrentPropose},
+  {"QuorumCommit",   benchQuorumCommit},
+  {"ReadIndex",      benchReadIndex},
+};
+
+// usage: libraft_bench [name], run the benchmarks whose name contains `name', or all
+int main(int argc, char* argv[]) {
+  size_t i;
+  for (i = 0; i < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++i) {
+    if (argc > 1 && strstr(kBenchmarks[i].name, argv[1]) == NULL) {
+      continue;
+    }
+    printf("== %s\n", kBenchmarks[i].name);
+    kBenchmarks[i].fun();
+  }
+  return 0;
+}
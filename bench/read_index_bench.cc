@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+
+namespace libraft {
+
+static const int kOutstandingReads = 10000;
+static const int kRounds = 100;
+
+// benchReadIndex measures the ReadIndex requests of a leader of 3 voters
+// under ReadOnlySafe, kOutstandingReads are queued behind a heartbeat round
+// in flight before the quorum acks the rounds.
+void
+benchReadIndex() {
+  nullLogger logger;
+  Config c;
+  c.id = 1;
+  c.peers = {1, 2, 3};
+  c.logger = &logger;
+  c.storage = new MemoryStorage(&logger);
+  c.electionTick = 10;
+  c.heartbeatTick = 1;
+  c.readOnlyOption = ReadOnlySafe;
+  raft *r = newRaft(&c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  r->raftLog_->commitTo(r->raftLog_->lastIndex());
+
+  Message read;
+  read.set_from(1);
+  read.set_to(1);
+  read.set_type(MsgReadIndex);
+  read.add_entries()->set_data("read request context");
+
+  Message ack;
+  ack.set_from(2);
+  ack.set_to(1);
+  ack.set_type(MsgHeartbeatResp);
+  ack.set_term(r->term_);
+
+  MessageVec msgs;
+  uint64_t states = 0, enqueue = 0, confirm = 0;
+  int i, j;
+  for (i = 0; i < kRounds; ++i) {
+    uint64_t start = nowMicros();
+    for (j = 0; j < kOutstandingReads; ++j) {
+      r->step(read);
+    }
+    enqueue += nowMicros() - start;
+
+    // acking the round in flight starts the round of the queued requests
+    start = nowMicros();
+    while (states < (uint64_t)(i + 1) * kOutstandingReads) {
+      r->readMessages(&msgs);
+      size_t k;
+      for (k = 0; k < msgs.size(); ++k) {
+        if (msgs[k]->type() == MsgHeartbeat) {
+          ack.set_context(msgs[k]->context());
+        }
+      }
+      r->step(ack);
+      states += r->readStates_.size();
+      for (k = 0; k < r->readStates_.size(); ++k) {
+        delete r->readStates_[k];
+      }
+      r->readStates_.clear();
+    }
+    confirm += nowMicros() - start;
+  }
+
+  uint64_t reads = (uint64_t)kRounds * kOutstandingReads;
+  printf("outstanding=%d: enqueue %.1f ns per read, confirm %.1f ns per read%s\n",
+         kOutstandingReads, enqueue * 1000.0 / reads, confirm * 1000.0 / reads,
+         states == reads ? "" : " (MISMATCH)");
+  delete r;
+}
+
+}; // namespace libraft
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "core/multi_node.h"
+#include "core/node.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+
+namespace libraft {
+
+static const int kTickGroups = 100000;
+static const int kTicks = 200;
+
+// electionTick/heartbeatTick, a fine grained tick as the timing wheel
+// only visits the groups at their deadline.
+static const int kElectionTick = 100;
+static const int kHeartbeatTick = 10;
+
+// drainReadies persists and advances all the readies of m
+static void
+drainReadies(MultiNode *m, map<uint64_t, MemoryStorage*> *storages) {
+  GroupReadyVec readies;
+  m->Readies(&readies);
+  while (!readies.empty()) {
+    size_t i;
+    for (i = 0; i < readies.size(); ++i) {
+      (*storages)[readies[i].groupId]->Append(readies[i].ready->entries);
+    }
+    m->Advance(readies);
+    m->Readies(&readies);
+  }
+}
+
+// benchTick measures Tick of a MultiNode hosting kTickGroups single voter
+// groups, every group heartbeats every kHeartbeatTick ticks.
+void
+benchTick() {
+  MultiNode *m = NewMultiNode();
+  map<uint64_t, MemoryStorage*> storages;
+  vector<Peer> peers(1);
+  peers[0].Id = 1;
+  uint64_t group;
+  for (group = 1; group <= kTickGroups; ++group) {
+    Config c;
+    c.id = 1;
+    c.logger = new nullLogger();
+    c.storage = storages[group] = new MemoryStorage(c.logger);
+    c.electionTick = kElectionTick;
+    c.heartbeatTick = kHeartbeatTick;
+    m->CreateGroup(group, &c, peers);
+  }
+  drainReadies(m, &storages);
+
+  // the groups campaign at their election timeout
+  int i;
+  for (i = 0; i < 2 * kElectionTick; ++i) {
+    m->Tick();
+    drainReadies(m, &storages);
+  }
+
+  MultiNodeImpl *impl = static_cast<MultiNodeImpl*>(m);
+  uint64_t fired = 0;
+  uint64_t start = nowMicros();
+  for (i = 0; i < kTicks; ++i) {
+    m->Tick();
+    fired += impl->expired_.size();
+    drainReadies(m, &storages);
+  }
+  uint64_t elapsed = nowMicros() - start;
+
+  printf("timing wheel: groups=%d, %d ticks, %.1f groups fired per tick, %.1f us per tick\n",
+         kTickGroups, kTicks, (double)fired / kTicks, (double)elapsed / kTicks);
+
+  // compare with ticking every group on every tick
+  start = nowMicros();
+  for (i = 0; i < kTicks; ++i) {
+    map<uint64_t, raftGroup*>::iterator iter;
+    for (iter = impl->groups_.begin(); iter != impl->groups_.end(); ++iter) {
+      Ready *ready;
+      iter->second->node_->Tick(&ready);
+      if (ready != NULL) {
+        iter->second->node_->Advance();
+      }
+    }
+  }
+  elapsed = nowMicros() - start;
+  printf("all groups:   groups=%d, %d ticks, %.1f us per tick\n",
+         kTickGroups, kTicks, (double)elapsed / kTicks);
+  delete m;
+}
+
+}; // namespace libraft
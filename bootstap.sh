@@ -7,7 +7,7 @@ third_party=${pwd}/third_party
 rm -fr ${third_party}
 mkdir -p ${third_party}
 
-protobuf=protobuf-3.14.0
+protobuf=protobuf-3.21.12
 gtest=googletest-release-1.8.0
 gflags=gflags-2.2.2
 libevent=libevent-2.1.12-stable
@@ -7,10 +7,14 @@
 
 #include <cstdint>
 #include <climits>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include "proto/raft.pb.h"
 
+struct event_base;
+
 using namespace std;
 using namespace raftpb;
 
@@ -41,6 +45,35 @@ enum ErrorCode {
   // ErrSerializeFail is returned by the Node interface when the request data Serialize failed. 
   ErrSerializeFail                  = 5,
 
+  // ErrGroupNotFound is returned by the MultiNode interface when the raft group does not exist.
+  ErrGroupNotFound                  = 6,
+
+  // ErrGroupExists is returned by MultiNode.CreateGroup when the raft group already exists.
+  ErrGroupExists                    = 7,
+
+  // ErrInvalidConfig is returned by MultiNode.CreateGroup when the raft config is invalid,
+  // or has asyncReady set.
+  ErrInvalidConfig                  = 8,
+
+  // ErrListenFail is returned by EventDriver.Start when it cannot listen on the local address.
+  ErrListenFail                     = 9,
+
+  // ErrStopped is returned by ConcurrentNode when it has been stopped.
+  ErrStopped                        = 10,
+
+  // ErrProposalDropped is returned when a proposal is dropped: there is no leader,
+  // the leader is transferring its leadership or has been removed, or the entry of
+  // the proposal has been overwritten by the entry of another leader.
+  ErrProposalDropped                = 11,
+
+  // ErrTermChanged is returned to a proposal callback when the term changed before
+  // the entry of the proposal committed, the entry may still be committed.
+  ErrTermChanged                    = 12,
+
+  // ErrReadIndexDropped is returned to a read callback when there is no leader
+  // to serve the read index.
+  ErrReadIndexDropped               = 13,
+
   // Number of error code
   NumErrorCode
 };
@@ -53,6 +86,14 @@ kErrString[NumErrorCode] = {
   "ErrUnavailable",
   "ErrSnapshotTemporarilyUnavailable",
   "ErrSerializeFail",
+  "ErrGroupNotFound",
+  "ErrGroupExists",
+  "ErrInvalidConfig",
+  "ErrListenFail",
+  "ErrStopped",
+  "ErrProposalDropped",
+  "ErrTermChanged",
+  "ErrReadIndexDropped",
 };
 
 inline const char* 
@@ -101,6 +142,12 @@ struct ReadState {
 typedef vector<Entry> EntryVec;
 typedef vector<Message*> MessageVec;
 
+// SharedEntry is an immutable, reference counted log entry. The unstable log
+// and Ready hold SharedEntry handles to the same allocation, so an entry
+// payload is not copied each time it is handed out.
+typedef std::shared_ptr<const Entry> SharedEntry;
+typedef vector<SharedEntry> SharedEntryVec;
+
 struct Ready {
  	// The current volatile state of a Node.
 	// SoftState will be nil if there is no update.
@@ -120,7 +167,8 @@ struct Ready {
 
 	// Entries specifies entries to be saved to stable storage BEFORE
 	// Messages are sent.
-  EntryVec          entries;
+	// The entries are shared with the unstable log, they MUST NOT be modified.
+  SharedEntryVec    entries;
 
   // Snapshot specifies the snapshot to be saved to stable storage.
   Snapshot          *snapshot;
@@ -128,13 +176,23 @@ struct Ready {
 	// CommittedEntries specifies entries to be committed to a
 	// store/state-machine. These have previously been committed to stable
 	// store.
-  EntryVec          committedEntries;
+  SharedEntryVec    committedEntries;
 
  	// Messages specifies outbound messages to be sent AFTER Entries are
 	// committed to stable storage.
 	// If it contains a MsgSnap message, the application MUST report back to raft
 	// when the snapshot has been received or has failed by calling ReportSnapshot.
+	// The messages and the read states are allocated from the arena of the Node,
+	// the transport hands them back to it, all at once, by Advance (AdvanceSent
+	// with Config.asyncReady) once they are serialized, so they MUST NOT be
+	// used afterwards. The entries of a MsgApp are those of the log, shared by
+	// the MsgApps to every follower, so the messages MUST NOT be modified.
   MessageVec  messages;
+
+  // SendFirst is set when Messages may be sent before Entries and HardState
+  // are saved: on a leader with Config.parallelAppend whose term and vote
+  // have been saved by an earlier Ready.
+  bool        sendFirst;
 };
 
 // Storage is an interface that may be implemented by the application
@@ -175,12 +233,34 @@ public:
 	// so raft state machine could know that Storage needs some time to prepare
 	// snapshot and call Snapshot later.
   virtual int GetSnapshot(Snapshot **snapshot) = 0;
-
-  //int SetHardState(const HardState& );
-  //virtual int Append(const EntryVec& entries) = 0;
   //virtual int CreateSnapshot(uint64_t i, ConfState *cs, const string& data, Snapshot *ss) = 0;
 };
 
+// WritableStorage is a Storage which the drivers running a Node, see
+// EventDriver, save the state of each Ready to. A Node only needs a Storage.
+class WritableStorage : public Storage {
+public:
+  virtual ~WritableStorage() {}
+
+  // SetHardState, Append and ApplySnapshot save the state of a Ready.
+  virtual int SetHardState(const HardState& ) = 0;
+  virtual int Append(const SharedEntryVec& entries) = 0;
+  virtual int ApplySnapshot(const Snapshot& snapshot) = 0;
+
+  // SetConfState saves the ConfState of the Node once a conf change
+  // is applied, InitialState returns it afterwards.
+  virtual int SetConfState(const ConfState& cs) = 0;
+};
+
+// Clock is the monotonic clock used by raft to measure time below the tick,
+// Now returns the time in microseconds.
+class Clock {
+public:
+  virtual uint64_t Now() = 0;
+
+  virtual ~Clock() {}
+};
+
 class Logger {
 public:
   virtual void Debugf(const char *file, int line, const char *fmt, ...) = 0;
@@ -202,7 +282,8 @@ enum ReadOnlyOption {
   // relying on the leader lease. It can be affected by clock drift.
   // If the clock drift is unbounded, leader might keep the lease longer than it
   // should (clock can move backward/pause without any bound). ReadIndex is not safe
-  // in that case.
+  // in that case. See Config.leaseDuration, the requests are served as
+  // ReadOnlySafe when the leader does not hold the lease.
   ReadOnlyLeaseBased = 1
 };
 
@@ -217,6 +298,11 @@ struct Config {
   // used for testing right now.
   vector<uint64_t>  peers;
 
+  // learners contains the IDs of all learner nodes (including self if the
+  // local node is a learner) in the raft cluster. learners only receive
+  // entries from the leader node. It does not vote or promote itself.
+  vector<uint64_t>  learners;
+
   // electionTick is the number of Node.Tick invocations that must pass between
   // elections. That is, if a follower does not receive any message from the
   // leader of current term before ElectionTick has elapsed, it will become
@@ -258,6 +344,26 @@ struct Config {
   // limit the proposal rate?
   uint64_t          maxInflightMsgs = 1024;
 
+  // maxInflightBytes limits the total bytes of the entry payloads in flight to
+  // a follower during optimistic replication, along with maxInflightMsgs. It
+  // keeps the leader memory and the transport buffers bounded whatever the size
+  // of the entries, a single message may still exceed it. 0 for no limit.
+  uint64_t          maxInflightBytes = 0;
+
+  // adaptiveInflight adapts the in-flight window and the message size of each
+  // follower to its link, like a delay based TCP congestion control: they grow
+  // while the round trip of MsgApp stays close to the lowest one seen, and shrink
+  // once messages queue up on the way. The window stays within
+  // [minInflightMsgs, maxInflightMsgs] and the size within
+  // [minSizePerMsg, maxSizePerMsg].
+  bool              adaptiveInflight = false;
+  uint64_t          minInflightMsgs = 4;
+  uint64_t          minSizePerMsg = 64 * 1024;
+
+  // clock measures the round trips and the leader lease, if it is NULL, a
+  // steady clock is used.
+  Clock*            clock = NULL;
+
   // checkQuorum specifies if the leader should check quorum activity. Leader
   // steps down when quorum is not active for an electionTimeout.
   bool checkQuorum = false;
@@ -267,6 +373,32 @@ struct Config {
   // rejoins the cluster.
   bool preVote = false;
 
+  // quiesce enables the leader to quiesce the group when it is idle, that is when
+  // all the followers have caught up and there is no pending read or conf change.
+  // The leader sends a last heartbeat marked as quiesce and stops ticking, the
+  // followers receiving it suspend their election timers. Any proposal, campaign
+  // or incoming message wakes the group. Since a quiescent follower cannot detect
+  // the loss of the leader, the application MUST wake it when the leader is down.
+  bool quiesce = false;
+
+  // asyncReady enables the asynchronous Ready pipeline of a Node. A new Ready is
+  // returned without waiting for the previous ones, it only carries what has not
+  // been handed out yet, and its stages are acknowledged independently by
+  // AdvanceStable, AdvanceSent and AdvanceApplied instead of Advance. So the
+  // entries of a Ready can be persisted while the entries of an earlier one are
+  // applied. Committed entries are only handed out once they are stable locally.
+  // MultiNode, EventDriver and ConcurrentNode advance their Readies with Advance,
+  // so they reject a Node with asyncReady set.
+  bool asyncReady = false;
+
+  // parallelAppend lets the leader send its messages before its own entries are
+  // saved (raft thesis section 10.2.1), Ready.sendFirst tells when that is safe.
+  // The leader only counts its own entries towards the commit quorum once they
+  // are stable, i.e. after the Advance or AdvanceStable of their Ready, so
+  // commit still requires a durable quorum while the local fsync is taken off
+  // the critical path of the replication.
+  bool parallelAppend = false;
+
   // logger is the logger used for raft log. For multinode which can host
   // multiple raft group, each raft group can have its own logger.
   // when node end up, storage will be destroyed.
@@ -274,6 +406,20 @@ struct Config {
   Logger*           logger = NULL;            
 
   ReadOnlyOption    readOnlyOption;
+
+  // leaseDuration is how long, in microseconds of clock, a leader with
+  // ReadOnlyLeaseBased serves ReadIndex locally once a quorum of the voters
+  // acked its heartbeats, counted from the time the heartbeats were sent.
+  // With checkQuorum the followers do not vote for another candidate within
+  // electionTick ticks of hearing from the leader, so it MUST be shorter than
+  // electionTick ticks in time, and the lease is only held with checkQuorum.
+  // If it is 0, ReadIndex is always served as ReadOnlySafe.
+  uint64_t          leaseDuration = 0;
+
+  // maxClockDrift bounds how far the clock of the leader may fall behind the
+  // ones of the followers over a lease, it is taken off leaseDuration, so it
+  // MUST be less than leaseDuration if that is set.
+  uint64_t          maxClockDrift = 0;
 };
 
 struct Peer {
@@ -281,8 +427,28 @@ struct Peer {
   string   Context;
 };
 
+// ProposeDone is called once with the outcome of a proposal, keyed by the
+// (term, index) of its entry:
+//   OK                 the entry at index has been committed, and the Ready
+//                      holding it in CommittedEntries has been advanced;
+//   ErrProposalDropped the proposal was not appended to the log, or its entry
+//                      has been overwritten by an entry of another term;
+//   ErrTermChanged     the term changed before the entry committed, the entry
+//                      may still be committed;
+//   ErrStopped         the Node has been stopped first.
+typedef std::function<void (int err, uint64_t term, uint64_t index)> ProposeDone;
+
+// ReadDone is called once with the outcome of a read:
+//   OK                  the applied index has reached the read index index,
+//                       the read can be served from the local state machine;
+//   ErrReadIndexDropped there was no leader to serve the read index;
+//   ErrStopped          the Node has been stopped.
+typedef std::function<void (int err, uint64_t index)> ReadDone;
+
 class Node {
 public:
+  virtual ~Node() {}
+
 	// Tick increments the internal logical clock for the Node by a single tick. Election
 	// timeouts and heartbeat timeouts are in units of ticks.
   virtual void Tick(Ready **ready) = 0;
@@ -290,9 +456,30 @@ public:
   // Campaign causes the Node to transition to candidate state and start campaigning to become leader.
   virtual int Campaign(Ready **ready) = 0;
 
-  // Propose proposes that data be appended to the log.
+  // Propose proposes that data be appended to the log. It returns ErrProposalDropped
+  // if the proposal is dropped locally, a proposal forwarded to the leader may
+  // still be dropped there.
   virtual int Propose(const string& data, Ready **ready) = 0;
 
+  // Propose is like Propose above, but takes over the data buffer,
+  // on the leader the data is moved into the log without being copied.
+  virtual int Propose(string&& data, Ready **ready) = 0;
+
+  // ProposeBatch proposes that all the data be appended to the log in one step,
+  // the whole batch costs one append broadcast and one Ready instead of one per data.
+  virtual int ProposeBatch(const vector<string>& datas, Ready **ready) = 0;
+
+  // ProposeBatch is like ProposeBatch above, but takes over the data buffers
+  // instead of copying them, datas is left empty after the call.
+  virtual int ProposeBatch(vector<string>&& datas, Ready **ready) = 0;
+
+  // ProposeWithCallback proposes data like Propose, and calls done with the outcome
+  // of the proposal, see ProposeDone. done is called at once when the proposal is
+  // dropped, e.g. when the node is not the leader as such a proposal is not
+  // forwarded, otherwise in the Advance or the step that resolves it.
+  // Waiting for thousands of proposals costs O(log n) per proposal.
+  virtual int ProposeWithCallback(const string& data, const ProposeDone& done, Ready **ready) = 0;
+
 	// ProposeConfChange proposes config change.
 	// At most one ConfChange can be in the process of going through consensus.
 	// Application needs to call ApplyConfChange when applying EntryConfChange type entry.
@@ -312,6 +499,24 @@ public:
 	// progress, it can call Advance before finishing applying the last ready.
   virtual void Advance() = 0;
 
+  // AdvanceStable, AdvanceSent and AdvanceApplied acknowledge the stages of a
+  // Ready returned with Config.asyncReady set, each of them MUST be called once
+  // for every such Ready, even when the stage has nothing to do, and the Readys
+  // MUST be acknowledged in the order they are returned within each stage.
+  // The Ready is recycled once all its stages are acknowledged.
+  //
+  // AdvanceStable notifies the Node that the snapshot, entries and hard state
+  // of ready have been saved to stable storage.
+  virtual void AdvanceStable(Ready *ready) = 0;
+
+  // AdvanceSent notifies the Node that the messages of ready have been sent,
+  // which MUST happen after its entries are saved.
+  virtual void AdvanceSent(Ready *ready) = 0;
+
+  // AdvanceApplied notifies the Node that the snapshot and the committed
+  // entries of ready have been applied.
+  virtual void AdvanceApplied(Ready *ready) = 0;
+
 	// ApplyConfChange applies config change to the local node.
 	// Returns an opaque ConfState protobuf which must be recorded
 	// in snapshots. Will never return nil; it returns a pointer only
@@ -327,6 +532,18 @@ public:
 	// processed safely. The read state will have the same rctx attached.
   virtual int ReadIndex(const string &rctx, Ready **ready) = 0;
 
+  // ReadIndexWithCallback requests a read index like ReadIndex, and calls done once
+  // the applied index reaches it, see ReadDone, so that linearizable reads can be
+  // served by every member. The reads issued while a read index is being requested
+  // share the next request, a follower forwards one MsgReadIndex per batch.
+  // The read state is not returned in the Ready, and done is called in the step
+  // or the Advance that resolves the read.
+  virtual int ReadIndexWithCallback(const ReadDone& done, Ready **ready) = 0;
+
+  // WaitApplied calls done once the applied index reaches index, at once if it
+  // has, e.g. with the index of a ReadState, see ReadDone.
+  virtual void WaitApplied(uint64_t index, const ReadDone& done) = 0;
+
 	// Stop performs any necessary termination of the Node.
   virtual void Stop() = 0;
 };
@@ -334,6 +551,261 @@ public:
 extern Node* StartNode(Config *config, const vector<Peer>& peers);
 extern Node* RestartNode(Config *config);
 
+// GroupReady is the Ready of one raft group hosted in a MultiNode.
+struct GroupReady {
+  uint64_t groupId;
+  Ready    *ready;
+};
+typedef vector<GroupReady> GroupReadyVec;
+
+// GroupHeartbeat is the MsgHeartbeat or MsgHeartbeatResp of one group
+// carried in a HeartbeatBatch.
+struct GroupHeartbeat {
+  uint64_t groupId;
+  uint64_t term;
+  uint64_t commit;
+  string   context;
+
+  // the leader quiesces the group, see Config.quiesce
+  bool     quiesce;
+
+  // the time the heartbeat was sent at for the lease, echoed by the
+  // response, see Config.leaseDuration
+  uint64_t leaseSentAt;
+};
+
+// HeartbeatBatch coalesces the heartbeats (or heartbeat responses) of all the
+// groups sent from one node to another, so that they take one network message
+// per destination instead of one per group.
+struct HeartbeatBatch {
+  MessageType type;
+  uint64_t    from;
+  uint64_t    to;
+  vector<GroupHeartbeat> heartbeats;
+};
+typedef vector<HeartbeatBatch> HeartbeatBatchVec;
+
+// MultiNode hosts many raft groups in one process, keyed by group id.
+// All the groups are driven by one Tick, messages are routed by group id,
+// and the Ready of every group that has changed is returned in one batch,
+// so the cost of collecting Ready scales with the groups that changed,
+// not with the groups hosted.
+class MultiNode {
+public:
+  virtual ~MultiNode() {}
+
+  // CreateGroup starts the raft group with the given config, like StartNode.
+  // If peers is empty the group is restarted from config->storage, like RestartNode.
+  // The config's storage and logger are owned by the group from now on.
+  virtual int CreateGroup(uint64_t groupId, Config *config, const vector<Peer>& peers) = 0;
+
+  // RemoveGroup stops the raft group and releases it, the Ready of the group
+  // returned by Readies MUST NOT be used after it is removed.
+  virtual int RemoveGroup(uint64_t groupId) = 0;
+
+  // Tick increments the internal logical clock of all the groups by a single tick.
+  // Only the groups at their heartbeat or election deadline are visited, so a Tick
+  // costs O(expired groups) instead of O(groups). The quiescent groups are skipped,
+  // see Config.quiesce.
+  virtual void Tick() = 0;
+
+  // Wake wakes the quiescent group up, e.g. when the application finds the
+  // leader of the group is down.
+  virtual int Wake(uint64_t groupId) = 0;
+
+  virtual int Campaign(uint64_t groupId) = 0;
+  virtual int Propose(uint64_t groupId, const string& data) = 0;
+  virtual int ProposeConfChange(uint64_t groupId, const ConfChange& cc) = 0;
+
+  // Step advances the state machine of the group using the given message,
+  // the transport is responsible for carrying the group id along with the message.
+  virtual int Step(uint64_t groupId, const Message& msg) = 0;
+
+  virtual int ApplyConfChange(uint64_t groupId, const ConfChange& cc, ConfState *cs) = 0;
+  virtual int TransferLeadership(uint64_t groupId, uint64_t leader, uint64_t transferee) = 0;
+  virtual int ReadIndex(uint64_t groupId, const string &rctx) = 0;
+
+  // Readies returns the Ready of every group that has changed since the
+  // last call. Each group is returned at most once until it is advanced.
+  virtual void Readies(GroupReadyVec *readies) = 0;
+
+  // Advance notifies the groups that the application has saved progress up
+  // to the given Ready, see Node.Advance.
+  virtual void Advance(const GroupReadyVec& readies) = 0;
+
+  // Heartbeats returns the heartbeats and heartbeat responses of all the groups
+  // collected by Readies since the last call, coalesced into one batch per
+  // destination. They are taken out of the Ready messages, a group whose Ready
+  // carries nothing else is advanced at once and not returned by Readies.
+  virtual void Heartbeats(HeartbeatBatchVec *batches) = 0;
+
+  // StepHeartbeats splits a batch received from the transport into the
+  // heartbeat of each group and steps the groups with them. A batch of any
+  // type other than MsgHeartbeat and MsgHeartbeatResp is ignored.
+  virtual void StepHeartbeats(const HeartbeatBatch& batch) = 0;
+
+  // Stop performs any necessary termination of all the groups.
+  virtual void Stop() = 0;
+};
+
+extern MultiNode* NewMultiNode();
+
+// PeerAddress is the TCP address of a peer, host is an IPv4 address.
+struct PeerAddress {
+  uint64_t id;
+  string   host;
+  int      port;
+};
+
+// Applier is implemented by the application to apply the Ready of a Node
+// run by an EventDriver, it is called in the event loop thread.
+class Applier {
+public:
+  virtual ~Applier() {}
+
+  // Apply applies the committed entries and serves the read states of ready,
+  // the conf changes in the committed entries have been applied to the Node.
+  // ready has been saved to the storage and its messages have been sent.
+  virtual void Apply(const Ready& ready) = 0;
+};
+
+struct EventDriverConfig {
+  // the event loop, run by the application
+  event_base*         base = NULL;
+
+  // id of the local node
+  uint64_t            id = 0;
+
+  // the Node to run, owned by the driver after NewEventDriver,
+  // it MUST be returned by StartNode or RestartNode.
+  Node*               node = NULL;
+
+  // the storage of the Node, the Ready and the ConfState are saved to it
+  WritableStorage*    storage = NULL;
+
+  Applier*            applier = NULL;
+
+  // addresses of all the peers, the local one is listened on
+  vector<PeerAddress> peers;
+
+  // the interval in milliseconds between Node.Tick
+  int                 tickInterval = 100;
+
+  // the logger of the driver, if it is NULL, use `DefaultLogger' by default.
+  Logger*             logger = NULL;
+};
+
+// EventDriver runs a Node on a libevent loop: it ticks the Node from a timer,
+// saves the Ready to the storage, sends the messages to the peers over TCP and
+// steps the messages received into the Node. Each message is framed with its
+// length in 4 bytes in network order, the messages to one peer share a
+// persistent connection and the messages of one Ready are flushed together.
+// All the methods MUST be called in the event loop thread.
+class EventDriver {
+public:
+  virtual ~EventDriver() {}
+
+  // Start listens on the local address and starts ticking the Node.
+  virtual int Start() = 0;
+
+  virtual int Campaign() = 0;
+  virtual int Propose(const string& data) = 0;
+  virtual int ProposeConfChange(const ConfChange& cc) = 0;
+  virtual int ReadIndex(const string &rctx) = 0;
+
+  // Stop stops the Node and closes all the connections and timers,
+  // after which the event loop exits if it has nothing else to do.
+  virtual void Stop() = 0;
+};
+
+// NewEventDriver returns NULL if the Node has Config.asyncReady set, the Node
+// is then still owned by the caller.
+extern EventDriver* NewEventDriver(const EventDriverConfig& config);
+
+// ReadyHandler is implemented by the application to handle the Ready of
+// a ConcurrentNode, it is called in the raft thread.
+class ReadyHandler {
+public:
+  virtual ~ReadyHandler() {}
+
+  // HandleReady saves the state of ready to the storage, sends its messages
+  // and applies its committed entries. The conf changes in the committed
+  // entries are applied to the Node after it returns.
+  virtual void HandleReady(const Ready& ready) = 0;
+
+  // HandleConfState is called with the ConfState of the Node once each of
+  // these conf changes is applied, it is to be recorded in the snapshots.
+  virtual void HandleConfState(const ConfState& cs) {}
+};
+
+struct ConcurrentNodeConfig {
+  // the Node to run, owned by the ConcurrentNode after NewConcurrentNode,
+  // it MUST be returned by StartNode or RestartNode.
+  Node*         node = NULL;
+
+  ReadyHandler* handler = NULL;
+
+  // the interval in milliseconds between Node.Tick
+  int           tickInterval = 100;
+};
+
+// ConcurrentNode runs a Node on a dedicated raft thread, and its methods may be
+// called from any thread. The requests are pushed to lock-free multi-producer
+// queues which the raft thread drains in batches: the proposals of a batch are
+// appended to the log in one step, and the changes of the whole batch are
+// returned in one Ready. The methods return once the request is queued, the
+// outcome is observed in the Ready, e.g. in the committed entries or the
+// read states.
+class ConcurrentNode {
+public:
+  virtual ~ConcurrentNode() {}
+
+  virtual int Campaign() = 0;
+  virtual int Propose(const string& data) = 0;
+  virtual int Propose(string&& data) = 0;
+
+  // ProposeWithCallback queues a proposal like Node.ProposeWithCallback,
+  // done is called in the raft thread.
+  virtual int ProposeWithCallback(string&& data, const ProposeDone& done) = 0;
+
+  virtual int ProposeConfChange(const ConfChange& cc) = 0;
+  virtual int Step(const Message& msg) = 0;
+  virtual int ReadIndex(const string &rctx) = 0;
+
+  // ReadIndexWithCallback queues a read like Node.ReadIndexWithCallback, the reads
+  // drained in one batch share one read index request, done is called in the raft thread.
+  virtual int ReadIndexWithCallback(const ReadDone& done) = 0;
+
+  // Stop stops the raft thread and waits for it to exit, the requests still
+  // queued are dropped and their callbacks called with ErrStopped.
+  virtual void Stop() = 0;
+};
+
+// NewConcurrentNode returns NULL if the Node has Config.asyncReady set, the
+// Node is then still owned by the caller.
+extern ConcurrentNode* NewConcurrentNode(const ConcurrentNodeConfig& config);
+
+// EncodedMessage is the wire encoding of a Message, split into the per-message
+// header and the encoded entries, which may be shared with other messages.
+// The encoding of the whole message is header followed by *entries (if any),
+// it can be decoded with Message::ParseFromString as usual.
+struct EncodedMessage {
+  string header;
+  std::shared_ptr<const string> entries;
+};
+
+// EncodeMessages encodes msgs for the transport, out[i] is the encoding of msgs[i].
+// The MsgApps a leader broadcasts to its followers carry the same entries, so
+// they share a single encoding of those entries and only the header fields
+// (to, index, logTerm, commit...) are encoded for each follower.
+// msgs MUST come from one raft group, e.g. the messages of one Ready.
+extern void EncodeMessages(const MessageVec& msgs, vector<EncodedMessage>* out);
+
+// EncodeHeartbeatBatch encodes batch for the transport, which is decoded
+// by DecodeHeartbeatBatch on the receiver, it returns false if data is malformed.
+extern void EncodeHeartbeatBatch(const HeartbeatBatch& batch, string *out);
+extern bool DecodeHeartbeatBatch(const string& data, HeartbeatBatch *batch);
+
 // empty (hard,soft) state constants
 static const HardState kEmptyHardState;
 static const SoftState kEmptySoftState;
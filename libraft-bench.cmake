@@ -0,0 +1,18 @@
+add_executable ( libraft_bench
+  bench/commit_bench.cc
+  bench/concurrent_bench.cc
+  bench/encoding_bench.cc
+  bench/main.cc
+  bench/read_index_bench.cc
+  bench/tick_bench.cc
+)
+
+target_link_libraries (libraft_bench PRIVATE raft event pthread protobuf)
+
+# the allocation counting replaces the global operator new, so it runs in a
+# binary of its own to leave the other benchmarks untouched
+add_executable ( libraft_alloc_bench
+  bench/alloc_bench.cc
+)
+
+target_link_libraries (libraft_alloc_bench PRIVATE raft event pthread protobuf)
@@ -1,16 +1,21 @@
 
 add_executable ( libraft_test  
+  test/concurrent_node_test.cc
+  test/encoding_test.cc
+  test/event_driver_test.cc
   test/log_test.cc
   test/main.cc
   test/memory_storage_test.cc
+  test/multi_node_test.cc
   test/node_test.cc
   test/progress_test.cc
   test/raft_flow_controller_test.cc
-  #test/raft_paper_test.cc
+  test/raft_paper_test.cc
   test/raft_snap_test.cc
   test/raft_test_util.cc
   test/raft_test.cc 
+  test/timing_wheel_test.cc
   test/unstable_log_test.cc      
 )
 
-target_link_libraries (libraft_test PRIVATE raft gtest pthread protobuf gflags)
\ No newline at end of file
+target_link_libraries (libraft_test PRIVATE raft event gtest pthread protobuf gflags)
\ No newline at end of file
@@ -1,14 +1,24 @@
 set(libraft_files
   src/proto/raft.pb.cc 
 
+  src/base/default_clock.cc
   src/base/default_logger.cc 
   src/base/mutex.cc
+  src/base/timing_wheel.cc
   src/base/util.cc 
 
+  src/core/concurrent_node.cc
+  src/core/encoding.cc 
+  src/core/multi_node.cc 
   src/core/node.cc 
   src/core/progress.cc 
+  src/core/proposal_waits.cc
   src/core/raft.cc 
   src/core/read_only.cc 
+  src/core/read_waits.cc
+
+  src/net/event_driver.cc
+  src/net/transport.cc
 
   src/storage/log.cc    
   src/storage/memory_storage.cc      
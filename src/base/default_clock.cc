@@ -0,0 +1,18 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <chrono>
+#include "base/default_clock.h"
+
+namespace libraft {
+
+uint64_t
+DefaultClock::Now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+DefaultClock kDefaultClock;
+
+}; // namespace libraft
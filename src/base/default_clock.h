@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_DEFAULT_CLOCK_H__
+#define __LIBRAFT_DEFAULT_CLOCK_H__
+
+#include "libraft.h"
+
+namespace libraft {
+
+// DefaultClock is the steady clock of the system
+class DefaultClock : public Clock {
+public:
+  virtual ~DefaultClock() {}
+
+  uint64_t Now();
+};
+
+extern DefaultClock kDefaultClock;
+}; // namespace libraft
+
+#endif // __LIBRAFT_DEFAULT_CLOCK_H__
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_MPSC_QUEUE_H__
+#define __LIBRAFT_MPSC_QUEUE_H__
+
+#include <stddef.h>
+#include <atomic>
+#include <utility>
+
+namespace libraft {
+
+// mpscQueue is an unbounded lock-free multi-producer single-consumer queue
+// (Dmitry Vyukov's). push may be called from any thread, pop only from the
+// consumer thread. A push takes one atomic exchange, producers never wait on
+// each other nor on the consumer.
+template <typename T>
+class mpscQueue {
+public:
+  mpscQueue() {
+    node *stub = new node();
+    head_.store(stub, std::memory_order_relaxed);
+    tail_ = stub;
+  }
+
+  ~mpscQueue() {
+    T value;
+    while (pop(&value)) {
+    }
+    delete tail_;
+  }
+
+  void push(T&& value) {
+    node *n = new node(std::move(value));
+    node *prev = head_.exchange(n, std::memory_order_acq_rel);
+    // the consumer does not see n until prev is linked to it
+    prev->next_.store(n, std::memory_order_release);
+  }
+
+  // pop returns false if the queue is empty, or the last pushed
+  // value is not linked yet, which is seen by the next pop.
+  bool pop(T *value) {
+    node *tail = tail_;
+    node *next = tail->next_.load(std::memory_order_acquire);
+    if (next == NULL) {
+      return false;
+    }
+    *value = std::move(next->value_);
+    // next becomes the stub
+    tail_ = next;
+    delete tail;
+    return true;
+  }
+
+private:
+  struct node {
+    std::atomic<node*> next_;
+    T value_;
+
+    node() : next_(NULL) {}
+    node(T&& value) : next_(NULL), value_(std::move(value)) {}
+  };
+
+  // the last pushed node, producers push here
+  std::atomic<node*> head_;
+
+  // the stub before the first node to pop, owned by the consumer
+  node *tail_;
+
+  mpscQueue(const mpscQueue&);
+  mpscQueue& operator=(const mpscQueue&);
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_MPSC_QUEUE_H__
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include "base/timing_wheel.h"
+
+namespace libraft {
+
+static const int kWheelBits = 6;
+static const int kWheelLevels = 4;
+static const uint64_t kWheelSlots = 1 << kWheelBits;
+static const uint64_t kWheelMask = kWheelSlots - 1;
+
+// the farthest deadline the wheel holds, the timers due after it
+// are held at it and placed again when cascaded.
+static const uint64_t kMaxDelta = (1ULL << (kWheelBits * kWheelLevels)) - 1;
+
+static void
+linkTimer(timer *head, timer *t) {
+  t->prev_ = head->prev_;
+  t->next_ = head;
+  head->prev_->next_ = t;
+  head->prev_ = t;
+}
+
+static void
+unlinkTimer(timer *t) {
+  t->prev_->next_ = t->next_;
+  t->next_->prev_ = t->prev_;
+  t->prev_ = t->next_ = NULL;
+}
+
+timingWheel::timingWheel()
+  : current_(1),
+    size_(0) {
+  slots_.resize(kWheelLevels * kWheelSlots, timer(NULL));
+  size_t i;
+  for (i = 0; i < slots_.size(); ++i) {
+    slots_[i].prev_ = slots_[i].next_ = &slots_[i];
+  }
+}
+
+timingWheel::~timingWheel() {
+  // the timers are owned by the caller, only detach them
+  size_t i;
+  for (i = 0; i < slots_.size(); ++i) {
+    timer *head = &slots_[i];
+    while (head->next_ != head) {
+      unlinkTimer(head->next_);
+    }
+  }
+}
+
+void
+timingWheel::schedule(timer *t, uint64_t deadline) {
+  if (t->scheduled()) {
+    if (t->deadline_ == deadline) {
+      return;
+    }
+    unlinkTimer(t);
+    --size_;
+  }
+  t->deadline_ = deadline;
+  add(t);
+  ++size_;
+}
+
+void
+timingWheel::cancel(timer *t) {
+  if (!t->scheduled()) {
+    return;
+  }
+  unlinkTimer(t);
+  --size_;
+}
+
+// add places t in the lowest level covering its deadline
+void
+timingWheel::add(timer *t) {
+  uint64_t expires = t->deadline_ < current_ ? current_ : t->deadline_;
+  uint64_t delta = expires - current_;
+  if (delta > kMaxDelta) {
+    delta = kMaxDelta;
+    expires = current_ + delta;
+  }
+
+  int level = 0;
+  while (delta >= (kWheelSlots << (kWheelBits * level))) {
+    ++level;
+  }
+  uint64_t slot = (expires >> (kWheelBits * level)) & kWheelMask;
+  linkTimer(&slots_[level * kWheelSlots + slot], t);
+}
+
+// cascade moves the timers of the current slot of level down to the
+// lower levels, and returns the index of the slot.
+uint64_t
+timingWheel::cascade(int level) {
+  uint64_t slot = (current_ >> (kWheelBits * level)) & kWheelMask;
+  timer *head = &slots_[level * kWheelSlots + slot];
+  while (head->next_ != head) {
+    timer *t = head->next_;
+    unlinkTimer(t);
+    add(t);
+  }
+  return slot;
+}
+
+void
+timingWheel::advance(vector<timer*> *expired) {
+  uint64_t slot = current_ & kWheelMask;
+  if (slot == 0) {
+    int level;
+    for (level = 1; level < kWheelLevels; ++level) {
+      if (cascade(level) != 0) {
+        break;
+      }
+    }
+  }
+
+  timer *head = &slots_[slot];
+  while (head->next_ != head) {
+    timer *t = head->next_;
+    unlinkTimer(t);
+    --size_;
+    expired->push_back(t);
+  }
+  ++current_;
+}
+
+}; // namespace libraft
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_TIMING_WHEEL_H__
+#define __LIBRAFT_TIMING_WHEEL_H__
+
+#include "libraft.h"
+
+namespace libraft {
+
+// timer is an intrusive timer of timingWheel, embedded in the object
+// to be fired, so scheduling and cancelling allocate nothing.
+struct timer {
+  timer *prev_;
+  timer *next_;
+
+  // the tick at which the timer fires
+  uint64_t deadline_;
+
+  // the object owning the timer
+  void *data_;
+
+  timer(void *data)
+    : prev_(NULL),
+      next_(NULL),
+      deadline_(0),
+      data_(data) {}
+
+  bool scheduled() const {
+    return prev_ != NULL;
+  }
+};
+
+// timingWheel is a hierarchical timing wheel, as the timer wheel of
+// the linux kernel: kWheelLevels levels of kWheelSlots slots, level N
+// holds the timers due within kWheelSlots^(N+1) ticks. Timers in the
+// higher levels are cascaded down when the lower level wraps around.
+// Scheduling and cancelling are O(1), and advancing the wheel by one tick
+// is O(expired timers) plus the amortized cascading.
+class timingWheel {
+public:
+  timingWheel();
+  ~timingWheel();
+
+  // now returns the last tick the wheel has advanced to
+  uint64_t now() const {
+    return current_ - 1;
+  }
+
+  // size returns the number of scheduled timers
+  size_t size() const {
+    return size_;
+  }
+
+  // schedule schedules t to fire at tick deadline, a deadline not after
+  // now fires at the next tick. A scheduled t is rescheduled.
+  void schedule(timer *t, uint64_t deadline);
+
+  // cancel cancels t if it is scheduled
+  void cancel(timer *t);
+
+  // advance advances the wheel by one tick and appends the timers due
+  // at the tick to expired, the expired timers are no longer scheduled.
+  void advance(vector<timer*> *expired);
+
+private:
+  void add(timer *t);
+  uint64_t cascade(int level);
+
+  // the next tick to advance to
+  uint64_t current_;
+
+  size_t size_;
+
+  // the slots are the heads of circular lists of timers,
+  // level N is slots_[N * kWheelSlots, (N + 1) * kWheelSlots)
+  vector<timer> slots_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_TIMING_WHEEL_H__
@@ -59,6 +59,20 @@ isDeepEqualEntries(const EntryVec& ents1, const EntryVec& ents2) {
   return true;
 }
 
+bool 
+isDeepEqualEntries(const SharedEntryVec& ents1, const EntryVec& ents2) {
+  if (ents1.size() != ents2.size()) {
+    return false;
+  }
+  size_t i;
+  for (i = 0; i < ents1.size(); ++i) {
+    if (!isDeepEqualEntry(*ents1[i], ents2[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool isDeepEqualNodes(const vector<uint64_t>& ns1, const vector<uint64_t>& ns2) {
   if (ns1.size() != ns2.size()) {
     return false;
@@ -91,6 +105,25 @@ limitSize(uint64_t maxSize, EntryVec *entries) {
   entries->erase(entries->begin() + limit, entries->end());
 }
 
+void 
+limitSize(uint64_t maxSize, SharedEntryVec *entries) {
+  if (entries->empty()) {
+    return;
+  }
+
+  int limit;
+  int num = entries->size();
+  uint64_t size = (*entries)[0]->ByteSizeLong();
+  for (limit = 1; limit < num; ++limit) {
+    size += (*entries)[limit]->ByteSizeLong();
+    if (size > maxSize) {
+      break;
+    }
+  }
+
+  entries->erase(entries->begin() + limit, entries->end());
+}
+
 bool 
 isLoaclMessage(const MessageType type) {
   return (type == MsgHup          ||
@@ -109,6 +142,16 @@ isResponseMessage(const MessageType type) {
           type == MsgPreVoteResp);
 }
 
+bool
+isHeartbeatMessage(const MessageType type) {
+  return (type == MsgHeartbeat || type == MsgHeartbeatResp);
+}
+
+bool
+isQuiesceHeartbeat(const Message& msg) {
+  return msg.type() == MsgHeartbeat && msg.quiesce();
+}
+
 bool 
 isHardStateEqual(const HardState& h1, const HardState& h2) {
   return h1.term() == h2.term() &&
@@ -191,6 +234,38 @@ numOfPendingConf(const EntryVec& entries) {
   return n;
 }
 
+void 
+shareEntries(EntryVec *entries, SharedEntryVec *shared) {
+  shared->reserve(shared->size() + entries->size());
+  size_t i;
+  for (i = 0; i < entries->size(); ++i) {
+    shared->push_back(SharedEntry(std::make_shared<Entry>(std::move((*entries)[i]))));
+  }
+  entries->clear();
+}
+
+void 
+copySharedEntries(const SharedEntryVec& shared, EntryVec *entries) {
+  entries->reserve(entries->size() + shared.size());
+  size_t i;
+  for (i = 0; i < shared.size(); ++i) {
+    entries->push_back(*shared[i]);
+  }
+}
+
+int 
+numOfPendingConf(const SharedEntryVec& entries) {
+  size_t i;
+  int n = 0;
+  for (i = 0; i < entries.size(); ++i) {
+    if (entries[i]->type() == EntryConfChange) {
+      ++n;
+    }
+  }
+
+  return n;
+}
+
 MessageType 
 voteRespMsgType(int t) {
   if (t == MsgVote) {
@@ -10,21 +10,37 @@
 namespace libraft {
 
 void limitSize(uint64_t maxSize, EntryVec *entries);
+void limitSize(uint64_t maxSize, SharedEntryVec *entries);
 
 bool isDeepEqualNodes(const vector<uint64_t>& ns1, const vector<uint64_t>& ns2);
 bool isDeepEqualSnapshot(const Snapshot *s1, const Snapshot *s2);
 bool isDeepEqualEntries(const EntryVec& ents1, const EntryVec& ents2);
+bool isDeepEqualEntries(const SharedEntryVec& ents1, const EntryVec& ents2);
 bool isDeepEqualReadStates(const vector<ReadState*>& rs1, const vector<ReadState*>& rs2);
 bool isDeepEqualMessage(const Message& msg1, const Message& msg2);
 bool isHardStateEqual(const HardState& h1, const HardState& h2);
 bool isSoftStateEqual(const SoftState& s1, const SoftState& s2);
 bool isEmptySnapshot(const Snapshot* snapshot);
 int numOfPendingConf(const EntryVec& entries);
+int numOfPendingConf(const SharedEntryVec& entries);
+
+// shareEntries moves entries into new shared entries appended to shared,
+// entries is left empty after the call.
+void shareEntries(EntryVec *entries, SharedEntryVec *shared);
+
+// copySharedEntries appends the copies of shared entries to entries.
+void copySharedEntries(const SharedEntryVec& shared, EntryVec *entries);
 MessageType voteRespMsgType(int t);
 
 bool isLoaclMessage(const MessageType type);
 bool isResponseMessage(const MessageType type);
 
+// isHeartbeatMessage returns true for the types carried by a HeartbeatBatch
+bool isHeartbeatMessage(const MessageType type);
+
+// isQuiesceHeartbeat returns true if msg is the heartbeat of a quiescing leader
+bool isQuiesceHeartbeat(const Message& msg);
+
 string entryStr(const Entry& entry);
 string entryVecDebugString(const EntryVec& entries);
 
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include "core/concurrent_node.h"
+#include "core/node.h"
+
+namespace libraft {
+
+// the most requests of each kind drained in one batch, so that
+// the producers cannot hold the raft thread in the drain loop.
+static const size_t kMaxBatch = 4096;
+
+ConcurrentNodeImpl::ConcurrentNodeImpl(const ConcurrentNodeConfig& config)
+  : node_(static_cast<NodeImpl*>(config.node)),
+    handler_(config.handler),
+    tickInterval_(config.tickInterval),
+    batchDone_(false),
+    readies_(0),
+    stopped_(false),
+    pushing_(0),
+    signaled_(false) {
+  batch_.reserve(kMaxBatch);
+  dones_.reserve(kMaxBatch);
+  thread_ = std::thread(&ConcurrentNodeImpl::run, this);
+}
+
+ConcurrentNodeImpl::~ConcurrentNodeImpl() {
+  Stop();
+  delete node_;
+}
+
+int
+ConcurrentNodeImpl::Campaign() {
+  nodeRequest req;
+  req.type_ = CampaignRequest;
+  return push(std::move(req));
+}
+
+int
+ConcurrentNodeImpl::Propose(const string& data) {
+  return Propose(string(data));
+}
+
+int
+ConcurrentNodeImpl::Propose(string&& data) {
+  return ProposeWithCallback(std::move(data), ProposeDone());
+}
+
+int
+ConcurrentNodeImpl::ProposeWithCallback(string&& data, const ProposeDone& done) {
+  pushing_.fetch_add(1);
+  if (stopped_.load()) {
+    pushing_.fetch_sub(1);
+    return ErrStopped;
+  }
+  proposal prop;
+  prop.data_ = std::move(data);
+  prop.done_ = done;
+  proposals_.push(std::move(prop));
+  signal();
+  pushing_.fetch_sub(1);
+  return OK;
+}
+
+int
+ConcurrentNodeImpl::ProposeConfChange(const ConfChange& cc) {
+  nodeRequest req;
+  req.type_ = ConfChangeRequest;
+  if (!cc.SerializeToString(&req.data_)) {
+    return ErrSerializeFail;
+  }
+  return push(std::move(req));
+}
+
+int
+ConcurrentNodeImpl::Step(const Message& msg) {
+  nodeRequest req;
+  req.type_ = StepRequest;
+  req.msg_ = msg;
+  return push(std::move(req));
+}
+
+int
+ConcurrentNodeImpl::ReadIndex(const string &rctx) {
+  nodeRequest req;
+  req.type_ = ReadIndexRequest;
+  req.data_ = rctx;
+  return push(std::move(req));
+}
+
+int
+ConcurrentNodeImpl::ReadIndexWithCallback(const ReadDone& done) {
+  nodeRequest req;
+  req.type_ = ReadWaitRequest;
+  req.readDone_ = done;
+  return push(std::move(req));
+}
+
+int
+ConcurrentNodeImpl::push(nodeRequest&& req) {
+  pushing_.fetch_add(1);
+  if (stopped_.load()) {
+    pushing_.fetch_sub(1);
+    return ErrStopped;
+  }
+  requests_.push(std::move(req));
+  signal();
+  pushing_.fetch_sub(1);
+  return OK;
+}
+
+void
+ConcurrentNodeImpl::signal() {
+  if (signaled_.exchange(true)) {
+    return;
+  }
+  // the raft thread checks signaled_ under the mutex before
+  // waiting, so the wakeup cannot be lost.
+  std::lock_guard<std::mutex> lock(mutex_);
+  cond_.notify_one();
+}
+
+void
+ConcurrentNodeImpl::Stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cond_.notify_one();
+  }
+  thread_.join();
+  // a producer which has seen stopped_ unset may still be pushing
+  while (pushing_.load() != 0) {
+    std::this_thread::yield();
+  }
+  abortQueued();
+  node_->Stop();
+}
+
+void
+ConcurrentNodeImpl::abortQueued() {
+  proposal prop;
+  while (proposals_.pop(&prop)) {
+    if (prop.done_) {
+      prop.done_(ErrStopped, 0, 0);
+    }
+  }
+  nodeRequest req;
+  while (requests_.pop(&req)) {
+    if (req.type_ == ReadWaitRequest) {
+      req.readDone_(ErrStopped, 0);
+    }
+  }
+}
+
+void
+ConcurrentNodeImpl::run() {
+  std::chrono::steady_clock::time_point nextTick =
+    std::chrono::steady_clock::now() + tickInterval_;
+
+  // the initial conf change entries of StartNode are to be saved and applied
+  handleReady();
+
+  while (!stopped_.load()) {
+    // the requests pushed from now on signal again
+    signaled_.store(false);
+
+    // the steps of the batch are returned in one Ready
+    node_->deferReady_ = true;
+    drain();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now >= nextTick) {
+      // one tick even after a stall, replaying the missed ticks at once
+      // could push the followers past their election timeout.
+      Ready *ready;
+      node_->Tick(&ready);
+      nextTick = now + tickInterval_;
+    }
+    node_->deferReady_ = false;
+    handleReady();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!signaled_.load() && !stopped_.load()) {
+      if (cond_.wait_until(lock, nextTick) == std::cv_status::timeout) {
+        break;
+      }
+    }
+  }
+}
+
+void
+ConcurrentNodeImpl::drain() {
+  size_t i;
+  bool more = false;
+  nodeRequest req;
+  // the messages first, the proposals of the batch may be
+  // forwarded to a leader they have just elected
+  for (i = 0; requests_.pop(&req); ++i) {
+    handleRequest(&req);
+    if (i + 1 == kMaxBatch) {
+      more = true;
+      break;
+    }
+  }
+
+  proposal prop;
+  for (i = 0; proposals_.pop(&prop); ++i) {
+    batch_.push_back(std::move(prop.data_));
+    if (prop.done_) {
+      batchDone_ = true;
+    }
+    dones_.push_back(std::move(prop.done_));
+    if (i + 1 == kMaxBatch) {
+      more = true;
+      break;
+    }
+  }
+  if (!batch_.empty()) {
+    Ready *ready;
+    if (batchDone_) {
+      node_->ProposeBatchWithCallbacks(std::move(batch_), dones_, &ready);
+    } else {
+      node_->ProposeBatch(std::move(batch_), &ready);
+    }
+    batch_.clear();
+    dones_.clear();
+    batchDone_ = false;
+  }
+
+  if (more) {
+    // the rest is drained in the next batch
+    signaled_.store(true);
+  }
+}
+
+void
+ConcurrentNodeImpl::handleRequest(nodeRequest *req) {
+  Ready *ready;
+  switch (req->type_) {
+  case CampaignRequest:
+    node_->Campaign(&ready);
+    break;
+  case ConfChangeRequest: {
+    ConfChange cc;
+    cc.ParseFromString(req->data_);
+    node_->ProposeConfChange(cc, &ready);
+    break;
+  }
+  case StepRequest:
+    node_->Step(req->msg_, &ready);
+    break;
+  case ReadIndexRequest:
+    node_->ReadIndex(req->data_, &ready);
+    break;
+  case ReadWaitRequest:
+    node_->ReadIndexWithCallback(req->readDone_, &ready);
+    break;
+  }
+}
+
+void
+ConcurrentNodeImpl::handleReady() {
+  Ready *ready;
+  node_->PollReady(&ready);
+  while (ready != NULL) {
+    ++readies_;
+    handler_->HandleReady(*ready);
+
+    size_t i;
+    for (i = 0; i < ready->committedEntries.size(); ++i) {
+      const Entry& entry = *ready->committedEntries[i];
+      if (entry.type() != EntryConfChange) {
+        continue;
+      }
+      ConfChange cc;
+      if (!cc.ParseFromString(entry.data())) {
+        node_->logger_->Fatalf(__FILE__, __LINE__, "parse conf change at index %llu fail",
+          entry.index());
+      }
+      ConfState cs;
+      Ready *unused;
+      node_->ApplyConfChange(cc, &cs, &unused);
+      handler_->HandleConfState(cs);
+    }
+
+    node_->Advance();
+    // return what the node has done since the Ready
+    node_->PollReady(&ready);
+  }
+}
+
+ConcurrentNode*
+NewConcurrentNode(const ConcurrentNodeConfig& config) {
+  // the raft thread advances the Readies with Advance
+  if (static_cast<NodeImpl*>(config.node)->asyncReady_) {
+    return NULL;
+  }
+  return new ConcurrentNodeImpl(config);
+}
+
+}; // namespace libraft
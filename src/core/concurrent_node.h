@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_CONCURRENT_NODE_H__
+#define __LIBRAFT_CONCURRENT_NODE_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "libraft.h"
+#include "base/mpsc_queue.h"
+
+namespace libraft {
+
+class NodeImpl;
+
+enum nodeRequestType {
+  CampaignRequest     = 0,
+  ConfChangeRequest   = 1,
+  StepRequest         = 2,
+  ReadIndexRequest    = 3,
+  ReadWaitRequest     = 4,
+};
+
+// proposal is a proposal queued to the raft thread
+struct proposal {
+  string data_;
+
+  // the callback of ProposeWithCallback, empty for Propose
+  ProposeDone done_;
+};
+
+// nodeRequest is a request other than a proposal queued to the raft thread
+struct nodeRequest {
+  nodeRequestType type_;
+
+  // the message to step for StepRequest
+  Message msg_;
+
+  // the conf change for ConfChangeRequest, the context for ReadIndexRequest
+  string data_;
+
+  // the callback for ReadWaitRequest
+  ReadDone readDone_;
+};
+
+class ConcurrentNodeImpl : public ConcurrentNode {
+public:
+  ConcurrentNodeImpl(const ConcurrentNodeConfig& config);
+  virtual ~ConcurrentNodeImpl();
+
+  virtual int  Campaign();
+  virtual int  Propose(const string& data);
+  virtual int  Propose(string&& data);
+  virtual int  ProposeWithCallback(string&& data, const ProposeDone& done);
+  virtual int  ProposeConfChange(const ConfChange& cc);
+  virtual int  Step(const Message& msg);
+  virtual int  ReadIndex(const string &rctx);
+  virtual int  ReadIndexWithCallback(const ReadDone& done);
+  virtual void Stop();
+
+private:
+  int  push(nodeRequest&& req);
+
+  // abortQueued fails the callbacks of the requests left in the queues
+  // once the raft thread has exited.
+  void abortQueued();
+
+  // wake the raft thread up if it is waiting
+  void signal();
+
+  // run is the loop of the raft thread
+  void run();
+
+  // drain the queued requests into the node, at most kMaxBatch of each kind
+  void drain();
+  void handleRequest(nodeRequest *req);
+  void handleReady();
+
+public:
+  NodeImpl *node_;
+  ReadyHandler *handler_;
+  std::chrono::milliseconds tickInterval_;
+
+  mpscQueue<proposal> proposals_;
+  mpscQueue<nodeRequest> requests_;
+
+  // the proposals drained in one batch, and their callbacks
+  vector<string> batch_;
+  vector<ProposeDone> dones_;
+
+  // true if some proposal in batch_ has a callback
+  bool batchDone_;
+
+  // the number of Readies handled, for the tests
+  uint64_t readies_;
+
+  std::atomic<bool> stopped_;
+
+  // pushing_ counts the producers between their check of stopped_ and the
+  // end of their push, Stop waits for them before draining the queues.
+  std::atomic<int> pushing_;
+
+  // signaled_ is set by the producers when they have pushed something, the
+  // mutex is only taken to wake up the raft thread when it is not yet set.
+  std::atomic<bool> signaled_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+
+  std::thread thread_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_CONCURRENT_NODE_H__
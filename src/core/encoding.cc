@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <map>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include "libraft.h"
+#include "base/util.h"
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::StringOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+namespace libraft {
+
+// MsgApps from the same leader at the same term with the same [index, index + n]
+// range carry the same entries(Log Matching Property), so they can share one encoding.
+struct segmentKey {
+  uint64_t term;
+  uint64_t index;
+  uint64_t logTerm;
+  int      size;
+
+  bool operator < (const segmentKey& k) const {
+    if (term != k.term) {
+      return term < k.term;
+    }
+    if (index != k.index) {
+      return index < k.index;
+    }
+    if (logTerm != k.logTerm) {
+      return logTerm < k.logTerm;
+    }
+    return size < k.size;
+  }
+};
+
+// encodeEntries returns the wire encoding of the entries field of msg,
+// sized up front so that the entries are serialized straight into the buffer.
+static string*
+encodeEntries(const Message& msg) {
+  uint32_t tag = WireFormatLite::MakeTag(Message::kEntriesFieldNumber,
+                                         WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  size_t total = 0;
+  int i;
+  for (i = 0; i < msg.entries_size(); ++i) {
+    size_t size = msg.entries(i).ByteSizeLong();
+    total += CodedOutputStream::VarintSize32(tag)
+           + CodedOutputStream::VarintSize32((uint32_t)size) + size;
+  }
+
+  string *out = new string();
+  out->resize(total);
+  uint8_t *target = reinterpret_cast<uint8_t*>(&(*out)[0]);
+  for (i = 0; i < msg.entries_size(); ++i) {
+    const Entry& entry = msg.entries(i);
+    target = CodedOutputStream::WriteTagToArray(tag, target);
+    target = CodedOutputStream::WriteVarint32ToArray((uint32_t)entry.GetCachedSize(), target);
+    target = entry.SerializeWithCachedSizesToArray(target);
+  }
+  return out;
+}
+
+// encodeHeader encodes all the fields of msg but the entries.
+static void
+encodeHeader(const Message& msg, string* out) {
+  Message header;
+  if (msg.has_type()) {
+    header.set_type(msg.type());
+  }
+  if (msg.has_to()) {
+    header.set_to(msg.to());
+  }
+  if (msg.has_from()) {
+    header.set_from(msg.from());
+  }
+  if (msg.has_term()) {
+    header.set_term(msg.term());
+  }
+  if (msg.has_logterm()) {
+    header.set_logterm(msg.logterm());
+  }
+  if (msg.has_index()) {
+    header.set_index(msg.index());
+  }
+  if (msg.has_commit()) {
+    header.set_commit(msg.commit());
+  }
+  if (msg.has_reject()) {
+    header.set_reject(msg.reject());
+  }
+  if (msg.has_rejecthint()) {
+    header.set_rejecthint(msg.rejecthint());
+  }
+  if (msg.has_context()) {
+    header.set_context(msg.context());
+  }
+  if (msg.has_quiesce()) {
+    header.set_quiesce(msg.quiesce());
+  }
+  if (msg.has_leasesentat()) {
+    header.set_leasesentat(msg.leasesentat());
+  }
+  header.SerializeToString(out);
+}
+
+void
+EncodeMessages(const MessageVec& msgs, vector<EncodedMessage>* out) {
+  map<segmentKey, std::shared_ptr<const string> > segments;
+  size_t i;
+
+  out->clear();
+  out->resize(msgs.size());
+  for (i = 0; i < msgs.size(); ++i) {
+    const Message& msg = *msgs[i];
+    EncodedMessage& encoded = (*out)[i];
+
+    if (msg.type() != MsgApp || msg.entries_size() == 0) {
+      msg.SerializeToString(&encoded.header);
+      continue;
+    }
+
+    encodeHeader(msg, &encoded.header);
+    segmentKey key = {msg.term(), msg.index(), msg.logterm(), msg.entries_size()};
+    map<segmentKey, std::shared_ptr<const string> >::iterator iter = segments.find(key);
+    if (iter != segments.end()) {
+      encoded.entries = iter->second;
+      continue;
+    }
+    encoded.entries.reset(encodeEntries(msg));
+    segments[key] = encoded.entries;
+  }
+}
+
+// the heartbeat batch is encoded as varints:
+//   type from to count (groupId term commit quiesce len(context) context)*count
+void
+EncodeHeartbeatBatch(const HeartbeatBatch& batch, string *out) {
+  out->clear();
+  StringOutputStream stream(out);
+  CodedOutputStream coded(&stream);
+  coded.WriteVarint32(batch.type);
+  coded.WriteVarint64(batch.from);
+  coded.WriteVarint64(batch.to);
+  coded.WriteVarint32((uint32_t)batch.heartbeats.size());
+  size_t i;
+  for (i = 0; i < batch.heartbeats.size(); ++i) {
+    const GroupHeartbeat& hb = batch.heartbeats[i];
+    coded.WriteVarint64(hb.groupId);
+    coded.WriteVarint64(hb.term);
+    coded.WriteVarint64(hb.commit);
+    coded.WriteVarint64(hb.leaseSentAt);
+    coded.WriteVarint32(hb.quiesce ? 1 : 0);
+    coded.WriteVarint32((uint32_t)hb.context.size());
+    coded.WriteString(hb.context);
+  }
+}
+
+bool
+DecodeHeartbeatBatch(const string& data, HeartbeatBatch *batch) {
+  CodedInputStream coded(reinterpret_cast<const uint8_t*>(data.data()), (int)data.size());
+  uint32_t type, count, quiesce, size;
+  // a batch only carries heartbeats, any other type is corrupt
+  if (!coded.ReadVarint32(&type) || !MessageType_IsValid(type) ||
+      !isHeartbeatMessage((MessageType)type) ||
+      !coded.ReadVarint64(&batch->from) ||
+      !coded.ReadVarint64(&batch->to) ||
+      !coded.ReadVarint32(&count)) {
+    return false;
+  }
+  batch->type = (MessageType)type;
+  batch->heartbeats.clear();
+  uint32_t i;
+  for (i = 0; i < count; ++i) {
+    GroupHeartbeat hb;
+    if (!coded.ReadVarint64(&hb.groupId) ||
+        !coded.ReadVarint64(&hb.term) ||
+        !coded.ReadVarint64(&hb.commit) ||
+        !coded.ReadVarint64(&hb.leaseSentAt) ||
+        !coded.ReadVarint32(&quiesce) ||
+        !coded.ReadVarint32(&size) ||
+        !coded.ReadString(&hb.context, size)) {
+      return false;
+    }
+    hb.quiesce = (quiesce != 0);
+    batch->heartbeats.push_back(hb);
+  }
+  return coded.CurrentPosition() == (int)data.size();
+}
+
+}; // namespace libraft
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include "base/util.h"
+#include "core/multi_node.h"
+#include "core/node.h"
+#include "core/raft.h"
+
+namespace libraft {
+
+MultiNodeImpl::MultiNodeImpl()
+  : MultiNode()
+  , stopped_(false) {
+}
+
+MultiNodeImpl::~MultiNodeImpl() {
+  map<uint64_t, raftGroup*>::iterator iter;
+  for (iter = groups_.begin(); iter != groups_.end(); ++iter) {
+    wheel_.cancel(&iter->second->timer_);
+    delete iter->second->node_;
+    delete iter->second;
+  }
+}
+
+int
+MultiNodeImpl::CreateGroup(uint64_t groupId, Config *config, const vector<Peer>& peers) {
+  if (groups_.find(groupId) != groups_.end()) {
+    return ErrGroupExists;
+  }
+  // the groups are advanced with Advance
+  if (config->asyncReady) {
+    return ErrInvalidConfig;
+  }
+
+  Node *node;
+  if (peers.empty()) {
+    node = RestartNode(config);
+  } else {
+    node = StartNode(config, peers);
+  }
+  if (node == NULL) {
+    return ErrInvalidConfig;
+  }
+
+  raftGroup *group = new raftGroup(groupId, static_cast<NodeImpl*>(node), wheel_.now());
+  groups_[groupId] = group;
+
+  // the initial conf change entries of StartNode are to be saved and applied
+  Ready *ready;
+  group->node_->PollReady(&ready);
+  saveReady(group, ready);
+  return OK;
+}
+
+int
+MultiNodeImpl::RemoveGroup(uint64_t groupId) {
+  map<uint64_t, raftGroup*>::iterator iter = groups_.find(groupId);
+  if (iter == groups_.end()) {
+    return ErrGroupNotFound;
+  }
+  raftGroup *group = iter->second;
+  groups_.erase(iter);
+
+  size_t i;
+  for (i = 0; i < readyGroups_.size(); ++i) {
+    if (readyGroups_[i] == group) {
+      readyGroups_.erase(readyGroups_.begin() + i);
+      break;
+    }
+  }
+  wheel_.cancel(&group->timer_);
+  delete group->node_;
+  delete group;
+  return OK;
+}
+
+raftGroup*
+MultiNodeImpl::getGroup(uint64_t groupId) {
+  map<uint64_t, raftGroup*>::iterator iter = groups_.find(groupId);
+  if (iter == groups_.end()) {
+    return NULL;
+  }
+  return iter->second;
+}
+
+// a node returns at most one Ready until it is advanced,
+// so each group is saved in readyGroups_ at most once.
+void
+MultiNodeImpl::saveReady(raftGroup *group, Ready *ready) {
+  raft *r = group->node_->raft_;
+  if (r->quiescent_) {
+    wheel_.cancel(&group->timer_);
+  } else {
+    wheel_.schedule(&group->timer_, group->lastTick_ + r->ticksToDeadline());
+  }
+  if (ready == NULL) {
+    return;
+  }
+  group->ready_ = ready;
+  readyGroups_.push_back(group);
+}
+
+void
+MultiNodeImpl::syncTicks(raftGroup *group) {
+  uint64_t now = wheel_.now();
+  if (group->lastTick_ == now) {
+    return;
+  }
+  group->node_->raft_->skipTicks((int)(now - group->lastTick_));
+  group->lastTick_ = now;
+}
+
+// Tick only visits the groups whose heartbeat or election deadline
+// expired, so its cost scales with them instead of all the groups hosted.
+void
+MultiNodeImpl::Tick() {
+  if (stopped_) {
+    return;
+  }
+  expired_.clear();
+  wheel_.advance(&expired_);
+  uint64_t now = wheel_.now();
+  size_t i;
+  for (i = 0; i < expired_.size(); ++i) {
+    raftGroup *group = static_cast<raftGroup*>(expired_[i]->data_);
+    // the ticks before the deadline take no action
+    group->node_->raft_->skipTicks((int)(now - group->lastTick_ - 1));
+    group->lastTick_ = now;
+
+    Ready *ready;
+    group->node_->Tick(&ready);
+    saveReady(group, ready);
+  }
+}
+
+int
+MultiNodeImpl::Wake(uint64_t groupId) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  syncTicks(group);
+  group->node_->raft_->wake();
+  saveReady(group, NULL);
+  return OK;
+}
+
+int
+MultiNodeImpl::Campaign(uint64_t groupId) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  int err = group->node_->Campaign(&ready);
+  saveReady(group, ready);
+  return err;
+}
+
+int
+MultiNodeImpl::Propose(uint64_t groupId, const string& data) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  int err = group->node_->Propose(data, &ready);
+  saveReady(group, ready);
+  return err;
+}
+
+int
+MultiNodeImpl::ProposeConfChange(uint64_t groupId, const ConfChange& cc) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  int err = group->node_->ProposeConfChange(cc, &ready);
+  saveReady(group, ready);
+  return err;
+}
+
+int
+MultiNodeImpl::Step(uint64_t groupId, const Message& msg) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  int err = group->node_->Step(msg, &ready);
+  saveReady(group, ready);
+  return err;
+}
+
+int
+MultiNodeImpl::ApplyConfChange(uint64_t groupId, const ConfChange& cc, ConfState *cs) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  group->node_->ApplyConfChange(cc, cs, &ready);
+  saveReady(group, ready);
+  return OK;
+}
+
+int
+MultiNodeImpl::TransferLeadership(uint64_t groupId, uint64_t leader, uint64_t transferee) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  group->node_->TransferLeadership(leader, transferee, &ready);
+  saveReady(group, ready);
+  return OK;
+}
+
+int
+MultiNodeImpl::ReadIndex(uint64_t groupId, const string &rctx) {
+  raftGroup *group = getGroup(groupId);
+  if (group == NULL) {
+    return ErrGroupNotFound;
+  }
+  Ready *ready;
+  syncTicks(group);
+  int err = group->node_->ReadIndex(rctx, &ready);
+  saveReady(group, ready);
+  return err;
+}
+
+void
+MultiNodeImpl::Readies(GroupReadyVec *readies) {
+  readies->clear();
+  readies->reserve(readyGroups_.size());
+  size_t i;
+  // advanceGroup may append to readyGroups_, which is handled in this loop
+  for (i = 0; i < readyGroups_.size(); ++i) {
+    raftGroup *group = readyGroups_[i];
+    coalesceHeartbeats(group);
+    if (!group->node_->readyContainUpdate()) {
+      // only heartbeats, nothing to do for the application
+      advanceGroup(group);
+      continue;
+    }
+    GroupReady gr;
+    gr.groupId = group->id_;
+    gr.ready = group->ready_;
+    readies->push_back(gr);
+  }
+  readyGroups_.clear();
+}
+
+void
+MultiNodeImpl::advanceGroup(raftGroup *group) {
+  group->ready_ = NULL;
+  syncTicks(group);
+  group->node_->Advance();
+
+  // return what the group has done since the Ready in the next batch
+  Ready *ready;
+  group->node_->PollReady(&ready);
+  saveReady(group, ready);
+}
+
+void
+MultiNodeImpl::coalesceHeartbeats(raftGroup *group) {
+  MessageVec& msgs = group->ready_->messages;
+  size_t i, n = 0;
+  for (i = 0; i < msgs.size(); ++i) {
+    const Message *msg = msgs[i];
+    if (msg->type() != MsgHeartbeat && msg->type() != MsgHeartbeatResp) {
+      msgs[n++] = msgs[i];
+      continue;
+    }
+
+    HeartbeatBatch *batch = heartbeatBatch(msg->type(), msg->from(), msg->to());
+    batch->heartbeats.push_back(GroupHeartbeat());
+    GroupHeartbeat& hb = batch->heartbeats.back();
+    hb.groupId = group->id_;
+    hb.term = msg->term();
+    hb.commit = msg->commit();
+    hb.context = msg->context();
+    hb.quiesce = isQuiesceHeartbeat(*msg);
+    hb.leaseSentAt = msg->leasesentat();
+  }
+  msgs.resize(n);
+}
+
+HeartbeatBatch*
+MultiNodeImpl::heartbeatBatch(MessageType type, uint64_t from, uint64_t to) {
+  size_t i;
+  for (i = 0; i < heartbeats_.size(); ++i) {
+    HeartbeatBatch *batch = &heartbeats_[i];
+    if (batch->type == type && batch->from == from && batch->to == to) {
+      return batch;
+    }
+  }
+  heartbeats_.push_back(HeartbeatBatch());
+  HeartbeatBatch *batch = &heartbeats_.back();
+  batch->type = type;
+  batch->from = from;
+  batch->to = to;
+  return batch;
+}
+
+void
+MultiNodeImpl::Heartbeats(HeartbeatBatchVec *batches) {
+  batches->clear();
+  batches->swap(heartbeats_);
+}
+
+void
+MultiNodeImpl::StepHeartbeats(const HeartbeatBatch& batch) {
+  // the batch steps every listed group at its term, which is only
+  // harmless for heartbeats
+  if (!isHeartbeatMessage(batch.type)) {
+    return;
+  }
+  Message msg;
+  msg.set_type(batch.type);
+  msg.set_from(batch.from);
+  msg.set_to(batch.to);
+  size_t i;
+  for (i = 0; i < batch.heartbeats.size(); ++i) {
+    const GroupHeartbeat& hb = batch.heartbeats[i];
+    msg.set_term(hb.term);
+    msg.set_commit(hb.commit);
+    msg.set_context(hb.context);
+    msg.set_quiesce(hb.quiesce);
+    msg.set_leasesentat(hb.leaseSentAt);
+    // the group may have been removed on this node
+    Step(hb.groupId, msg);
+  }
+}
+
+void
+MultiNodeImpl::Advance(const GroupReadyVec& readies) {
+  size_t i;
+  for (i = 0; i < readies.size(); ++i) {
+    raftGroup *group = getGroup(readies[i].groupId);
+    if (group == NULL || group->ready_ != readies[i].ready) {
+      continue;
+    }
+    advanceGroup(group);
+  }
+}
+
+void
+MultiNodeImpl::Stop() {
+  stopped_ = true;
+  map<uint64_t, raftGroup*>::iterator iter;
+  for (iter = groups_.begin(); iter != groups_.end(); ++iter) {
+    iter->second->node_->Stop();
+  }
+}
+
+MultiNode*
+NewMultiNode() {
+  return new MultiNodeImpl();
+}
+
+}; // namespace libraft
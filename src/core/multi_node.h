@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_MULTI_NODE_H__
+#define __LIBRAFT_MULTI_NODE_H__
+
+#include <map>
+#include "libraft.h"
+#include "base/timing_wheel.h"
+
+namespace libraft {
+
+class NodeImpl;
+
+// raftGroup is a raft group hosted in a MultiNodeImpl
+struct raftGroup {
+  uint64_t id_;
+  NodeImpl *node_;
+
+  // the Ready returned by the node and not yet advanced
+  Ready *ready_;
+
+  // fires at the next tick of the group taking an action,
+  // not scheduled when the group is quiescent
+  timer timer_;
+
+  // the tick of the wheel the elapsed ticks of the group are synced to
+  uint64_t lastTick_;
+
+  raftGroup(uint64_t id, NodeImpl *node, uint64_t now)
+    : id_(id),
+      node_(node),
+      ready_(NULL),
+      timer_(this),
+      lastTick_(now) {}
+};
+
+class MultiNodeImpl : public MultiNode {
+public:
+  MultiNodeImpl();
+  virtual ~MultiNodeImpl();
+
+  virtual int  CreateGroup(uint64_t groupId, Config *config, const vector<Peer>& peers);
+  virtual int  RemoveGroup(uint64_t groupId);
+  virtual void Tick();
+  virtual int  Wake(uint64_t groupId);
+  virtual int  Campaign(uint64_t groupId);
+  virtual int  Propose(uint64_t groupId, const string& data);
+  virtual int  ProposeConfChange(uint64_t groupId, const ConfChange& cc);
+  virtual int  Step(uint64_t groupId, const Message& msg);
+  virtual int  ApplyConfChange(uint64_t groupId, const ConfChange& cc, ConfState *cs);
+  virtual int  TransferLeadership(uint64_t groupId, uint64_t leader, uint64_t transferee);
+  virtual int  ReadIndex(uint64_t groupId, const string &rctx);
+  virtual void Readies(GroupReadyVec *readies);
+  virtual void Advance(const GroupReadyVec& readies);
+  virtual void Heartbeats(HeartbeatBatchVec *batches);
+  virtual void StepHeartbeats(const HeartbeatBatch& batch);
+  virtual void Stop();
+
+private:
+  raftGroup* getGroup(uint64_t groupId);
+
+  // save the Ready returned by the node of group if any, and
+  // schedule the next tick of the group unless it is quiescent
+  void saveReady(raftGroup *group, Ready *ready);
+
+  // sync the elapsed ticks of group to the wheel, which must be
+  // done before the group handles anything
+  void syncTicks(raftGroup *group);
+
+  void advanceGroup(raftGroup *group);
+
+  // move the heartbeats out of the Ready of group into heartbeats_
+  void coalesceHeartbeats(raftGroup *group);
+  HeartbeatBatch* heartbeatBatch(MessageType type, uint64_t from, uint64_t to);
+
+public:
+  bool stopped_;
+
+  map<uint64_t, raftGroup*> groups_;
+
+  // groups with a Ready not yet returned by Readies
+  vector<raftGroup*> readyGroups_;
+
+  // drives the ticks of the groups, a group is only ticked at its
+  // heartbeat or election deadline
+  timingWheel wheel_;
+
+  // the timers expired in Tick
+  vector<timer*> expired_;
+
+  // coalesced heartbeats not yet returned by Heartbeats, one batch
+  // per (type, from, to), there are only a few destinations
+  HeartbeatBatchVec heartbeats_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_MULTI_NODE_H__
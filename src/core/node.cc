@@ -3,12 +3,25 @@
  */
 
 #include <unistd.h>
+#include <utility>
 #include "base/util.h"
 #include "core/node.h"
 #include "core/raft.h"
 
 namespace libraft {
 
+// size of the first block of each Ready arena, kept across `Advance'
+// so that a round usually allocates nothing from the heap
+static const size_t kArenaBlockSize = 64 * 1024;
+
+static google::protobuf::Arena*
+newArena(char *block) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block;
+  options.initial_block_size = kArenaBlockSize;
+  return new google::protobuf::Arena(options);
+}
+
 // IsEmptySnap returns true if the given Snapshot is empty.
 inline static bool 
 isEmptyHardState(const HardState& hs) {
@@ -20,6 +33,17 @@ isEmptySoftState(const SoftState& ss) {
   return isSoftStateEqual(ss, kEmptySoftState);
 }
 
+static bool
+containUpdate(const Ready& ready) {
+  return (!isEmptySoftState(ready.softState) ||
+          !isEmptyHardState(ready.hardState) ||
+          !isEmptySnapshot(ready.snapshot)  ||
+          !ready.entries.empty()             ||
+          !ready.committedEntries.empty()    ||
+          !ready.messages.empty()            ||
+          !ready.readStates.empty());
+}
+
 NodeImpl::NodeImpl(Logger* logger, raft* r)
   : Node()
   , stopped_(false)
@@ -29,20 +53,54 @@ NodeImpl::NodeImpl(Logger* logger, raft* r)
   , prevSoftState_(kEmptySoftState)
   , prevHardState_(kEmptyHardState)
   , waitAdvanced_(false)
+  , deferReady_(false)
+  , asyncReady_(false)
   , canPropose_(true)
   , msgType_(NoneMessage)
   , prevLastUnstableIndex_(0)
   , prevLastUnstableTerm_(0)
   , havePrevLastUnstableIndex_(false)
   , prevSnapshotIndex_(0)
+  , proposeEntries_(NULL)
+  , arenaBlocks_(new char[2 * kArenaBlockSize])
+  , waitsTerm_(0)
   , confState_(NULL) {
   // init prev softState
   r->softState(&prevSoftState_);
+  stepArena_  = newArena(arenaBlocks_);
+  readyArena_ = newArena(arenaBlocks_ + kArenaBlockSize);
+  r->arena_ = stepArena_;
+}
+
+readySlot::readySlot()
+  : arena_(new google::protobuf::Arena()),
+    haveEntries_(false),
+    lastIndex_(0),
+    lastTerm_(0),
+    snapshotIndex_(0),
+    appliedIndex_(0),
+    pending_(0) {
+  snapshot = NULL;
+  sendFirst = false;
+}
+
+readySlot::~readySlot() {
+  // the messages and read states live in the arena
+  messages.clear();
+  readStates.clear();
+  delete arena_;
 }
 
 NodeImpl::~NodeImpl() {
+  size_t i;
+  for (i = 0; i < slots_.size(); ++i) {
+    delete slots_[i];
+  }
   delete raft_;
   delete logger_;
+  delete stepArena_;
+  delete readyArena_;
+  delete [] arenaBlocks_;
 }
 
 void 
@@ -60,11 +118,147 @@ NodeImpl::Campaign(Ready **ready) {
 
 int 
 NodeImpl::Propose(const string& data, Ready **ready) {
-  Message msg;
-  msg.set_type(MsgProp);
-  msg.set_from(raft_->id_);
-  msg.add_entries()->set_data(data);
-  return doStep(msg, ready);
+  EntryVec entries(1);
+  entries[0].set_type(EntryNormal);
+  entries[0].set_data(data);
+  return proposeEntries(&entries, ready);
+}
+
+int 
+NodeImpl::Propose(string&& data, Ready **ready) {
+  EntryVec entries(1);
+  entries[0].set_type(EntryNormal);
+  entries[0].set_data(std::move(data));
+  return proposeEntries(&entries, ready);
+}
+
+int 
+NodeImpl::ProposeBatch(const vector<string>& datas, Ready **ready) {
+  if (datas.empty()) {
+    *ready = NULL;
+    return OK;
+  }
+
+  EntryVec entries(datas.size());
+  size_t i;
+  for (i = 0; i < datas.size(); ++i) {
+    entries[i].set_type(EntryNormal);
+    entries[i].set_data(datas[i]);
+  }
+  return proposeEntries(&entries, ready);
+}
+
+int 
+NodeImpl::ProposeBatch(vector<string>&& datas, Ready **ready) {
+  if (datas.empty()) {
+    *ready = NULL;
+    return OK;
+  }
+
+  EntryVec entries(datas.size());
+  size_t i;
+  for (i = 0; i < datas.size(); ++i) {
+    entries[i].set_type(EntryNormal);
+    entries[i].set_data(std::move(datas[i]));
+  }
+  datas.clear();
+  return proposeEntries(&entries, ready);
+}
+
+int
+NodeImpl::ProposeWithCallback(const string& data, const ProposeDone& done, Ready **ready) {
+  EntryVec entries(1);
+  entries[0].set_type(EntryNormal);
+  entries[0].set_data(data);
+  return proposeEntries(&entries, vector<ProposeDone>(1, done), ready);
+}
+
+int
+NodeImpl::ProposeBatchWithCallbacks(vector<string>&& datas, const vector<ProposeDone>& dones,
+                                    Ready **ready) {
+  if (datas.empty()) {
+    *ready = NULL;
+    return OK;
+  }
+
+  EntryVec entries(datas.size());
+  size_t i;
+  for (i = 0; i < datas.size(); ++i) {
+    entries[i].set_type(EntryNormal);
+    entries[i].set_data(std::move(datas[i]));
+  }
+  datas.clear();
+  return proposeEntries(&entries, dones, ready);
+}
+
+// proposeEntries hands the proposal entries to raft. On the leader the entries
+// are moved straight into the log, so a payload is allocated once and never
+// copied; otherwise they are packed into a MsgProp to be forwarded to the leader.
+int 
+NodeImpl::proposeEntries(EntryVec *entries, Ready **ready) {
+  if (raft_->state_ != StateLeader) {
+    // without a leader the proposal is dropped by raft
+    bool dropped = !raft_->hasLeader();
+    Message msg;
+    msg.set_type(MsgProp);
+    msg.set_from(raft_->id_);
+    msg.mutable_entries()->Reserve(entries->size());
+    size_t i;
+    for (i = 0; i < entries->size(); ++i) {
+      *msg.add_entries() = std::move((*entries)[i]);
+    }
+    int err = doStep(msg, ready);
+    return (SUCCESS(err) && dropped) ? ErrProposalDropped : err;
+  }
+
+  uint64_t lastIndex = raft_->raftLog_->lastIndex();
+  msgType_ = ProposeMessage;
+  proposeEntries_ = entries;
+  int err = stateMachine(Message(), ready);
+  if (SUCCESS(err) && raft_->raftLog_->lastIndex() == lastIndex) {
+    return ErrProposalDropped;
+  }
+  return err;
+}
+
+// proposeEntries proposes the entries with callbacks, the entries of a
+// leader are appended after its last index in order, which keys the callbacks.
+// A proposal with a callback forwarded to the leader cannot be tracked, so it
+// is dropped, the ones without a callback are forwarded as by ProposeBatch.
+int
+NodeImpl::proposeEntries(EntryVec *entries, const vector<ProposeDone>& dones, Ready **ready) {
+  int err = ErrProposalDropped;
+  uint64_t lastIndex = raft_->raftLog_->lastIndex();
+  if (raft_->state_ == StateLeader) {
+    err = proposeEntries(entries, ready);
+  } else {
+    EntryVec forwarded;
+    size_t j;
+    for (j = 0; j < entries->size(); ++j) {
+      if (j >= dones.size() || !dones[j]) {
+        forwarded.push_back(std::move((*entries)[j]));
+      }
+    }
+    if (forwarded.empty()) {
+      *ready = NULL;
+    } else {
+      proposeEntries(&forwarded, ready);
+    }
+  }
+
+  size_t i;
+  for (i = 0; i < dones.size(); ++i) {
+    if (!dones[i]) {
+      continue;
+    }
+    if (!SUCCESS(err)) {
+      dones[i](err, raft_->term_, 0);
+      continue;
+    }
+    waitsTerm_ = raft_->term_;
+    waits_.add(raft_->term_, lastIndex + 1 + i, dones[i]);
+  }
+  return err;
 }
 
 int 
@@ -98,22 +292,88 @@ NodeImpl::Step(const Message& msg, Ready **ready) {
 
 void
 NodeImpl::Advance() {
+  if (asyncReady_) {
+    logger_->Fatalf(__FILE__, __LINE__, "Advance called with the asynchronous Ready pipeline");
+  }
   if (prevHardState_.commit() != 0) {
     raft_->raftLog_->appliedTo(prevHardState_.commit());
   }
   if (havePrevLastUnstableIndex_) {
-    raft_->raftLog_->stableTo(prevLastUnstableIndex_, prevLastUnstableTerm_);
+    raft_->stableTo(prevLastUnstableIndex_, prevLastUnstableTerm_);
     havePrevLastUnstableIndex_ = false;
   }
   raft_->raftLog_->stableSnapTo(prevSnapshotIndex_);
-  size_t i;
-  for (i = 0; i < ready_.messages.size(); ++i) {
-    delete ready_.messages[i];
-  }
-  for (i = 0; i < ready_.readStates.size(); ++i) {
-    delete ready_.readStates[i];
+  // release all the messages and read states of the Ready at once
+  ready_.messages.clear();
+  ready_.readStates.clear();
+  readyArena_->Reset();
+  if (waitAdvanced_) {
+    // the committed entries of the Ready have been applied
+    waits_.applied(ready_.committedEntries);
   }
   waitAdvanced_ = false;
+  reads_.applied(raft_->raftLog_->applied_);
+}
+
+void
+NodeImpl::AdvanceStable(Ready *ready) {
+  readySlot *slot = ackStage(ready);
+  if (slot->snapshotIndex_ != 0) {
+    raft_->raftLog_->stableSnapTo(slot->snapshotIndex_);
+  }
+  if (slot->haveEntries_) {
+    // a no-op if the entries have been overwritten meanwhile
+    raft_->stableTo(slot->lastIndex_, slot->lastTerm_);
+  }
+  if (slot->pending_ == 0) {
+    releaseSlot(slot);
+  }
+}
+
+void
+NodeImpl::AdvanceSent(Ready *ready) {
+  readySlot *slot = ackStage(ready);
+  if (slot->pending_ == 0) {
+    releaseSlot(slot);
+  }
+}
+
+void
+NodeImpl::AdvanceApplied(Ready *ready) {
+  readySlot *slot = ackStage(ready);
+  raft_->raftLog_->appliedTo(slot->appliedIndex_);
+  waits_.applied(slot->committedEntries);
+  reads_.applied(raft_->raftLog_->applied_);
+  if (slot->pending_ == 0) {
+    releaseSlot(slot);
+  }
+}
+
+readySlot*
+NodeImpl::ackStage(Ready *ready) {
+  readySlot *slot = static_cast<readySlot*>(ready);
+  if (!asyncReady_ || slot->pending_ <= 0) {
+    logger_->Fatalf(__FILE__, __LINE__, "acknowledge a stage of a Ready not in progress");
+  }
+  slot->pending_--;
+  return slot;
+}
+
+void
+NodeImpl::releaseSlot(readySlot *slot) {
+  slot->softState = kEmptySoftState;
+  slot->hardState = kEmptyHardState;
+  slot->snapshot = NULL;
+  slot->readStates.clear();
+  slot->entries.clear();
+  slot->committedEntries.clear();
+  slot->messages.clear();
+  slot->arena_->Reset();
+  slot->haveEntries_ = false;
+  slot->snapshotIndex_ = 0;
+  slot->appliedIndex_ = 0;
+  slot->sendFirst = false;
+  freeSlots_.push_back(slot);
 }
 
 void 
@@ -150,6 +410,12 @@ NodeImpl::TransferLeadership(uint64_t leader, uint64_t transferee, Ready **ready
   stateMachine(msg, ready);
 }
 
+void
+NodeImpl::PollReady(Ready **ready) {
+  msgType_ = ReadyMessage;
+  stateMachine(Message(), ready);
+}
+
 int NodeImpl::ReadIndex(const string &rctx, Ready **ready) {
   Message msg;
   msg.set_type(MsgReadIndex);
@@ -158,6 +424,34 @@ int NodeImpl::ReadIndex(const string &rctx, Ready **ready) {
   return doStep(msg, ready);
 }
 
+int
+NodeImpl::ReadIndexWithCallback(const ReadDone& done, Ready **ready) {
+  int err = OK;
+  if (stopped_) {
+    err = ErrStopped;
+  } else if (!raft_->hasLeader()) {
+    err = ErrReadIndexDropped;
+  }
+  if (!SUCCESS(err)) {
+    *ready = NULL;
+    done(err, 0);
+    return err;
+  }
+
+  reads_.add(done);
+  msgType_ = ReadMessage;
+  return stateMachine(Message(), ready);
+}
+
+void
+NodeImpl::WaitApplied(uint64_t index, const ReadDone& done) {
+  if (stopped_) {
+    done(ErrStopped, index);
+    return;
+  }
+  reads_.waitApplied(index, raft_->raftLog_->applied_, done);
+}
+
 int 
 NodeImpl::stateMachine(const Message& msg, Ready **ready) {
   if (stopped_) {
@@ -184,7 +478,12 @@ NodeImpl::stateMachine(const Message& msg, Ready **ready) {
   int ret = OK;
   switch (msgType_) {
   case ProposeMessage:
-    if (canPropose_) {
+    if (!canPropose_) {
+      break;
+    }
+    if (proposeEntries_ != NULL) {
+      raft_->propose(proposeEntries_);
+    } else {
       raft_->step(msg);
     }
     break;
@@ -196,6 +495,7 @@ NodeImpl::stateMachine(const Message& msg, Ready **ready) {
     break;
   case TickMessage:
     raft_->tick();
+    reads_.tick(raft_->electionTimeout_);
     break;
   case ConfChangeMessage:
     handleConfChange();
@@ -204,14 +504,24 @@ NodeImpl::stateMachine(const Message& msg, Ready **ready) {
     break;
   }
 
-  if (waitAdvanced_) {
+  if (!waits_.empty() && raft_->term_ != waitsTerm_) {
+    // the committed entries are resolved when they are applied
+    waits_.abortAfter(raft_->raftLog_->committed_, ErrTermChanged);
+  }
+  handleReads();
+
+  if (waitAdvanced_ || (deferReady_ && msgType_ != ReadyMessage)) {
     *ready = NULL;
+  } else if (asyncReady_) {
+    *ready = newAsyncReady();
   } else {
     *ready = newReady();
     if (!readyContainUpdate()) {
       *ready = NULL;
     } else {
       waitAdvanced_ = true;
+      std::swap(stepArena_, readyArena_);
+      raft_->arena_ = stepArena_;
     }
   }
 
@@ -230,6 +540,9 @@ NodeImpl::handleConfChange() {
   case ConfChangeAddNode:
     raft_->addNode(confChange_.nodeid());
     break;
+  case ConfChangeAddLearnerNode:
+    raft_->addLearner(confChange_.nodeid());
+    break;
   case ConfChangeRemoveNode:
     // block incoming proposal when local node is removed
     if (confChange_.nodeid() == raft_->id_) {
@@ -252,17 +565,58 @@ addnodes:
   for (j = 0; j < nodes.size(); ++j) {
     confState_->add_nodes(nodes[j]);
   }
+  raft_->learnerNodes(&nodes);
+  for (j = 0; j < nodes.size(); ++j) {
+    confState_->add_learners(nodes[j]);
+  }
+}
+
+// handleReads resolves the batches of reads with the read states of raft,
+// which are taken out of the Ready, and sends the next batch if there is
+// none in flight. When the Ready is deferred the batch is sent in PollReady,
+// so that all the reads of the deferred steps share it.
+void
+NodeImpl::handleReads() {
+  bool deferred = deferReady_ && msgType_ != ReadyMessage;
+  vector<ReadState*> states;
+  while (true) {
+    // the callbacks may issue reads, which step raft again
+    states.swap(raft_->readStates_);
+    size_t i;
+    for (i = 0; i < states.size(); ++i) {
+      if (!reads_.resolve(states[i]->requestCtx_, states[i]->index_, raft_->raftLog_->applied_)) {
+        raft_->readStates_.push_back(states[i]);
+      } else if (raft_->arena_ == NULL) {
+        delete states[i];
+      }
+    }
+    states.clear();
+
+    if (deferred || reads_.inFlight() || !reads_.hasUnsent()) {
+      return;
+    }
+    if (!raft_->hasLeader()) {
+      reads_.abortUnsent(ErrReadIndexDropped);
+      return;
+    }
+    // a leader may resolve the batch at once, e.g. a single voter
+    Message msg;
+    msg.set_type(MsgReadIndex);
+    reads_.nextBatch(msg.add_entries()->mutable_data());
+    raft_->step(msg);
+  }
 }
 
 void 
 NodeImpl::reset() {
   msgType_ = NoneMessage;
+  proposeEntries_ = NULL;
   confState_ = NULL;
 }
 
 bool 
 NodeImpl::isMessageFromClusterNode(const Message& msg) {
-  return (raft_->progressMap_.find(msg.from()) != raft_->progressMap_.end());
+  return raft_->progressMap_.contains(msg.from());
 }
 
 Ready* 
@@ -275,6 +629,7 @@ NodeImpl::newReady() {
   ready_.entries.clear();
   ready_.committedEntries.clear();
   ready_.messages.clear();
+  ready_.sendFirst = false;
   
   // 2) return the new ready state data in ready
   raft_->raftLog_->unstableEntries(&ready_.entries);
@@ -292,6 +647,7 @@ NodeImpl::newReady() {
   if (!isHardStateEqual(hs, prevHardState_)) {
     ready_.hardState = hs;
   }
+  ready_.sendFirst = canSendFirst(hs);
 
   if (raft_->raftLog_->unstable_.snapshot_ != NULL) {
     ready_.snapshot = raft_->raftLog_->unstable_.snapshot_;
@@ -302,11 +658,13 @@ NodeImpl::newReady() {
   }
 
   // 3) save the state data
-  prevSoftState_ = ready_.softState;
+  if (!isEmptySoftState(ready_.softState)) {
+    prevSoftState_ = ready_.softState;
+  }
   size_t entSize = ready_.entries.size();
   if (entSize > 0) {
-    prevLastUnstableIndex_ = ready_.entries[entSize - 1].index();
-    prevLastUnstableTerm_  = ready_.entries[entSize - 1].term();
+    prevLastUnstableIndex_ = ready_.entries[entSize - 1]->index();
+    prevLastUnstableTerm_  = ready_.entries[entSize - 1]->term();
     havePrevLastUnstableIndex_ = true;
   }
   if (!isEmptyHardState(ready_.hardState)) {
@@ -322,20 +680,96 @@ NodeImpl::newReady() {
   return &ready_;
 }
 
+// newAsyncReady returns a Ready of what has not been handed out yet, or NULL
+// if there is nothing new. The Readys in progress are left untouched.
+Ready*
+NodeImpl::newAsyncReady() {
+  readySlot *slot;
+  if (freeSlots_.empty()) {
+    slot = new readySlot();
+    slots_.push_back(slot);
+  } else {
+    slot = freeSlots_.back();
+    freeSlots_.pop_back();
+  }
+
+  raftLog *log = raft_->raftLog_;
+  log->nextUnstableEntries(&slot->entries);
+  log->nextCommittedEntries(&slot->committedEntries);
+  slot->messages = raft_->outMsgs_;
+  if (!raft_->readStates_.empty()) {
+    slot->readStates = raft_->readStates_;
+  }
+
+  SoftState ss;
+  raft_->softState(&ss);
+  if (!isSoftStateEqual(ss, prevSoftState_)) {
+    slot->softState = ss;
+  }
+  HardState hs;
+  raft_->hardState(&hs);
+  if (!isHardStateEqual(hs, prevHardState_)) {
+    slot->hardState = hs;
+  }
+  slot->sendFirst = canSendFirst(hs);
+  if (log->unstable_.snapshot_ != NULL && !log->unstable_.snapshotInProgress_) {
+    slot->snapshotCopy_.CopyFrom(*log->unstable_.snapshot_);
+    slot->snapshot = &slot->snapshotCopy_;
+    slot->snapshotIndex_ = slot->snapshotCopy_.metadata().index();
+  }
+
+  if (!containUpdate(*slot)) {
+    freeSlots_.push_back(slot);
+    return NULL;
+  }
+
+  // hand out the Ready
+  if (!isEmptySoftState(slot->softState)) {
+    prevSoftState_ = slot->softState;
+  }
+  if (!isEmptyHardState(slot->hardState)) {
+    prevHardState_ = slot->hardState;
+  }
+  if (!slot->entries.empty()) {
+    slot->haveEntries_ = true;
+    slot->lastIndex_ = slot->entries.back()->index();
+    slot->lastTerm_  = slot->entries.back()->term();
+  }
+  slot->appliedIndex_ = slot->snapshotIndex_;
+  if (!slot->committedEntries.empty()) {
+    slot->appliedIndex_ = slot->committedEntries.back()->index();
+    log->acceptApplying(slot->appliedIndex_);
+  }
+  log->acceptUnstable();
+  slot->pending_ = 3;
+
+  // the messages and read states stay in the arena of the slot
+  std::swap(stepArena_, slot->arena_);
+  raft_->arena_ = stepArena_;
+  raft_->outMsgs_.clear();
+  raft_->readStates_.clear();
+
+  return slot;
+}
+
+// canSendFirst returns true if the messages of a Ready with the hard state hs
+// may be sent before it is saved, see Config.parallelAppend.
+bool
+NodeImpl::canSendFirst(const HardState& hs) {
+  return raft_->parallelAppend_ && raft_->state_ == StateLeader &&
+         hs.term() == prevHardState_.term() && hs.vote() == prevHardState_.vote();
+}
+
 void 
 NodeImpl::Stop() {
   stopped_ = true;
+  waits_.abortAfter(0, ErrStopped);
+  reads_.abort(ErrStopped);
 }
 
 bool 
 NodeImpl::readyContainUpdate() {
-  return (!isEmptySoftState(ready_.softState) ||
-          !isEmptyHardState(ready_.hardState) ||
-          !isEmptySnapshot(ready_.snapshot)  ||
-          !ready_.entries.empty()             ||
-          !ready_.committedEntries.empty()    ||
-          !ready_.messages.empty()            ||
-          !ready_.readStates.empty());
+  return containUpdate(ready_);
 }
 
 // StartNode returns a new Node given configuration and a list of raft peers.
@@ -392,7 +826,9 @@ StartNode(Config* config, const vector<Peer>& peers) {
     r->addNode(peer.Id);
   }
 
-  return new NodeImpl(config->logger, r);
+  NodeImpl *n = new NodeImpl(config->logger, r);
+  n->asyncReady_ = config->asyncReady;
+  return n;
 }
 
 // RestartNode is similar to StartNode but does not take a list of peers.
@@ -406,7 +842,9 @@ RestartNode(Config *config) {
     return NULL;
   }
 
-  return new NodeImpl(config->logger, r);
+  NodeImpl *n = new NodeImpl(config->logger, r);
+  n->asyncReady_ = config->asyncReady;
+  return n;
 }
 
 }; // namespace libraft
\ No newline at end of file
@@ -6,6 +6,8 @@
 #define __LIBRAFT_NODE_H__
 
 #include "libraft.h"
+#include "core/proposal_waits.h"
+#include "core/read_waits.h"
 
 namespace libraft {
 
@@ -15,12 +17,40 @@ enum NodeMessageType {
   ConfChangeMessage = 2,
   TickMessage       = 3,
   ReadyMessage      = 4,
-  NoneMessage       = 5
+  NoneMessage       = 5,
+  ReadMessage       = 6
 };
 
 struct raft;
 class Logger;
 
+// readySlot is a Ready handed out by the asynchronous Ready pipeline with the
+// state to acknowledge its stages, it is recycled once all of them are done.
+struct readySlot : public Ready {
+  readySlot();
+  ~readySlot();
+
+  // the messages and read states of the Ready
+  google::protobuf::Arena* arena_;
+
+  // a copy of the snapshot, the unstable one may be replaced meanwhile
+  Snapshot snapshotCopy_;
+
+  // the last entry to be persisted, if haveEntries_
+  bool haveEntries_;
+  uint64_t lastIndex_;
+  uint64_t lastTerm_;
+
+  // the index of the snapshot, 0 if none
+  uint64_t snapshotIndex_;
+
+  // the log is applied to appliedIndex_ once the Ready is applied
+  uint64_t appliedIndex_;
+
+  // the number of stages not acknowledged yet
+  int pending_;
+};
+
 class NodeImpl : public Node {
 public:
   NodeImpl(Logger*, raft*);
@@ -29,23 +59,52 @@ public:
   virtual void Tick(Ready **ready);
   virtual int  Campaign(Ready **ready);
   virtual int  Propose(const string& data, Ready **ready);
+  virtual int  Propose(string&& data, Ready **ready);
+  virtual int  ProposeBatch(const vector<string>& datas, Ready **ready);
+  virtual int  ProposeBatch(vector<string>&& datas, Ready **ready);
+  virtual int  ProposeWithCallback(const string& data, const ProposeDone& done, Ready **ready);
   virtual int  ProposeConfChange(const ConfChange& cc, Ready **ready);
   virtual int  Step(const Message& msg, Ready **ready);
   virtual void Advance();
+  virtual void AdvanceStable(Ready *ready);
+  virtual void AdvanceSent(Ready *ready);
+  virtual void AdvanceApplied(Ready *ready);
   virtual void ApplyConfChange(const ConfChange& cc, ConfState *cs, Ready **ready);
   virtual void TransferLeadership(uint64_t leader, uint64_t transferee, Ready **ready);
   virtual int  ReadIndex(const string &rctx, Ready **ready);
+  virtual int  ReadIndexWithCallback(const ReadDone& done, Ready **ready);
+  virtual void WaitApplied(uint64_t index, const ReadDone& done);
   virtual void Stop();
 
+  // ProposeBatchWithCallbacks proposes datas like ProposeBatch, dones[i] is
+  // the callback of datas[i] if it is set, see ProposeWithCallback. On a
+  // follower only the datas with a callback are dropped, the others are
+  // forwarded to the leader.
+  int ProposeBatchWithCallbacks(vector<string>&& datas, const vector<ProposeDone>& dones,
+                                Ready **ready);
+
+  // PollReady returns the Ready accumulated since the last Advance if any,
+  // without stepping the state machine.
+  void PollReady(Ready **ready);
+
+  // readyContainUpdate returns true if the last Ready has anything to do
+  bool readyContainUpdate();
+
 private:
   int stateMachine(const Message& msg, Ready **ready);
   Ready* newReady();
+  Ready* newAsyncReady();
+  bool canSendFirst(const HardState& hs);
+  readySlot* ackStage(Ready *ready);
+  void releaseSlot(readySlot *slot);
   int doStep(const Message& msg, Ready **ready);
+  int proposeEntries(EntryVec *entries, Ready **ready);
+  int proposeEntries(EntryVec *entries, const vector<ProposeDone>& dones, Ready **ready);
   bool isMessageFromClusterNode(const Message& msg);
   void handleConfChange();
   void handleAdvance();
+  void handleReads();
   void reset();
-  bool readyContainUpdate();
 
 public:
   bool stopped_;
@@ -61,6 +120,17 @@ public:
   HardState prevHardState_;
   bool waitAdvanced_;
 
+  // when deferReady_ is set the steps return no Ready, so that the changes
+  // of many steps are returned in one Ready by the next PollReady.
+  bool deferReady_;
+
+  // when asyncReady_ is set the Readys are handed out by the asynchronous
+  // pipeline, see Config.asyncReady. slots_ owns all the slots, the ones
+  // not handed out are in freeSlots_.
+  bool asyncReady_;
+  vector<readySlot*> slots_;
+  vector<readySlot*> freeSlots_;
+
   // save Ready data in each step
   Ready ready_;
 
@@ -76,6 +146,27 @@ public:
   bool     havePrevLastUnstableIndex_;
   uint64_t prevSnapshotIndex_;
 
+  // for Propose, entries to be moved into the leader log
+  EntryVec* proposeEntries_;
+
+  // messages and read states of a Ready are allocated from one arena, which is
+  // released in a single step in `Advance'. raft allocates from stepArena_, the
+  // arenas are swapped when a Ready is handed out, so the steps taken before
+  // `Advance' never allocate from the arena being released.
+  google::protobuf::Arena* stepArena_;
+  google::protobuf::Arena* readyArena_;
+  char* arenaBlocks_;
+
+  // the proposals with a callback waiting for their entries, all of them
+  // are proposed in waitsTerm_, they are resolved in `Advance' and failed
+  // with ErrTermChanged once the term changes.
+  proposalWaits waits_;
+  uint64_t waitsTerm_;
+
+  // the reads with a callback, their read states are taken out of
+  // raft before the Ready is built, see handleReads.
+  readWaits reads_;
+
   // for ApplyConfChange 
   ConfChange confChange_;
   ConfState*  confState_;
@@ -2,18 +2,23 @@
  * Copyright (C) lichuang
  */
 
+#include <algorithm>
 #include "core/progress.h"
 
 namespace libraft {
 
-Progress::Progress(uint64_t next, int maxInfilght, Logger *logger)
+Progress::Progress(uint64_t next, int maxInfilght, Logger *logger, uint64_t maxInflightBytes)
   : match_(0),
     next_(next),
     state_(ProgressStateProbe),
     paused_(false),  
     pendingSnapshot_(0),
     recentActive_(false),
-    inflights_(inflights(maxInfilght, logger)),
+    isLearner_(false),
+    heartbeatAckedAt_(0),
+    inflights_(inflights(maxInfilght, logger, maxInflightBytes)),
+    tracker_(NULL),
+    trackedMatch_(0),
     logger_(logger) {
 }
 
@@ -26,6 +31,51 @@ Progress::resetState(ProgressState state) {
   pendingSnapshot_ = 0;
   state_ = state;
   inflights_.reset();
+  if (flow_.enabled_) {
+    flow_.restart();
+    inflights_.limit_ = flow_.window_;
+  }
+}
+
+void
+Progress::reinit(uint64_t next, int maxInfilght, uint64_t maxInflightBytes) {
+  setMatch(0);
+  next_ = next;
+  recentActive_ = false;
+  heartbeatAckedAt_ = 0;
+  inflights_.reinit(maxInfilght, maxInflightBytes);
+  if (flow_.enabled_) {
+    flow_.maxWindow_ = max(maxInfilght, 1);
+    flow_.minWindow_ = min(flow_.minWindow_, flow_.maxWindow_);
+  }
+  resetState(ProgressStateProbe);
+}
+
+void
+Progress::enableFlowControl(uint32_t minWindow, uint64_t minSize, uint64_t maxSize) {
+  flow_.enable(minWindow, inflights_.size_, minSize, maxSize);
+  inflights_.limit_ = flow_.window_;
+  inflights_.enableSentAt();
+}
+
+uint64_t
+Progress::sizePerMsg(uint64_t size) {
+  return flow_.enabled_ ? flow_.sizePerMsg_ : size;
+}
+
+void
+Progress::ackTo(uint64_t to, uint64_t now) {
+  if (!flow_.enabled_) {
+    inflights_.freeTo(to);
+    return;
+  }
+
+  uint64_t bytes, sentAt;
+  inflights_.freeTo(to, &bytes, &sentAt);
+  if (sentAt != 0) {
+    flow_.onAck(sentAt, now);
+    inflights_.limit_ = flow_.window_;
+  }
 }
 
 void
@@ -55,13 +105,21 @@ Progress::becomeSnapshot(uint64_t snapshoti) {
   pendingSnapshot_ = snapshoti;
 }
 
+void
+Progress::setMatch(uint64_t match) {
+  match_ = match;
+  if (tracker_ != NULL) {
+    tracker_->update(this);
+  }
+}
+
 // maybeUpdate returns false if the given n index comes from an outdated message.
 // Otherwise it updates the progress and returns true.
 bool
 Progress::maybeUpdate(uint64_t n) {
   bool updated = false;
   if (match_ < n) {
-    match_ = n;
+    setMatch(n);
     updated = true;
     resume();
   }
@@ -82,9 +140,11 @@ Progress::snapshotFailure() {
 }
 
 // maybeDecrTo returns false if the given to index comes from an out of order message.
-// Otherwise it decreases the progress next index to min(rejected, last) and returns true.
+// Otherwise it decreases the progress next index to min(rejected, matchHint + 1) and
+// returns true, matchHint is the largest index the logs of the leader and the
+// follower may still match at.
 bool
-Progress::maybeDecrTo(uint64_t rejected, uint64_t last) {
+Progress::maybeDecrTo(uint64_t rejected, uint64_t matchHint) {
   if (state_ == ProgressStateReplicate) {
     // the rejection must be stale if the progress has matched and "rejected"
     // is smaller than "match".
@@ -101,7 +161,7 @@ Progress::maybeDecrTo(uint64_t rejected, uint64_t last) {
     return false;
   }
 
-  next_ = min(rejected, last + 1);
+  next_ = min(rejected, matchHint + 1);
   if (next_ < 1) {
     next_ = 1;
   }
@@ -165,7 +225,7 @@ Progress::String() {
 }
 
 void 
-inflights::add(uint64_t infight) {
+inflights::add(uint64_t infight, uint64_t bytes, uint64_t sentAt) {
   if (full()) {
     logger_->Fatalf(__FILE__, __LINE__, "cannot add into a full inflights");
   }
@@ -181,6 +241,13 @@ inflights::add(uint64_t infight) {
     growBuf();
   }
   buffer_[next] = infight;
+  if (maxBytes_ != 0) {
+    sizes_[next] = bytes;
+    bytes_ += bytes;
+  }
+  if (timed_) {
+    sentAt_[next] = sentAt;
+  }
   count_++;
 }
 
@@ -197,11 +264,25 @@ inflights::growBuf() {
   }
 
   buffer_.resize(newSize);
+  if (timed_) {
+    sentAt_.resize(newSize);
+  }
+  if (maxBytes_ != 0) {
+    sizes_.resize(newSize);
+  }
 }
 
 // freeTo frees the inflights smaller or equal to the given `to` flight.
 void 
 inflights::freeTo(uint64_t to) {
+  uint64_t bytes, sentAt;
+  freeTo(to, &bytes, &sentAt);
+}
+
+void 
+inflights::freeTo(uint64_t to, uint64_t *bytes, uint64_t *sentAt) {
+  *bytes = 0;
+  *sentAt = 0;
   if (count_ == 0 || to < buffer_[start_]) {
     return;
   }
@@ -211,6 +292,13 @@ inflights::freeTo(uint64_t to) {
     if (to < buffer_[idx]) {  // found the first large inflight
       break;
     }
+    if (maxBytes_ != 0) {
+      bytes_ -= sizes_[idx];
+      *bytes += sizes_[idx];
+    }
+    if (timed_) {
+      *sentAt = sentAt_[idx];
+    }
 
     // increase index and maybe rotate
     uint64_t size = size_;
@@ -235,15 +323,188 @@ inflights::freeFirstOne() {
   freeTo(buffer_[start_]);
 }
 
+// full returns true if no more message can be sent, either the number or
+// the bytes of the inflights reach the limit.
 bool 
 inflights::full() {
-  return count_ == size_;
+  return count_ >= limit_ || (maxBytes_ != 0 && bytes_ >= maxBytes_);
 }
 
 void 
 inflights::reset() {
   count_ = 0;
   start_ = 0;
+  bytes_ = 0;
+}
+
+void 
+inflights::reinit(int size, uint64_t maxBytes) {
+  reset();
+  size_ = size;
+  limit_ = size;
+  maxBytes_ = maxBytes;
+  buffer_.resize(size);
+  if (timed_) {
+    sentAt_.resize(size);
+  }
+  sizes_.resize(maxBytes_ != 0 ? size : 0);
+}
+
+void
+inflights::enableSentAt() {
+  timed_ = true;
+  sentAt_.resize(buffer_.size());
+}
+
+void
+flowControl::enable(uint32_t minWindow, uint32_t maxWindow, uint64_t minSize, uint64_t maxSize) {
+  enabled_ = true;
+  maxWindow_ = max(maxWindow, 1U);
+  minWindow_ = min(max(minWindow, 1U), maxWindow_);
+  maxSize_ = maxSize;
+  minSize_ = min(minSize, maxSize);
+  sizePerMsg_ = maxSize_;
+  restart();
+}
+
+void
+flowControl::restart() {
+  window_ = minWindow_;
+  slowStart_ = true;
+  roundStart_ = 0;
+}
+
+void
+flowControl::onAck(uint64_t sentAt, uint64_t now) {
+  if (now < sentAt) {
+    return;
+  }
+  uint64_t rtt = max(now - sentAt, (uint64_t)1);
+  srtt_ = (srtt_ == 0) ? rtt : (7 * srtt_ + rtt) / 8;
+  minRtt_ = (minRtt_ == 0) ? rtt : min(minRtt_, rtt);
+
+  if (roundStart_ == 0) {
+    roundStart_ = now;
+    return;
+  }
+  if (now - roundStart_ < srtt_) {
+    return;
+  }
+  roundStart_ = now;
+  adapt();
+}
+
+void
+flowControl::adapt() {
+  // the messages queued on the way are the window times the share of
+  // the round trip above the lowest one, excess is that times srtt_
+  uint64_t excess = (uint64_t)window_ * (srtt_ - minRtt_);
+  if (excess < srtt_) {
+    if (sizePerMsg_ < maxSize_) {
+      sizePerMsg_ = min(max(sizePerMsg_ * 2, (uint64_t)1), maxSize_);
+    } else if (slowStart_) {
+      window_ = min(window_ * 2, maxWindow_);
+    } else {
+      window_ = min(window_ + 1, maxWindow_);
+    }
+    return;
+  }
+
+  slowStart_ = false;
+  if (excess <= 3 * srtt_) {
+    return;
+  }
+  if (window_ > minWindow_) {
+    window_ = max(window_ * 3 / 4, minWindow_);
+  } else {
+    sizePerMsg_ = max(sizePerMsg_ / 2, minSize_);
+  }
+}
+
+void
+quorumTracker::add(Progress *pr) {
+  vector<uint64_t>::iterator iter = lower_bound(matches_.begin(), matches_.end(),
+                                                pr->match_, greater<uint64_t>());
+  matches_.insert(iter, pr->match_);
+  pr->tracker_ = this;
+  pr->trackedMatch_ = pr->match_;
+}
+
+void
+quorumTracker::remove(Progress *pr) {
+  if (pr == NULL || pr->tracker_ != this) {
+    return;
+  }
+  vector<uint64_t>::iterator iter = lower_bound(matches_.begin(), matches_.end(),
+                                                pr->trackedMatch_, greater<uint64_t>());
+  matches_.erase(iter);
+  pr->tracker_ = NULL;
+}
+
+void
+quorumTracker::clear() {
+  matches_.clear();
+}
+
+void
+quorumTracker::update(Progress *pr) {
+  uint64_t old = pr->trackedMatch_, match = pr->match_;
+  size_t i = lower_bound(matches_.begin(), matches_.end(), old, greater<uint64_t>()) - matches_.begin();
+  if (match > old) {
+    for (; i > 0 && matches_[i - 1] < match; --i) {
+      matches_[i] = matches_[i - 1];
+    }
+  } else {
+    for (; i + 1 < matches_.size() && matches_[i + 1] > match; ++i) {
+      matches_[i] = matches_[i + 1];
+    }
+  }
+  matches_[i] = match;
+  pr->trackedMatch_ = match;
+}
+
+Progress*
+progressTable::find(uint64_t id) {
+  vector<uint64_t>::iterator iter = lower_bound(ids_.begin(), ids_.end(), id);
+  if (iter == ids_.end() || *iter != id) {
+    return NULL;
+  }
+  return &progress_[iter - ids_.begin()];
+}
+
+bool
+progressTable::contains(uint64_t id) const {
+  return binary_search(ids_.begin(), ids_.end(), id);
+}
+
+Progress*
+progressTable::set(uint64_t id, uint64_t next, int maxInfilght, Logger *logger,
+                   uint64_t maxInflightBytes) {
+  vector<uint64_t>::iterator iter = lower_bound(ids_.begin(), ids_.end(), id);
+  size_t i = iter - ids_.begin();
+  if (iter != ids_.end() && *iter == id) {
+    progress_[i].reinit(next, maxInfilght, maxInflightBytes);
+    return &progress_[i];
+  }
+  ids_.insert(iter, id);
+  progress_.insert(progress_.begin() + i, Progress(next, maxInfilght, logger, maxInflightBytes));
+  return &progress_[i];
+}
+
+void
+progressTable::erase(uint64_t id) {
+  vector<uint64_t>::iterator iter = lower_bound(ids_.begin(), ids_.end(), id);
+  if (iter == ids_.end() || *iter != id) {
+    return;
+  }
+  progress_.erase(progress_.begin() + (iter - ids_.begin()));
+  ids_.erase(iter);
+}
+
+void
+progressTable::clear() {
+  ids_.clear();
+  progress_.clear();
 }
 
-}; // namespace libraft
\ No newline at end of file
+}; // namespace libraft
@@ -24,26 +24,136 @@ struct inflights {
   // inside one message.
   vector<uint64_t> buffer_;
 
+  // limit_ is the effective number of inflights allowed, no more than size_,
+  // it is lowered by the flow control of the Progress.
+  uint32_t limit_;
+
+  // sentAt_ contains the time the message at the same position of buffer_ is
+  // sent, in microseconds. It is only kept once timed_ is set by the flow
+  // control.
+  bool timed_;
+  vector<uint64_t> sentAt_;
+
+  // sizes_ contains the payload bytes of the message at the same position
+  // of buffer_, bytes_ is their sum and maxBytes_ its limit, 0 for no limit.
+  // They are only kept when there is a limit.
+  vector<uint64_t> sizes_;
+  uint64_t bytes_;
+  uint64_t maxBytes_;
+
   Logger* logger_;
 
-  void add(uint64_t infight);
+  void add(uint64_t infight, uint64_t bytes = 0, uint64_t sentAt = 0);
   void growBuf();
   void freeTo(uint64_t to);
+
+  // freeTo is like freeTo above, it returns the bytes freed and the time the
+  // last freed message was sent, 0 if none.
+  void freeTo(uint64_t to, uint64_t *bytes, uint64_t *sentAt);
   void freeFirstOne();
   bool full();
   void reset();
+  void reinit(int size, uint64_t maxBytes = 0);
+
+  // enableSentAt keeps the time the messages are sent from now on
+  void enableSentAt();
 
-  inflights(int size, Logger *logger)
+  inflights(int size, Logger *logger, uint64_t maxBytes = 0)
     : start_(0),
       count_(0),
       size_(size),
+      limit_(size),
+      timed_(false),
+      bytes_(0),
+      maxBytes_(maxBytes),
       logger_(logger) {
     buffer_.resize(size);
+    if (maxBytes_ != 0) {
+      sizes_.resize(size);
+    }
   }
   ~inflights() {
   }
 };
 
+struct Progress;
+
+// quorumTracker keeps the match indexes of the voters sorted in descending
+// order, so that the index replicated on a quorum is read in O(1). An update
+// finds the old index by binary search and moves it up past the smaller ones,
+// as match indexes only grow a few positions at a time.
+struct quorumTracker {
+  vector<uint64_t> matches_;
+
+  void add(Progress *pr);
+  void remove(Progress *pr);
+  void clear();
+  size_t size() const { return matches_.size(); }
+
+  // update moves the index of pr from the tracked one to its match index
+  void update(Progress *pr);
+
+  // quorumIndex returns the largest index replicated on quorum voters
+  uint64_t quorumIndex(size_t quorum) const {
+    return matches_[quorum - 1];
+  }
+};
+
+// flowControl adapts the inflight window of a follower to its link, see
+// Config.adaptiveInflight. It is a message based TCP Vegas: once per round trip
+// it estimates the messages queued on the way from the smoothed and the lowest
+// round trip time, the window grows while less than one is queued and shrinks
+// beyond three. The size of a message shrinks once the window is at its
+// minimum, and grows back before the window does.
+struct flowControl {
+  bool enabled_;
+
+  uint32_t minWindow_;
+  uint32_t maxWindow_;
+  uint64_t minSize_;
+  uint64_t maxSize_;
+
+  // the current window in messages and size of a message in bytes
+  uint32_t window_;
+  uint64_t sizePerMsg_;
+
+  // the window doubles each round trip in slow start
+  bool slowStart_;
+
+  // the lowest and the smoothed round trip time, in microseconds
+  uint64_t minRtt_;
+  uint64_t srtt_;
+
+  // the start of the current round
+  uint64_t roundStart_;
+
+  flowControl()
+    : enabled_(false),
+      minWindow_(0),
+      maxWindow_(0),
+      minSize_(0),
+      maxSize_(0),
+      window_(0),
+      sizePerMsg_(0),
+      slowStart_(true),
+      minRtt_(0),
+      srtt_(0),
+      roundStart_(0) {
+  }
+
+  void enable(uint32_t minWindow, uint32_t maxWindow, uint64_t minSize, uint64_t maxSize);
+
+  // restart starts over from the minimum window in slow start, keeping
+  // what is known about the round trip time.
+  void restart();
+
+  // onAck samples the round trip of a message sent at sentAt and acked at
+  // now, and adapts the window once per round trip.
+  void onAck(uint64_t sentAt, uint64_t now);
+
+  void adapt();
+};
+
 // State defines how the leader should interact with the follower.
 enum ProgressState {
   // When in ProgressStateProbe, leader sends at most one replication message
@@ -65,6 +175,7 @@ enum ProgressState {
 struct Progress {
   // for each follower,match_ is the highest log entry known to be replicated.
   // (initialized to 0, increases monotonically)
+  // It is only written by setMatch, which keeps the tracker in step.
   uint64_t match_;
   
   // for each follower, next_ is the next log entry known to be replicated.
@@ -90,11 +201,20 @@ struct Progress {
   // RecentActive can be reset to false after an election timeout.
   bool recentActive_;
 
+  // isLearner_ is true if the follower is a learner: it is replicated to
+  // but does not vote, and its match index does not count for the commit.
+  bool isLearner_;
+
+  // heartbeatAckedAt_ is the time the latest heartbeat acked by the follower
+  // was sent at, by the clock of the leader. It is only kept for the lease.
+  uint64_t heartbeatAckedAt_;
+
   // inflights is a sliding window for the inflight messages.
   // Each inflight message contains one or more log entries.
   // The max number of entries per message is defined in raft config as MaxSizePerMsg.
   // Thus inflight effectively limits both the number of inflight messages
   // and the bandwidth each Progress can use.
+  // The bytes of the entries in flight can be limited as well by MaxInflightBytes.
   // When inflights is full, no more message should be sent.
   // When a leader sends out a message, the index of the last
   // entry should be added to inflights. The index MUST be added
@@ -104,6 +224,15 @@ struct Progress {
   // received entry.
   inflights inflights_;
 
+  // tracker_ is the quorumTracker the match index is tracked by, and
+  // trackedMatch_ the index it knows for the progress.
+  quorumTracker* tracker_;
+  uint64_t trackedMatch_;
+
+  // flow_ adapts the effective window of inflights_ and the size of the
+  // messages if it is enabled.
+  flowControl flow_;
+
   Logger* logger_;
 
   const char* stateString();
@@ -111,12 +240,29 @@ struct Progress {
   // reset progress state and sliding window
   void resetState(ProgressState state);
 
+  // reinit resets the progress as if it were newly created, reusing
+  // the memory of the sliding window
+  void reinit(uint64_t next, int maxInfilght, uint64_t maxInflightBytes = 0);
+
+  // enableFlowControl enables the adaptive window, see flowControl.
+  void enableFlowControl(uint32_t minWindow, uint64_t minSize, uint64_t maxSize);
+
+  // sizePerMsg returns the max bytes of a message to the follower, size
+  // unless the flow control is enabled.
+  uint64_t sizePerMsg(uint64_t size);
+
+  // ackTo frees the inflights up to index to acked at now.
+  void ackTo(uint64_t to, uint64_t now);
+
+  // setMatch sets the match index and moves it in the tracker if any.
+  void setMatch(uint64_t match);
+
   void becomeProbe();
   void becomeReplicate();
   void becomeSnapshot(uint64_t snapshoti);
   bool maybeUpdate(uint64_t n);
   void optimisticUpdate(uint64_t n);
-  bool maybeDecrTo(uint64_t rejected, uint64_t last);
+  bool maybeDecrTo(uint64_t rejected, uint64_t matchHint);
   void snapshotFailure();
   void pause();
   void resume();
@@ -124,10 +270,38 @@ struct Progress {
   bool needSnapshotAbort();
   string String();
 
-  Progress(uint64_t next, int maxInfilght, Logger *logger);
+  Progress(uint64_t next, int maxInfilght, Logger *logger, uint64_t maxInflightBytes = 0);
   ~Progress();
 };
 
+// progressTable maps the peer ids to their progress. The ids are kept sorted
+// in a small vector and the progresses contiguously beside them, so walking
+// the peers does not chase a pointer per peer and a lookup is a binary search
+// over a few ids. A Progress pointer is valid until the next set or erase.
+struct progressTable {
+  vector<uint64_t> ids_;
+  vector<Progress> progress_;
+
+  size_t size() const { return ids_.size(); }
+  bool empty() const { return ids_.empty(); }
+
+  // id and at return the id and the progress of the i-th peer in id order
+  uint64_t id(size_t i) const { return ids_[i]; }
+  Progress* at(size_t i) { return &progress_[i]; }
+
+  // find returns the progress of id, NULL if id is not in the table
+  Progress* find(uint64_t id);
+  Progress* operator[](uint64_t id) { return find(id); }
+  bool contains(uint64_t id) const;
+
+  // set returns the progress of id as if it were newly created, it reuses
+  // the entry of id if there is one.
+  Progress* set(uint64_t id, uint64_t next, int maxInfilght, Logger *logger,
+                uint64_t maxInflightBytes = 0);
+  void erase(uint64_t id);
+  void clear();
+};
+
 }; // namespace libraft
 
 #endif  // __LIBRAFT_PROGRESS_H__
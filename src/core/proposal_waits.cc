@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include "core/proposal_waits.h"
+
+namespace libraft {
+
+void
+proposalWaits::add(uint64_t term, uint64_t index, const ProposeDone& done) {
+  proposalWait& wait = waits_[index];
+  if (wait.done_) {
+    // the entry at index has been overwritten before
+    wait.done_(ErrProposalDropped, wait.term_, index);
+  }
+  wait.term_ = term;
+  wait.done_ = done;
+}
+
+void
+proposalWaits::applied(const SharedEntryVec& entries) {
+  if (waits_.empty() || entries.empty()) {
+    return;
+  }
+  uint64_t first = entries.front()->index();
+  uint64_t last = entries.back()->index();
+  map<uint64_t, proposalWait>::iterator iter = waits_.begin();
+  while (iter != waits_.end() && iter->first <= last) {
+    uint64_t index = iter->first;
+    int err = ErrProposalDropped;
+    if (index >= first && entries[index - first]->term() == iter->second.term_) {
+      err = OK;
+    }
+    // the callback may add a proposal, copy it out before erasing
+    proposalWait wait = iter->second;
+    waits_.erase(iter++);
+    wait.done_(err, wait.term_, index);
+  }
+}
+
+void
+proposalWaits::abortAfter(uint64_t index, int err) {
+  map<uint64_t, proposalWait>::iterator iter = waits_.upper_bound(index);
+  while (iter != waits_.end()) {
+    proposalWait wait = iter->second;
+    uint64_t waitIndex = iter->first;
+    waits_.erase(iter++);
+    wait.done_(err, wait.term_, waitIndex);
+  }
+}
+
+}; // namespace libraft
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_PROPOSAL_WAITS_H__
+#define __LIBRAFT_PROPOSAL_WAITS_H__
+
+#include <map>
+#include "libraft.h"
+
+namespace libraft {
+
+// proposalWait is the callback of a proposal waiting for its entry
+struct proposalWait {
+  uint64_t term_;
+  ProposeDone done_;
+};
+
+// proposalWaits keeps the proposals waiting for their entries ordered by
+// index, so a proposal costs O(log n) to add and to resolve, and resolving
+// the proposals committed by a Ready only visits those proposals.
+class proposalWaits {
+public:
+  bool empty() const {
+    return waits_.empty();
+  }
+
+  size_t size() const {
+    return waits_.size();
+  }
+
+  void add(uint64_t term, uint64_t index, const ProposeDone& done);
+
+  // applied resolves the proposals of the committed entries,
+  // which are in index order without gaps.
+  void applied(const SharedEntryVec& entries);
+
+  // abortAfter fails the proposals after index with err
+  void abortAfter(uint64_t index, int err);
+
+private:
+  map<uint64_t, proposalWait> waits_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_PROPOSAL_WAITS_H__
@@ -8,6 +8,7 @@
 #include "base/util.h"
 #include "core/raft.h"
 #include "core/read_only.h"
+#include "base/default_clock.h"
 #include "base/default_logger.h"
 #include "storage/memory_storage.h"
 
@@ -54,23 +55,24 @@ entryString(const Entry& entry) {
 static void 
 copyEntries(const Message& msg, EntryVec *entries) {
   int i = 0;
+  entries->reserve(entries->size() + msg.entries_size());
   for (i = 0; i < msg.entries_size(); ++i) {
     entries->push_back(msg.entries(i));
   }
 }
 
-static Message*
-cloneMessage(const Message& msg) {
-  return new Message(msg);
-}
-
 raft::raft(const Config *config, raftLog *log)
   : id_(config->id),
     term_(0),
     vote_(0),
     raftLog_(log),
     maxInfilght_(config->maxInflightMsgs),
+    maxInflightBytes_(config->maxInflightBytes),
+    adaptiveInflight_(config->adaptiveInflight),
+    minInflight_(config->minInflightMsgs),
+    minMsgSize_(config->minSizePerMsg),
     maxMsgSize_(config->maxSizePerMsg),
+    arena_(NULL),
     leader_(kEmptyPeerId),
     leadTransferee_(kEmptyPeerId),
     readOnly_(new readOnly(config->readOnlyOption, config->logger)),
@@ -78,7 +80,13 @@ raft::raft(const Config *config, raftLog *log)
     electionTimeout_(config->electionTick),
     checkQuorum_(config->checkQuorum),
     preVote_(config->preVote),
+    quiesce_(config->quiesce),
+    quiescent_(false),
+    parallelAppend_(config->parallelAppend),
+    leaseTimeout_(config->leaseDuration > config->maxClockDrift ?
+                  config->leaseDuration - config->maxClockDrift : 0),
     logger_(config->logger),
+    clock_(config->clock),
     stateStepFunc_(NULL) {
   srand((unsigned)time(NULL));
 }
@@ -87,17 +95,17 @@ raft::~raft() {
   delete readOnly_;  
   delete raftLog_;
   uint32_t i;
-  for (i = 0; i < readStates_.size(); ++i) {
+  for (i = 0; arena_ == NULL && i < readStates_.size(); ++i) {
     delete readStates_[i];
   }
-  map<uint64_t, Progress*>::const_iterator iter = progressMap_.begin();
-  for (; iter != progressMap_.end(); ++iter) {
-    delete iter->second;
-  }
 }
 
 void
 raft::tick() {
+  if (quiescent_) {
+    return;
+  }
+
   switch (state_) {
   case StateFollower:
   case StateCandidate:
@@ -121,22 +129,49 @@ bool
 raft::checkQuorumActive() {
   int act = 0;
 
-  map<uint64_t, Progress*>::const_iterator iter;
-  for (iter = progressMap_.begin(); iter != progressMap_.end(); ++iter) {
-    if (iter->first == id_) { // self is always active
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.id(i) == id_) { // self is always active
       act++;
       continue;
     }
-    if (!iter->second->recentActive_) {
-      continue;
+    Progress *pr = progressMap_.at(i);
+    if (pr->recentActive_ && !pr->isLearner_) {
+      act++;
     }
-    act++;
-    iter->second->recentActive_ = false;     
+    pr->recentActive_ = false;
   }
 
   return act >= quorum();
 }
 
+// inLease returns true if a quorum of the voters acked heartbeats sent
+// less than leaseTimeout_ ago.
+bool
+raft::inLease() {
+  if (!checkQuorum_ || leaseTimeout_ == 0 || leadTransferee_ != kEmptyPeerId) {
+    // the transferee campaigns regardless of the lease
+    return false;
+  }
+  uint64_t now = clock_->Now();
+  leaseAcks_.clear();
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    Progress *pr = progressMap_.at(i);
+    if (pr->isLearner_) {
+      continue;
+    }
+    leaseAcks_.push_back(progressMap_.id(i) == id_ ? now : pr->heartbeatAckedAt_);
+  }
+  if (leaseAcks_.empty()) {
+    return false;
+  }
+  // the lease starts when the heartbeats acked by a quorum were sent
+  vector<uint64_t>::iterator nth = leaseAcks_.begin() + (quorum() - 1);
+  nth_element(leaseAcks_.begin(), nth, leaseAcks_.end(), greater<uint64_t>());
+  return *nth != 0 && now - *nth < leaseTimeout_;
+}
+
 bool
 raft::hasLeader() {
   return leader_ != kEmptyPeerId;
@@ -158,10 +193,22 @@ raft::hardState(HardState *hs) {
 void
 raft::nodes(vector<uint64_t> *nodes) {
   nodes->clear();
-  map<uint64_t, Progress*>::const_iterator iter = progressMap_.begin();
-  while (iter != progressMap_.end()) {
-    nodes->push_back(iter->first);
-    ++iter;
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (!progressMap_.at(i)->isLearner_) {
+      nodes->push_back(progressMap_.id(i));
+    }
+  }
+}
+
+void
+raft::learnerNodes(vector<uint64_t> *nodes) {
+  nodes->clear();
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.at(i)->isLearner_) {
+      nodes->push_back(progressMap_.id(i));
+    }
   }
 }
 
@@ -180,7 +227,7 @@ raft::loadState(const HardState &hs) {
 
 int
 raft::quorum() {
-  return (progressMap_.size() / 2) + 1;
+  return (tracker_.size() / 2) + 1;
 }
 
 // send persists state to stable storage and then sends to its mailbox.
@@ -208,6 +255,12 @@ raft::send(Message *msg) {
     }
   }
 
+  // a quiescent group sends nothing but the quiesce heartbeats and their
+  // responses, sending anything else means it is active again
+  if (quiescent_ && type != MsgHeartbeatResp && !isQuiesceHeartbeat(*msg)) {
+    wake();
+  }
+
   // save every out msg in outMsgs_,then msgs will be moved to `Ready' struct
   outMsgs_.push_back(msg);
 }
@@ -221,17 +274,17 @@ raft::sendAppend(uint64_t to) {
     return;
   }
 
-  Message *msg = new Message();
+  Message *msg = newMessage();
   msg->set_to(to);
 
   uint64_t term;
   int errt, erre, err;
-  EntryVec entries;
+  SharedEntryVec& entries = appendEntries_;
   Snapshot *snapshot;
 
   // try to get term and entities
   errt = raftLog_->term(pr->next_ - 1, &term);
-  erre = raftLog_->entries(pr->next_, maxMsgSize_, &entries);
+  erre = raftLog_->entries(pr->next_, pr->sizePerMsg(maxMsgSize_), &entries);
   if (!SUCCESS(errt) || !SUCCESS(erre)) {
     // send snapshot if we failed to get term or entries
     if (!pr->recentActive_) {
@@ -270,18 +323,27 @@ raft::sendAppend(uint64_t to) {
     msg->set_logterm(term);
     msg->set_commit(raftLog_->committed_);
     size_t i;
+    uint64_t bytes = 0;
+    msg->mutable_entries()->Reserve(entries.size());
     for (i = 0; i < entries.size(); ++i) {
-      Entry *entry = msg->add_entries();
-      entry->CopyFrom(entries[i]);
+      if (arena_ != NULL) {
+        // the message refers to the entry of the log instead of a copy, a
+        // reference in the arena keeps it alive until the arena is reset.
+        google::protobuf::Arena::Create<SharedEntry>(arena_, entries[i]);
+        msg->mutable_entries()->UnsafeArenaAddAllocated(const_cast<Entry*>(entries[i].get()));
+      } else {
+        msg->add_entries()->CopyFrom(*entries[i]);
+      }
+      bytes += entries[i]->data().size();
     }
     if (entries.size() > 0) {
       uint64_t last;
       switch (pr->state_) {
       // optimistically increase the next when in ProgressStateReplicate
       case ProgressStateReplicate:
-        last = entries[entries.size() - 1].index();
+        last = entries[entries.size() - 1]->index();
         pr->optimisticUpdate(last);
-        pr->inflights_.add(last);
+        pr->inflights_.add(last, bytes, pr->flow_.enabled_ ? clock_->Now() : 0);
         break;
       case ProgressStateProbe:
         pr->pause();
@@ -291,6 +353,8 @@ raft::sendAppend(uint64_t to) {
         break;
       }
     }
+    // do not hold the entries until the next call
+    entries.clear();
   }
 
   send(msg);
@@ -298,7 +362,7 @@ raft::sendAppend(uint64_t to) {
 
 // sendHeartbeat sends an empty MsgApp
 void
-raft::sendHeartbeat(uint64_t to, const string &ctx) {
+raft::sendHeartbeat(uint64_t to, const string &ctx, bool quiesce) {
   // Attach the commit as min(to.matched, r.committed).
   // When the leader sends out heartbeat message,
   // the receiver(follower) might not be matched with the leader
@@ -306,11 +370,17 @@ raft::sendHeartbeat(uint64_t to, const string &ctx) {
   // The leader MUST NOT forward the follower's commit to
   // an unmatched index.
   uint64_t commit = min(progressMap_[to]->match_, raftLog_->committed_);
-  Message *msg = new Message();
+  Message *msg = newMessage();
   msg->set_to(to);
   msg->set_type(MsgHeartbeat);
   msg->set_commit(commit);
   msg->set_context(ctx);
+  if (quiesce) {
+    msg->set_quiesce(true);
+  }
+  if (readOnly_->option_ == ReadOnlyLeaseBased && checkQuorum_ && leaseTimeout_ > 0) {
+    msg->set_leasesentat(clock_->Now());
+  }
   send(msg);
 }
 
@@ -318,52 +388,61 @@ raft::sendHeartbeat(uint64_t to, const string &ctx) {
 // according to the progress recorded in r.prs.
 void
 raft::bcastAppend() {
-  map<uint64_t, Progress*>::const_iterator iter = progressMap_.begin();
-  for (;iter != progressMap_.end();++iter) {
-    if (iter->first == id_) {
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.id(i) == id_) {
       continue;
     }
-    sendAppend(iter->first);
+    sendAppend(progressMap_.id(i));
   }
 }
 
 // bcastHeartbeat sends RPC, without entries to all the peers.
 void
 raft::bcastHeartbeat() {
-  string ctx = readOnly_->lastPendingRequestCtx();
+  string ctx;
+  if (readOnly_->hasUnsentRequest()) {
+    // a new round confirms the requests queued behind the one in flight too
+    ctx = readOnly_->nextRound();
+  } else {
+    ctx = readOnly_->lastRoundCtx();
+  }
   bcastHeartbeatWithCtx(ctx);
 }
 
 void
 raft::bcastHeartbeatWithCtx(const string &ctx) {
-  map<uint64_t, Progress*>::const_iterator iter = progressMap_.begin();
-  for (;iter != progressMap_.end();++iter) {
-    if (iter->first == id_) {
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.id(i) == id_) {
       continue;
     }
-    sendHeartbeat(iter->first, ctx);
+    sendHeartbeat(progressMap_.id(i), ctx, false);
   }
 }
 
-template <typename T>
-struct reverseCompartor {  
-  bool operator()(const T &x, const T &y)  {
-    return y < x;
-  }  
-};
-
 // maybeCommit attempts to advance the commit index. Returns true if
 // the commit index changed (in which case the caller should 
 // call r.bcastAppend).
 bool
 raft::maybeCommit() {
-  map<uint64_t, Progress*>::const_iterator iter;
-  vector<uint64_t> mis;
-  for (iter = progressMap_.begin(); iter != progressMap_.end(); ++iter) {
-    mis.push_back(iter->second->match_);
+  // there is no quorum to commit on once the last voter is removed,
+  // even if learners remain.
+  if (tracker_.size() == 0) {
+    return false;
+  }
+  return raftLog_->maybeCommit(tracker_.quorumIndex(quorum()), term_);
+}
+
+void
+raft::resetTracker() {
+  tracker_.clear();
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (!progressMap_.at(i)->isLearner_) {
+      tracker_.add(progressMap_.at(i));
+    }
   }
-  sort(mis.begin(), mis.end(), reverseCompartor<uint64_t>());
-  return raftLog_->maybeCommit(mis[quorum() - 1], term_);
 }
 
 void
@@ -380,20 +459,25 @@ raft::reset(uint64_t term) {
 
   abortLeaderTransfer();
   votes_.clear();
-  map<uint64_t, Progress*>::iterator iter = progressMap_.begin();
-  for (; iter != progressMap_.end(); ++iter) {
-    uint64_t id = iter->first;
-    Progress *pr = progressMap_[id];
-    delete pr;
-    progressMap_[id] = new Progress(raftLog_->lastIndex() + 1, maxInfilght_, logger_);
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    uint64_t id = progressMap_.id(i);
+    Progress *pr = progressMap_.at(i);
+    pr->reinit(raftLog_->lastIndex() + 1, maxInfilght_, maxInflightBytes_);
     if (id == id_) {
-      pr = progressMap_[id];
-      pr->match_ = raftLog_->lastIndex();
+      uint64_t match = raftLog_->lastIndex();
+      if (parallelAppend_) {
+        match = min(match, raftLog_->unstable_.offset_ - 1);
+      }
+      pr->setMatch(match);
     }
   }
+  resetTracker();
   pendingConf_ = false;
+  quiescent_ = false;
+  ReadOnlyOption option = readOnly_->option_;
   delete readOnly_;
-  readOnly_ = new readOnly(readOnly_->option_, logger_);
+  readOnly_ = new readOnly(option, logger_);
 }
 
 void
@@ -405,12 +489,61 @@ raft::appendEntry(EntryVec* entries) {
     (*entries)[i].set_term(term_);
     (*entries)[i].set_index(li + 1 + i);
   }
-  raftLog_->append(*entries);
-  progressMap_[id_]->maybeUpdate(raftLog_->lastIndex());
+  raftLog_->append(entries);
+  if (!parallelAppend_) {
+    progressMap_[id_]->maybeUpdate(raftLog_->lastIndex());
+  }
   // Regardless of maybeCommit's return, our caller will call bcastAppend.
   maybeCommit();
 }
 
+void
+raft::stableTo(uint64_t i, uint64_t t) {
+  bool match = raftLog_->matchTerm(i, t);
+  raftLog_->stableTo(i, t);
+  if (!parallelAppend_ || !match || state_ != StateLeader) {
+    return;
+  }
+  Progress *pr = progressMap_.find(id_);
+  if (pr != NULL && pr->maybeUpdate(i) && maybeCommit()) {
+    bcastAppend();
+  }
+}
+
+void
+raft::propose(EntryVec* entries) {
+  wake();
+  if (!progressMap_.contains(id_)) {
+    // If we are not currently a member of the range (i.e. this node
+    // was removed from the configuration while serving as leader),
+    // drop any new proposals.
+    return;
+  }
+  if (leadTransferee_ != kEmptyPeerId) {
+    logger_->Debugf(__FILE__, __LINE__,
+      "%x [term %d] transfer leadership to %x is in progress; dropping proposal",
+      id_, term_, leadTransferee_);
+    return;
+  }
+  size_t i;
+  for (i = 0; i < entries->size(); ++i) {
+    Entry *entry = &(*entries)[i];
+    if (entry->type() != EntryConfChange) {
+      continue;
+    }
+    if (pendingConf_) {
+      logger_->Infof(__FILE__, __LINE__, 
+        "propose conf %s ignored since pending unapplied configuration",
+        entryString(*entry).c_str());
+      entry->Clear();
+      entry->set_type(EntryNormal);
+    }
+    pendingConf_ = true;
+  }
+  appendEntry(entries);
+  bcastAppend();
+}
+
 // tickElection is run by followers and candidates after r.electionTimeout.
 void
 raft::tickElection() {
@@ -452,6 +585,9 @@ raft::tickHeartbeat() {
   // if heartbeat timeout,send MsgBeat
   if (heartbeatElapsed_ >= heartbeatTimeout_) {
     heartbeatElapsed_ = 0;
+    if (maybeQuiesce()) {
+      return;
+    }
 
     Message msg;
     msg.set_from(id_);
@@ -460,11 +596,94 @@ raft::tickHeartbeat() {
   }
 }
 
+int
+raft::ticksToDeadline() {
+  int ticks;
+  if (state_ == StateLeader) {
+    ticks = min(heartbeatTimeout_ - heartbeatElapsed_, electionTimeout_ - electionElapsed_);
+  } else {
+    ticks = randomizedElectionTimeout_ - electionElapsed_;
+  }
+  return ticks > 1 ? ticks : 1;
+}
+
+void
+raft::skipTicks(int n) {
+  if (quiescent_) {
+    return;
+  }
+  // never skip the tick at the deadline
+  n = min(n, ticksToDeadline() - 1);
+  if (n <= 0) {
+    return;
+  }
+  electionElapsed_ += n;
+  if (state_ == StateLeader) {
+    heartbeatElapsed_ += n;
+  }
+}
+
+bool
+raft::canQuiesce() {
+  if (state_ != StateLeader || leadTransferee_ != kEmptyPeerId || pendingConf_) {
+    return false;
+  }
+  if (readOnly_->pending() != 0) {
+    return false;
+  }
+  uint64_t lastIndex = raftLog_->lastIndex();
+  if (raftLog_->committed_ != lastIndex) {
+    return false;
+  }
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.at(i)->match_ != lastIndex) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+raft::maybeQuiesce() {
+  if (!quiesce_ || quiescent_ || !canQuiesce()) {
+    return false;
+  }
+
+  logger_->Debugf(__FILE__, __LINE__, "%x quiesces at term %llu, index %llu",
+    id_, term_, raftLog_->lastIndex());
+  quiescent_ = true;
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    if (progressMap_.id(i) == id_) {
+      continue;
+    }
+    sendHeartbeat(progressMap_.id(i), "", true);
+  }
+  return true;
+}
+
+void
+raft::wake() {
+  if (!quiescent_) {
+    return;
+  }
+  logger_->Debugf(__FILE__, __LINE__, "%x wakes up at term %llu", id_, term_);
+  quiescent_ = false;
+}
+
 // promotable indicates whether state machine can be promoted to leader,
 // which is true when its own id is in progress list.
 bool
 raft::promotable() {
-  return progressMap_.find(id_) != progressMap_.end();
+  Progress *pr = progressMap_.find(id_);
+  return pr != NULL && !pr->isLearner_;
+}
+
+bool
+raft::isLearner() {
+  Progress *pr = progressMap_.find(id_);
+  return pr != NULL && pr->isLearner_;
 }
 
 // pastElectionTimeout returns true if r.electionElapsed is greater
@@ -528,14 +747,14 @@ raft::becomeLeader() {
   state_ = StateLeader;
   stateStepFunc_ = stepLeader;
 
-  EntryVec entries;
-  int err = raftLog_->entries(raftLog_->committed_ + 1, kNoLimit, &entries);
+  SharedEntryVec uncommitted;
+  int err = raftLog_->entries(raftLog_->committed_ + 1, kNoLimit, &uncommitted);
   // fatal if leader get committed entries fail
   if (!SUCCESS(err)) {
     logger_->Fatalf(__FILE__, __LINE__, "unexpected error getting uncommitted entries (%s)", kErrString[err]);
   }
 
-  int n = numOfPendingConf(entries);
+  int n = numOfPendingConf(uncommitted);
   // fatal if leader has pending config > 1
   if (n > 1) {
     logger_->Fatalf(__FILE__, __LINE__, "unexpected multiple uncommitted config entry");
@@ -544,8 +763,8 @@ raft::becomeLeader() {
   if (n == 1) {
     pendingConf_ = true;
   }
-  entries.clear();
-  entries.push_back(Entry());
+  EntryVec entries(1);
+  entries[0].set_type(EntryNormal);
   appendEntry(&entries);
   logger_->Infof(__FILE__, __LINE__, "%x became leader at term %llu", id_, term_);
 }
@@ -576,10 +795,10 @@ raft::campaign(CampaignType t) {
     }
   }
 
-  map<uint64_t, Progress*>::const_iterator iter = progressMap_.begin();
-  for (; iter != progressMap_.end(); ++iter) {
-    uint64_t id = iter->first;
-    if (id_ == id) {
+  size_t i;
+  for (i = 0; i < progressMap_.size(); ++i) {
+    uint64_t id = progressMap_.id(i);
+    if (id_ == id || progressMap_.at(i)->isLearner_) {
       continue;
     }
     logger_->Infof(__FILE__, __LINE__, "%x [logterm: %llu, index: %llu] sent %s request to %x at term %llu",
@@ -588,7 +807,7 @@ raft::campaign(CampaignType t) {
     if (t == CampaignTransfer) {
       ctx = kCampaignString[CampaignTransfer];
     }
-    Message *msg = new Message();
+    Message *msg = newMessage();
     msg->set_term(term);
     msg->set_to(id);
     msg->set_type(voteMsg);
@@ -624,6 +843,10 @@ raft::step(const Message& msg) {
   logger_->Debugf(__FILE__, __LINE__, "msg %s %llu -> %llu, term:%llu",
                   kMsgString[msg.type()], msg.from(), msg.to(), term_);
 
+  if (quiescent_ && msg.type() != MsgHeartbeatResp && !isQuiesceHeartbeat(msg)) {
+    wake();
+  }
+
   // Handle the message term, which may result in our stepping down to a follower.
   Message *respMsg;
   uint64_t term = msg.term();
@@ -675,7 +898,7 @@ raft::step(const Message& msg) {
       // removed node will send MsgVotes (or MsgPreVotes) which will be ignored,
       // but it will not receive MsgApp or MsgHeartbeat, so it will not create
       // disruptive term increases
-      respMsg = new Message();
+      respMsg = newMessage();
       respMsg->set_to(from);
       respMsg->set_type(MsgAppResp);
       send(respMsg);
@@ -687,12 +910,16 @@ raft::step(const Message& msg) {
     return OK;
   }
 
-  EntryVec entries;
+  SharedEntryVec entries;
   int err;
   int n;
 
   switch (type) {
   case MsgHup:
+    if (isLearner()) {
+      logger_->Warningf(__FILE__, __LINE__, "%x is a learner and can not campaign at term %llu", id_, term_);
+      return OK;
+    }
     if (state_ != StateLeader) {
       err = raftLog_->slice(raftLog_->applied_ + 1, raftLog_->committed_ + 1, kNoLimit, &entries);
       if (!SUCCESS(err)) {
@@ -721,7 +948,7 @@ raft::step(const Message& msg) {
     if ((vote_ == kEmptyPeerId || term > term_ || vote_ == from) && raftLog_->isUpToDate(msg.index(), msg.logterm())) {
       logger_->Infof(__FILE__, __LINE__, "%x [logterm: %llu, index: %llu, vote: %x] cast %s for %x [logterm: %llu, index: %llu] at term %llu",
         id_, raftLog_->lastTerm(), raftLog_->lastIndex(), vote_, kMsgString[type], from, msg.logterm(), msg.index(), term_);
-      respMsg = new Message();
+      respMsg = newMessage();
       respMsg->set_to(from);      
       respMsg->set_type(voteRespMsgType(type));
       send(respMsg);
@@ -733,7 +960,7 @@ raft::step(const Message& msg) {
       logger_->Infof(__FILE__, __LINE__,
         "%x [logterm: %llu, index: %llu, vote: %x] rejected %s from %x [logterm: %llu, index: %llu] at term %llu",
         id_, raftLog_->lastTerm(), raftLog_->lastIndex(), vote_, kMsgString[type], from, msg.logterm(), msg.index(), term_);
-      respMsg = new Message();
+      respMsg = newMessage();
       respMsg->set_to(from);      
       respMsg->set_reject(true);      
       respMsg->set_type(voteRespMsgType(type));
@@ -776,38 +1003,8 @@ stepLeader(raft *r, const Message& msg) {
     if (msg.entries_size() == 0) {  // received a empty entries MsgProp
       logger->Fatalf(__FILE__, __LINE__, "%x stepped empty MsgProp", r->id_);
     }
-    if (r->progressMap_.find(r->id_) == r->progressMap_.end()) {
-      // If we are not currently a member of the range (i.e. this node
-      // was removed from the configuration while serving as leader),
-      // drop any new proposals.
-      return;
-    }
-    if (r->leadTransferee_ != kEmptyPeerId) {
-      logger->Debugf(__FILE__, __LINE__,
-        "%x [term %d] transfer leadership to %x is in progress; dropping proposal",
-        r->id_, r->term_, r->leadTransferee_);
-      return;
-    }
-    n = cloneMessage(msg);
-    for (i = 0; (int)i < n->entries_size(); ++i) {
-      Entry *entry = n->mutable_entries(i);
-      if (entry->type() != EntryConfChange) {
-        continue;
-      }
-      if (r->pendingConf_) {
-        logger->Infof(__FILE__, __LINE__, 
-          "propose conf %s ignored since pending unapplied configuration",
-          entryString(*entry).c_str());
-        Entry tmp;
-        tmp.set_type(EntryNormal);
-        entry->CopyFrom(tmp);
-      }
-      r->pendingConf_ = true;
-    }
-    copyEntries(*n, &entries);
-    r->appendEntry(&entries);
-    r->bcastAppend();
-    delete n;
+    copyEntries(msg, &entries);
+    r->propose(&entries);
     return;
     break;
   case MsgReadIndex:
@@ -817,31 +1014,29 @@ stepLeader(raft *r, const Message& msg) {
         // Reject read only request when this leader has not committed any log entry at its term.
         return;
       }
-      // thinking: use an interally defined context instead of the user given context.
-      // We can express this in terms of the term and index instead of a user-supplied value.
-      // This would allow multiple reads to piggyback on the same message.
-      if (r->readOnly_->option_ == ReadOnlySafe) {
-        n = cloneMessage(msg);
-        r->readOnly_->addRequest(r->raftLog_->committed_, n);
-        r->bcastHeartbeatWithCtx(n->entries(0).data());
-        return;
-      } else if (r->readOnly_->option_ == ReadOnlyLeaseBased) {
-        ri = 0;
-        if (r->checkQuorum_) {
-          ri = r->raftLog_->committed_;
-        }
+      if (r->readOnly_->option_ == ReadOnlyLeaseBased && r->inLease()) {
+        ri = r->raftLog_->committed_;
         if (msg.from() == kEmptyPeerId || msg.from() == r->id_) { // from local member
-          r->readStates_.push_back(new ReadState(r->raftLog_->committed_, msg.entries(0).data())); 
+          r->readStates_.push_back(r->newReadState(ri, msg.entries(0).data()));
         } else {
-          n = cloneMessage(msg);
+          n = r->cloneMessage(msg);
           n->set_to(msg.from());
           n->set_type(MsgReadIndexResp);
           n->set_index(ri);
           r->send(n);
         }
+        return;
+      }
+      // ReadOnlySafe, or ReadOnlyLeaseBased without the lease.
+      // the request is kept until the read is acked, beyond the current Ready.
+      // While a round is in flight the request waits for the next one, which
+      // starts once it is acked, so the requests share the heartbeats.
+      r->readOnly_->addRequest(r->raftLog_->committed_, msg);
+      if (!r->readOnly_->roundInFlight()) {
+        r->bcastHeartbeatWithCtx(r->readOnly_->nextRound());
       }
     } else {
-     r->readStates_.push_back(new ReadState(r->raftLog_->committed_, msg.entries(0).data())); 
+     r->readStates_.push_back(r->newReadState(r->raftLog_->committed_, msg.entries(0).data())); 
     }
     return;
     break;
@@ -851,24 +1046,33 @@ stepLeader(raft *r, const Message& msg) {
   Progress *pr;
   uint64_t from = msg.from();
   uint64_t index = msg.index();
+  uint64_t nextProbeIdx;
   bool oldPaused;
   vector<readIndexStatus*> rss;
-  Message *req, *respMsg;
-  map<uint64_t, Progress*>::iterator iter = r->progressMap_.find(from);
-  if (iter == r->progressMap_.end()) {
+  const Message *req;
+  Message *respMsg;
+  pr = r->progressMap_.find(from);
+  if (pr == NULL) {
     logger->Debugf(__FILE__, __LINE__, "%x no progress available for %x", r->id_, from);
     return;
   }
-  pr = iter->second;
   int ackCnt;
 
   switch (type) {
   case MsgAppResp:
     pr->recentActive_ = true;
     if (msg.reject()) {
-      logger->Debugf(__FILE__, __LINE__, "%x received msgApp rejection(lastindex: %llu) from %x for index %llu",
-        r->id_, msg.rejecthint(), from, index);
-      if (pr->maybeDecrTo(index, msg.rejecthint())) {
+      logger->Debugf(__FILE__, __LINE__, "%x received msgApp rejection(hint: %llu, hint term: %llu) from %x for index %llu",
+        r->id_, msg.rejecthint(), msg.logterm(), from, index);
+      // the follower has no entry matching the leader log after the hint
+      // index, and the leader has none of a term larger than the hint term
+      // matching the follower log, so the probe skips both, which costs
+      // one round trip per term in conflict instead of one per entry.
+      nextProbeIdx = msg.rejecthint();
+      if (msg.logterm() > 0) {
+        nextProbeIdx = r->raftLog_->findConflictByTerm(msg.rejecthint(), msg.logterm());
+      }
+      if (pr->maybeDecrTo(index, nextProbeIdx)) {
         logger->Debugf(__FILE__, __LINE__, "%x decreased progress of %x to [%s]",
           r->id_, from, pr->String().c_str());
         if (pr->state_ == ProgressStateReplicate) {
@@ -886,7 +1090,7 @@ stepLeader(raft *r, const Message& msg) {
             r->id_, from, pr->String().c_str());
           pr->becomeProbe();
         } else if (pr->state_ == ProgressStateReplicate) {
-          pr->inflights_.freeTo(index);
+          pr->ackTo(index, pr->flow_.enabled_ ? r->clock_->Now() : 0);
         }
         if (r->maybeCommit()) {
           r->bcastAppend();
@@ -916,7 +1120,12 @@ stepLeader(raft *r, const Message& msg) {
       r->sendAppend(from);
     }
 
-    if (r->readOnly_->option_ != ReadOnlySafe || msg.context().empty()) {
+    if (msg.leasesentat() > pr->heartbeatAckedAt_) {
+      pr->heartbeatAckedAt_ = msg.leasesentat();
+    }
+
+    // the acks of the learners do not count for the quorum
+    if (msg.context().empty() || pr->isLearner_) {
       return;
     }
 
@@ -926,18 +1135,21 @@ stepLeader(raft *r, const Message& msg) {
     }
     r->readOnly_->advance(msg, &rss);
     for (i = 0; i < rss.size(); ++i) {
-      req = rss[i]->req_;
+      req = &rss[i]->req_;
       if (req->from() == kEmptyPeerId || req->from() == r->id_) {
-        r->readStates_.push_back(new ReadState(rss[i]->index_, req->entries(0).data()));
+        r->readStates_.push_back(r->newReadState(rss[i]->index_, req->entries(0).data()));
       } else {
-        respMsg = new Message();
+        respMsg = r->newMessage();
         respMsg->set_type(MsgReadIndexResp); 
         respMsg->set_to(req->from()); 
         respMsg->set_index(rss[i]->index_);
         respMsg->mutable_entries()->CopyFrom(req->entries());
         r->send(respMsg);
       }
-    } 
+    }
+    if (r->readOnly_->hasUnsentRequest()) {
+      r->bcastHeartbeatWithCtx(r->readOnly_->nextRound());
+    }
     break;
   case MsgSnapStatus:
     if (pr->state_ != ProgressStateSnapshot) {
@@ -968,6 +1180,10 @@ stepLeader(raft *r, const Message& msg) {
       r->id_, msg.from(), pr->String().c_str());
     break;
   case MsgTransferLeader:
+    if (pr->isLearner_) {
+      logger->Debugf(__FILE__, __LINE__, "%x is learner. Ignored transferring leadership", r->id_);
+      return;
+    }
     leadTransferee = msg.from();
     lastLeadTransferee = r->leadTransferee_;
     if (lastLeadTransferee != kEmptyPeerId) {
@@ -1072,7 +1288,7 @@ stepFollower(raft* r, const Message& msg) {
     if (r->leader_ == kEmptyPeerId) {
       return;
     }
-    n = cloneMessage(msg);
+    n = r->cloneMessage(msg);
     n->set_to(r->leader_);
     r->send(n);
     break;
@@ -1098,7 +1314,7 @@ stepFollower(raft* r, const Message& msg) {
         r->id_, r->term_);
       return;
     }
-    n = cloneMessage(msg);
+    n = r->cloneMessage(msg);
     n->set_to(r->leader_);
     r->send(n);
     break;
@@ -1122,7 +1338,7 @@ stepFollower(raft* r, const Message& msg) {
       logger->Infof(__FILE__, __LINE__, "%x no leader at term %llu; dropping index reading msg", r->id_, r->term_);
       return;
     }
-    n = cloneMessage(msg);
+    n = r->cloneMessage(msg);
     n->set_to(r->leader_);
     r->send(n);
     break;
@@ -1132,7 +1348,7 @@ stepFollower(raft* r, const Message& msg) {
         r->id_, msg.from(), msg.entries_size());
       return;
     }
-    r->readStates_.push_back(new ReadState(msg.index(), msg.entries(0).data()));
+    r->readStates_.push_back(r->newReadState(msg.index(), msg.entries(0).data()));
     break;
   }
 }
@@ -1163,16 +1379,19 @@ raft::restore(const Snapshot& snapshot) {
 
   raftLog_->restore(snapshot);
   progressMap_.clear();
+  tracker_.clear();
   int i;
   // restore node progress
-  for (i = 0; i < snapshot.metadata().conf_state().nodes_size(); ++i) {
-    uint64_t node = snapshot.metadata().conf_state().nodes(i);
+  const ConfState& cs = snapshot.metadata().conf_state();
+  for (i = 0; i < cs.nodes_size() + cs.learners_size(); ++i) {
+    bool isLearner = (i >= cs.nodes_size());
+    uint64_t node = isLearner ? cs.learners(i - cs.nodes_size()) : cs.nodes(i);
     uint64_t match = 0;
     uint64_t next = raftLog_->lastIndex() + 1; 
     if (node == id_) {
       match = next - 1;
     }
-    setProgress(node, match, next);
+    setProgress(node, match, next, isLearner);
     logger_->Infof(__FILE__, __LINE__, "%x restored progress of %x [%s]", id_, node, progressMap_[node]->String().c_str());
   }
   return true;
@@ -1182,7 +1401,7 @@ void
 raft::handleSnapshot(const Message& msg) {
   uint64_t sindex = msg.snapshot().metadata().index();
   uint64_t sterm  = msg.snapshot().metadata().term();
-  Message *resp = new Message;
+  Message *resp = newMessage();
 
   resp->set_to(msg.from());
   resp->set_type(MsgAppResp);
@@ -1204,18 +1423,27 @@ void
 raft::handleHeartbeat(const Message& msg) {
   // commit the msg commit index
   raftLog_->commitTo(msg.commit());
-  Message *resp = new Message();
+  Message *resp = newMessage();
   resp->set_to(msg.from());
   resp->set_type(MsgHeartbeatResp);
   resp->set_context(msg.context());
+  if (msg.leasesentat() != 0) {
+    resp->set_leasesentat(msg.leasesentat());
+  }
   send(resp);
+
+  // the leader has quiesced, only follow it if this log has caught up,
+  // otherwise keep ticking so as to elect a new leader if need be.
+  if (isQuiesceHeartbeat(msg) && raftLog_->lastIndex() == msg.commit()) {
+    quiescent_ = true;
+  }
 }
 
 void
 raft::handleAppendEntries(const Message& msg) {
   // is msg already outdated?
   if (msg.index() < raftLog_->committed_) {
-    Message *resp = new Message();
+    Message *resp = newMessage();
     resp->set_to(msg.from());
     resp->set_type(MsgAppResp);
     resp->set_index(raftLog_->committed_);
@@ -1229,7 +1457,7 @@ raft::handleAppendEntries(const Message& msg) {
   // check if msg append success?
   bool ret = raftLog_->maybeAppend(msg.index(), msg.logterm(), msg.commit(), entries, &lasti);
   if (ret) {
-    Message *resp = new Message();
+    Message *resp = newMessage();
     resp->set_to(msg.from());
     resp->set_type(MsgAppResp);
     resp->set_index(lasti);
@@ -1240,28 +1468,40 @@ raft::handleAppendEntries(const Message& msg) {
     logger_->Debugf(__FILE__, __LINE__,
       "%x [logterm: %llu, index: %llu] rejected msgApp [logterm: %llu, index: %llu] from %x",
       id_, raftLog_->zeroTermOnErrCompacted(term, err), msg.index(), msg.logterm(), msg.index(), msg.from());
-    Message *resp = new Message();
+    Message *resp = newMessage();
     resp->set_to(msg.from());
     resp->set_type(MsgAppResp);
     resp->set_index(msg.index());
     resp->set_reject(true);
-    resp->set_rejecthint(raftLog_->lastIndex());
+    // hint the leader with the last index whose term is not larger than
+    // msg.logterm(), along with its term, so that the leader can skip all
+    // the entries of a conflicting term in one round trip, see stepLeader.
+    uint64_t hintIndex = min(msg.index(), raftLog_->lastIndex());
+    hintIndex = raftLog_->findConflictByTerm(hintIndex, msg.logterm());
+    err = raftLog_->term(hintIndex, &term);
+    resp->set_rejecthint(hintIndex);
+    resp->set_logterm(raftLog_->zeroTermOnErrCompacted(term, err));
     send(resp);
   }
 }
 
 void
-raft::setProgress(uint64_t id, uint64_t match, uint64_t next) {
-  if (progressMap_[id] != NULL)  {
-    delete progressMap_[id];
+raft::setProgress(uint64_t id, uint64_t match, uint64_t next, bool isLearner) {
+  tracker_.remove(progressMap_.find(id));
+  Progress *pr = progressMap_.set(id, next, maxInfilght_, logger_, maxInflightBytes_);
+  if (adaptiveInflight_) {
+    pr->enableFlowControl(minInflight_, minMsgSize_, maxMsgSize_);
+  }
+  pr->setMatch(match);
+  pr->isLearner_ = isLearner;
+  if (!isLearner) {
+    tracker_.add(pr);
   }
-  progressMap_[id] = new Progress(next, maxInfilght_, logger_);
-  progressMap_[id]->match_ = match;
 }
 
 void
 raft::delProgress(uint64_t id) {
-  delete progressMap_[id];
+  tracker_.remove(progressMap_.find(id));
   progressMap_.erase(id);
 }
 
@@ -1272,11 +1512,38 @@ raft::abortLeaderTransfer() {
 
 void
 raft::addNode(uint64_t id) {
+  addNodeOrLearnerNode(id, false);
+}
+
+void
+raft::addLearner(uint64_t id) {
+  addNodeOrLearnerNode(id, true);
+}
+
+void
+raft::addNodeOrLearnerNode(uint64_t id, bool isLearner) {
   pendingConf_ = false;
-  if (progressMap_.find(id) != progressMap_.end()) {
+  Progress *pr = progressMap_.find(id);
+  if (pr == NULL) {
+    setProgress(id, 0, raftLog_->lastIndex() + 1, isLearner);
     return;
   }
-  setProgress(id, 0, raftLog_->lastIndex() + 1);
+  if (isLearner && !pr->isLearner_) {
+    // can only change Learner to Voter
+    logger_->Infof(__FILE__, __LINE__,
+      "%x ignored addLearner: do not support changing %x from raft peer to learner.", id_, id);
+    return;
+  }
+  if (isLearner == pr->isLearner_) {
+    // Ignore any redundant addNode calls (which can happen because the
+    // initial bootstrapping entries are applied twice).
+    return;
+  }
+
+  // change Learner to Voter, keeping the progress it made as a learner
+  pr->isLearner_ = false;
+  tracker_.add(pr);
+  logger_->Infof(__FILE__, __LINE__, "%x promoted learner %x to voter [%s]", id_, id, pr->String().c_str());
 }
 
 void
@@ -1307,9 +1574,26 @@ raft::readMessages(MessageVec *msgs) {
   outMsgs_.clear();
 }
 
+Message*
+raft::newMessage() {
+  return google::protobuf::Arena::CreateMessage<Message>(arena_);
+}
+
+Message*
+raft::cloneMessage(const Message& msg) {
+  Message *n = newMessage();
+  n->CopyFrom(msg);
+  return n;
+}
+
+ReadState*
+raft::newReadState(uint64_t index, const string &ctx) {
+  return google::protobuf::Arena::Create<ReadState>(arena_, index, ctx);
+}
+
 void
 raft::sendTimeoutNow(uint64_t to) {
-  Message *msg = new Message();
+  Message *msg = newMessage();
   msg->set_to(to);
   msg->set_type(MsgTimeoutNow);
   send(msg);
@@ -1338,10 +1622,17 @@ validateConfig(Config *config) {
     printf("[FATAL] max inflight messages must be greater than 0\n");
     return -1;
   }
+  if (config->leaseDuration > 0 && config->maxClockDrift >= config->leaseDuration) {
+    printf("[FATAL] max clock drift must be less than lease duration\n");
+    return -1;
+  }
   if (config->logger == NULL) {
     config->logger = new DefaultLogger();
     printf("[WANR] logger is NULL, use DefaultLogger by default\n");
   }
+  if (config->clock == NULL) {
+    config->clock = &kDefaultClock;
+  }
   if (config->storage == NULL) {
     config->storage = new MemoryStorage(config->logger);
     printf("[WANR] storage is NULL, use MemoryStorage by default\n");
@@ -1360,6 +1651,7 @@ newRaft(Config *config) {
   ConfState cs;
   Logger *logger = config->logger;
   vector<uint64_t> peers = config->peers;
+  vector<uint64_t> learners = config->learners;
   int err;
   size_t i;
   
@@ -1369,20 +1661,24 @@ newRaft(Config *config) {
     logger->Fatalf(__FILE__, __LINE__, "storage InitialState fail: %s", kErrString[err]); 
   }
 
-  if (cs.nodes_size() > 0) {
-    if (peers.size() > 0) {
-      logger->Fatalf(__FILE__, __LINE__, "cannot specify both newRaft(peers) and ConfState.Nodes)");
-    }
-    peers.clear();
-    for (i = 0; (int)i < cs.nodes_size(); ++i) {
-      peers.push_back(cs.nodes(i));
+  if (cs.nodes_size() > 0 || cs.learners_size() > 0) {
+    if (peers.size() > 0 || learners.size() > 0) {
+      logger->Fatalf(__FILE__, __LINE__, "cannot specify both newRaft(peers, learners) and ConfState.(Nodes, Learners))");
     }
+    peers.assign(cs.nodes().begin(), cs.nodes().end());
+    learners.assign(cs.learners().begin(), cs.learners().end());
   }
 
   // init the progressMap_
   raft *r = new raft(config, rl);
   for (i = 0; i < peers.size(); ++i) {
-    r->progressMap_[peers[i]] = new Progress(1, r->maxInfilght_, logger);
+    r->setProgress(peers[i], 0, 1);
+  }
+  for (i = 0; i < learners.size(); ++i) {
+    if (r->progressMap_.contains(learners[i])) {
+      logger->Fatalf(__FILE__, __LINE__, "node %x is in both learner and peer list", learners[i]);
+    }
+    r->setProgress(learners[i], 0, 1, true);
   }
 
   // load hardState if needed.
@@ -1397,10 +1693,9 @@ newRaft(Config *config) {
   r->becomeFollower(r->term_, kEmptyPeerId);
 
   vector<string> peerStrs;
-  map<uint64_t, Progress*>::const_iterator iter;
   char tmp[32];
-  for (iter = r->progressMap_.begin(); iter != r->progressMap_.end(); ++iter) {
-    snprintf(tmp, sizeof(tmp), "%llu", iter->first);
+  for (i = 0; i < r->progressMap_.size(); ++i) {
+    snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)r->progressMap_.id(i));
     peerStrs.push_back(tmp);
   }
   string nodeStr = joinStrings(peerStrs, ",");
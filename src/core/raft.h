@@ -41,10 +41,22 @@ struct raft {
   vector<ReadState*> readStates_;
   raftLog *raftLog_;
   int maxInfilght_;
+  uint64_t maxInflightBytes_;
+
+  // the bounds of the adaptive window of the followers, see Config.adaptiveInflight
+  bool adaptiveInflight_;
+  uint32_t minInflight_;
+  uint64_t minMsgSize_;
   uint64_t maxMsgSize_;
 
-  // cluster node Progress Map
-  map<uint64_t, Progress*> progressMap_;
+  // the Progress of the cluster nodes, ordered by id
+  progressTable progressMap_;
+
+  // tracker_ tracks the match indexes of progressMap_ for maybeCommit
+  quorumTracker tracker_;
+
+  // scratch buffer reused across calls of sendAppend
+  SharedEntryVec appendEntries_;
   
   StateType state_;
   map<uint64_t, bool> votes_;
@@ -52,6 +64,10 @@ struct raft {
   // save every outbound msg in outMsgs_,then msgs will be moved to `Ready' struct
   MessageVec outMsgs_;
 
+  // outMsgs_ and readStates_ are allocated from arena_ and released all at once
+  // when the Ready they are moved to is advanced. NULL means allocate on the heap.
+  google::protobuf::Arena *arena_;
+
   // current leader id, default is kEmptyPeerId.
   uint64_t leader_;
 
@@ -83,6 +99,24 @@ struct raft {
   bool checkQuorum_;
   bool preVote_;
 
+  // quiesce_ enables quiescing the group when it is idle, quiescent_ is true
+  // when the group has quiesced, it does not tick until it is woken up.
+  // A quiesce heartbeat is a MsgHeartbeat with quiesce set.
+  bool quiesce_;
+  bool quiescent_;
+
+  // when parallelAppend_ is set the progress of the leader itself only
+  // matches its stable entries, see Config.parallelAppend.
+  bool parallelAppend_;
+
+  // leaseTimeout_ is Config.leaseDuration less Config.maxClockDrift, the
+  // leader holds no lease if it is 0. A heartbeat sent for the lease carries
+  // the time it is sent at in leaseSentAt, and the MsgHeartbeatResp echoes it.
+  uint64_t leaseTimeout_;
+
+  // scratch buffer reused across calls of inLease
+  vector<uint64_t> leaseAcks_;
+
   // randomizedElectionTimeout is a random number between
   // [electiontimeout, 2 * electiontimeout - 1]. It gets reset
   // when raft changes its state to follower or candidate.
@@ -90,6 +124,9 @@ struct raft {
 
   Logger* logger_;
 
+  // clock_ measures the round trips of the followers and the lease
+  Clock* clock_;
+
   // current role state machine function
   stepFun stateStepFunc_;
 
@@ -103,9 +140,12 @@ struct raft {
   // load HardState in hs
   void loadState(const HardState &hs);
 
-  // return current cluster node id in nodes
+  // return current cluster voter node id in nodes
   void nodes(vector<uint64_t> *nodes);
 
+  // return current cluster learner node id in nodes
+  void learnerNodes(vector<uint64_t> *nodes);
+
   // return true if leader_ is not none
   bool hasLeader();
 
@@ -125,7 +165,7 @@ struct raft {
   void sendAppend(uint64_t to);
 
   // send heartbeat message
-  void sendHeartbeat(uint64_t to, const string &ctx);
+  void sendHeartbeat(uint64_t to, const string &ctx, bool quiesce);
 
   // broadcast append message to cluster
   void bcastAppend();
@@ -154,12 +194,23 @@ struct raft {
   // call r.bcastAppend).  
   bool maybeCommit();
 
+  // resetTracker tracks the match indexes of progressMap_ from scratch
+  void resetTracker();
+
   // reset to term
   void reset(uint64_t term);
 
-  // append entries to storage
+  // append entries to storage, entries are moved into the log
   void appendEntry(EntryVec* entries);
 
+  // stableTo marks the log stable to the entry (i, t), with parallelAppend_
+  // the leader may then commit its entries.
+  void stableTo(uint64_t i, uint64_t t);
+
+  // propose appends the proposal entries to the leader log and broadcasts
+  // them, entries are moved into the log instead of being copied.
+  void propose(EntryVec* entries);
+
   // handle append entries message
   void handleAppendEntries(const Message& msg);
 
@@ -175,6 +226,24 @@ struct raft {
   // tickHeartbeat is run by leaders to send a MsgBeat after r.heartbeatTimeout.
   void tickHeartbeat();
 
+  // ticksToDeadline returns the number of ticks until the next tick that
+  // takes an action: an election, a heartbeat or a quorum check.
+  int ticksToDeadline();
+
+  // skipTicks advances the elapsed ticks by n ticks without an action,
+  // so that the ticks can be driven only at the deadlines.
+  void skipTicks(int n);
+
+  // canQuiesce returns true if the leader is idle and all the followers have caught up
+  bool canQuiesce();
+
+  // maybeQuiesce quiesces the group if it is enabled and the leader is idle,
+  // it broadcasts the quiesce heartbeat instead of a normal one.
+  bool maybeQuiesce();
+
+  // wake wakes the quiescent group up
+  void wake();
+
   // v means peer `id' accepted or not,after it return num of 
   // granted peers in cluster
   int  poll(uint64_t id, MessageType t, bool v);
@@ -183,9 +252,12 @@ struct raft {
   int  step(const Message& msg);
 
   // promotable indicates whether state machine can be promoted to leader,
-  // which is true when its own id is in progress list.  
+  // which is true when its own id is in progress list and not a learner.
   bool promotable();
 
+  // isLearner returns true if the local node is a learner
+  bool isLearner();
+
   // restore recovers the state machine from a snapshot. It restores the log and the
   // configuration of state machine.
   // return false if snapshot's [index,term] match log's [index,term]
@@ -193,6 +265,8 @@ struct raft {
 
   void delProgress(uint64_t id);
   void addNode(uint64_t id);
+  void addLearner(uint64_t id);
+  void addNodeOrLearnerNode(uint64_t id, bool isLearner);
   void removeNode(uint64_t id);
 
   // pastElectionTimeout returns true if electionElapsed_ >= randomizedElectionTimeout_
@@ -201,13 +275,22 @@ struct raft {
   // reset randomizedElectionTimeout_ to [electiontimeout, 2 * electiontimeout - 1]
   void resetRandomizedElectionTimeout();
 
-  void setProgress(uint64_t id, uint64_t match, uint64_t next);
+  void setProgress(uint64_t id, uint64_t match, uint64_t next, bool isLearner = false);
   void abortLeaderTransfer();
   void proxyMessage(const Message& msg);
 
   // read out messages,after call will clean the outMsgs_(only used in test)
   void readMessages(MessageVec *);
 
+  // allocate outbound messages and read states from arena_
+  Message* newMessage();
+  Message* cloneMessage(const Message& msg);
+  ReadState* newReadState(uint64_t index, const string &ctx);
+
+  // inLease returns true if the leader holds the lease, that is a quorum of
+  // the voters acked heartbeats sent less than leaseTimeout_ ago.
+  bool inLease();
+
   // checkQuorumActive returns true if the quorum is active from
   // the view of the local raft state machine.  
   // checkQuorumActive also resets all RecentActive to false.
@@ -2,81 +2,142 @@
  * Copyright (C) lichuang
  */
 
+#include <algorithm>
 #include "core/read_only.h"
 
 namespace libraft {
-  
+
+static const size_t kMinRingSize = 16;
+
+// roundCtx and ctxRound encode and decode the heartbeat context of a round
+static string
+roundCtx(uint64_t round) {
+  char buf[sizeof(uint64_t)];
+  size_t i;
+  for (i = 0; i < sizeof(buf); ++i) {
+    buf[i] = (char)(round >> (8 * (sizeof(buf) - 1 - i)));
+  }
+  return string(buf, sizeof(buf));
+}
+
+static uint64_t
+ctxRound(const string& ctx) {
+  if (ctx.size() != sizeof(uint64_t)) {
+    return 0;
+  }
+  uint64_t round = 0;
+  size_t i;
+  for (i = 0; i < ctx.size(); ++i) {
+    round = (round << 8) | (unsigned char)ctx[i];
+  }
+  return round;
+}
+
 readOnly::readOnly(ReadOnlyOption option, Logger *logger)
   : option_(option),
+    head_(0),
+    tail_(0),
+    round_(0),
     logger_(logger) {
 }
 
-// addRequest adds a read only reuqest into readonly struct.
+// addRequest adds a read only reuqest into readonly struct, it waits for
+// the next round to start.
 // `index` is the commit index of the raft state machine when it received
 // the read only request.
 // `m` is the original read only request message from the local or remote node.
-void readOnly::addRequest(uint64_t index, Message *msg) {
-  string ctx = msg->entries(0).data();
-  if (pendingReadIndex_.find(ctx) != pendingReadIndex_.end()) {
-    return;
+void readOnly::addRequest(uint64_t index, const Message& msg) {
+  if (pending() == ring_.size()) {
+    grow();
+  }
+  readIndexStatus &rs = ring_[tail_ & (ring_.size() - 1)];
+  rs.index_ = index;
+  rs.req_.CopyFrom(msg);
+  ++tail_;
+}
+
+// grow doubles the ring, the requests keep their sequence
+void readOnly::grow() {
+  vector<readIndexStatus> ring(ring_.empty() ? kMinRingSize : 2 * ring_.size());
+  uint64_t seq;
+  for (seq = head_; seq < tail_; ++seq) {
+    readIndexStatus &from = ring_[seq & (ring_.size() - 1)];
+    readIndexStatus &to = ring[seq & (ring.size() - 1)];
+    to.index_ = from.index_;
+    to.req_.Swap(&from.req_);
+  }
+  ring_.swap(ring);
+}
+
+readRound* readOnly::inFlight(const string& ctx) {
+  uint64_t round = ctxRound(ctx);
+  uint64_t first = round_ - rounds_.size() + 1;
+  if (round < first || round > round_) {
+    return NULL;
   }
-  pendingReadIndex_[ctx] = new readIndexStatus(index, msg);
-  readIndexQueue_.push_back(ctx);
+  return &rounds_[round - first];
 }
 
 // recvAck notifies the readonly struct that the raft state machine received
-// an acknowledgment of the heartbeat that attached with the read only request
-// context.
+// an acknowledgment of the heartbeat of a round, and returns the number of
+// the nodes, the local one included, which acked the round or a later one.
 int readOnly::recvAck(const Message& msg) {
-  map<string, readIndexStatus*>::iterator iter = pendingReadIndex_.find(msg.context());
-  if (iter == pendingReadIndex_.end()) {
+  readRound *rr = inFlight(msg.context());
+  if (rr == NULL) {
     return 0;
   }
 
-  readIndexStatus* rs = iter->second;
-  rs->acks_[msg.from()] = true; 
-  return rs->acks_.size() + 1;
+  // the ack of a round acks the earlier ones
+  deque<readRound>::iterator iter;
+  for (iter = rounds_.begin(); iter != rounds_.end(); ++iter) {
+    vector<uint64_t> &acks = iter->acks_;
+    vector<uint64_t>::iterator pos = lower_bound(acks.begin(), acks.end(), msg.from());
+    if (pos == acks.end() || *pos != msg.from()) {
+      acks.insert(pos, msg.from());
+    }
+    if (&(*iter) == rr) {
+      break;
+    }
+  }
+  return (int)rr->acks_.size() + 1;
 }
 
 // advance advances the read only request queue kept by the readonly struct.
-// It dequeues the requests until it finds the read only request that has
-// the same context as the given `m`.
+// It dequeues the requests of the round of the given `m` and of the earlier
+// ones.
 void readOnly::advance(const Message& msg, vector<readIndexStatus*> *rss) {
-  size_t i;
-  bool found = false;
-  string ctx = msg.context();
-
-  for (i = 0; i < readIndexQueue_.size(); ++i) {
-    map<string, readIndexStatus*>::iterator iter = pendingReadIndex_.find(ctx);
-    if (iter == pendingReadIndex_.end()) {
-      logger_->Fatalf(__FILE__, __LINE__, "cannot find corresponding read state from pending map");
-    }
-
-    readIndexStatus* rs = iter->second;
-    rss->push_back(rs);
-    if (ctx == readIndexQueue_[i]) {
-      found = true;
-      break;
-    }
+  readRound *rr = inFlight(msg.context());
+  if (rr == NULL) {
+    return;
   }
 
-  if (found) {
-    ++i;
-    readIndexQueue_.erase(readIndexQueue_.begin(), readIndexQueue_.begin() + i);
-    for (i = 0; i < rss->size(); ++i) {
-      pendingReadIndex_.erase((*rss)[i]->req_->entries(0).data());
-    }
+  uint64_t end = rr->end_;
+  for (; head_ < end; ++head_) {
+    rss->push_back(&ring_[head_ & (ring_.size() - 1)]);
+  }
+  while (!rounds_.empty() && rounds_.front().end_ <= end) {
+    rounds_.pop_front();
   }
 }
 
-// lastPendingRequestCtx returns the context of the last pending read only
-// request in readonly struct.
-string readOnly::lastPendingRequestCtx() {
-  if (readIndexQueue_.size() == 0) {
+bool readOnly::hasUnsentRequest() const {
+  uint64_t sent = rounds_.empty() ? head_ : rounds_.back().end_;
+  return tail_ > sent;
+}
+
+string readOnly::nextRound() {
+  ++round_;
+  readRound rr;
+  rr.end_ = tail_;
+  rounds_.push_back(rr);
+  return roundCtx(round_);
+}
+
+string readOnly::lastRoundCtx() const {
+  if (rounds_.empty()) {
     return "";
   }
-
-  return readIndexQueue_[readIndexQueue_.size() - 1];
+  return roundCtx(round_);
 }
 
-}; // namespace libraft
\ No newline at end of file
+}; // namespace libraft
@@ -5,7 +5,7 @@
 #ifndef __LIBRAFT_READ_ONLY_H__
 #define __LIBRAFT_READ_ONLY_H__
 
-#include <map>
+#include <deque>
 #include <string>
 #include "core/raft.h"
 
@@ -14,26 +14,78 @@ namespace libraft {
 
 struct readIndexStatus {
   uint64_t index_;
-  Message *req_;
-  map<uint64_t, bool> acks_;
+  Message req_;
 
-  readIndexStatus(uint64_t index, Message *msg)
-    : index_(index),
-      req_(msg) {
+  readIndexStatus()
+    : index_(0) {
   }
 };
 
+// readRound is a round of heartbeats in flight
+struct readRound {
+  // the requests before the sequence end_ are confirmed by the round
+  uint64_t end_;
+
+  // acks_ are the sorted ids of the followers which acked the round, or a
+  // later one. They live as long as the round, so the set of the followers
+  // may change from a round to the next.
+  vector<uint64_t> acks_;
+};
+
+// readOnly keeps the read only requests of ReadOnlySafe. Instead of a
+// heartbeat broadcast per request, the requests are confirmed by rounds of
+// heartbeats numbered by the leader: the context of a heartbeat is its
+// round. At most one round is started while another is in flight, so the
+// requests arriving in the meantime share the next one, and a quorum of
+// acks for a round confirms the requests of the earlier rounds as well.
+//
+// The requests are numbered in the order they arrived and kept in a ring
+// buffer, the request seq is at ring_[seq & (ring_.size() - 1)] for
+// head_ <= seq < tail_, so enqueue, ack and advance are O(1) amortized.
 struct readOnly {
   ReadOnlyOption option_;
-  map<string, readIndexStatus*> pendingReadIndex_;
-  vector<string> readIndexQueue_;
+
+  vector<readIndexStatus> ring_;
+  uint64_t head_;
+  uint64_t tail_;
+
+  // rounds_ are the rounds in flight, the last one is round_, rounds are
+  // numbered from 1.
+  deque<readRound> rounds_;
+  uint64_t round_;
+
   Logger *logger_;
 
   readOnly(ReadOnlyOption option, Logger *logger);
-  void addRequest(uint64_t index, Message *msg);
+
+  void addRequest(uint64_t index, const Message& msg);
   int recvAck(const Message& msg);
+
+  // advance dequeues the requests confirmed by the round of msg into rss,
+  // they are valid until the next addRequest.
   void advance(const Message& msg, vector<readIndexStatus*>* rss);
-  string lastPendingRequestCtx();
+
+  // pending returns the number of the pending requests
+  size_t pending() const { return tail_ - head_; }
+
+  // roundInFlight returns true if some request waits for a round started
+  bool roundInFlight() const { return !rounds_.empty(); }
+
+  // hasUnsentRequest returns true if some request waits for a round to start
+  bool hasUnsentRequest() const;
+
+  // nextRound starts a round for the requests not sent yet and returns its
+  // heartbeat context.
+  string nextRound();
+
+  // lastRoundCtx returns the heartbeat context of the last round started if
+  // it is in flight, "" otherwise.
+  string lastRoundCtx() const;
+
+private:
+  // inFlight returns the round of ctx in rounds_, NULL if it is not in flight
+  readRound* inFlight(const string& ctx);
+  void grow();
 };
 
 }; // namespace libraft
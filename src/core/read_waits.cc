@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include "core/read_waits.h"
+
+namespace libraft {
+
+// the contexts of the batches are the magic followed by the id of the batch
+// in 8 bytes big endian, the leading zero byte keeps them apart from the
+// printable contexts of the application.
+static const char kBatchMagic[] = "\0libraft-read";
+static const size_t kBatchMagicLen = sizeof(kBatchMagic) - 1;
+static const size_t kBatchCtxLen = kBatchMagicLen + 8;
+
+void
+readWaits::add(const ReadDone& done) {
+  open_.push_back(done);
+}
+
+void
+readWaits::nextBatch(string *ctx) {
+  sentId_ = ++nextId_;
+  age_ = 0;
+  sent_.swap(open_);
+  open_.clear();
+
+  ctx->assign(kBatchMagic, kBatchMagicLen);
+  int i;
+  for (i = 7; i >= 0; --i) {
+    ctx->push_back(static_cast<char>((sentId_ >> (i * 8)) & 0xff));
+  }
+}
+
+bool
+readWaits::resolve(const string& ctx, uint64_t index, uint64_t applied) {
+  if (ctx.size() != kBatchCtxLen || ctx.compare(0, kBatchMagicLen, kBatchMagic, kBatchMagicLen) != 0) {
+    return false;
+  }
+  uint64_t id = 0;
+  size_t i;
+  for (i = kBatchMagicLen; i < kBatchCtxLen; ++i) {
+    id = (id << 8) | static_cast<unsigned char>(ctx[i]);
+  }
+  if (id != sentId_ || sent_.empty()) {
+    return true;
+  }
+
+  vector<ReadDone> dones;
+  dones.swap(sent_);
+  for (i = 0; i < dones.size(); ++i) {
+    waitApplied(index, applied, dones[i]);
+  }
+  return true;
+}
+
+void
+readWaits::tick(int timeout) {
+  if (sent_.empty() || ++age_ < timeout) {
+    return;
+  }
+  sent_.insert(sent_.end(), open_.begin(), open_.end());
+  open_.swap(sent_);
+  sent_.clear();
+  sentId_ = 0;
+}
+
+void
+readWaits::waitApplied(uint64_t index, uint64_t applied, const ReadDone& done) {
+  if (index <= applied) {
+    done(OK, index);
+    return;
+  }
+  waits_.insert(std::make_pair(index, done));
+}
+
+void
+readWaits::applied(uint64_t applied) {
+  multimap<uint64_t, ReadDone>::iterator iter = waits_.begin();
+  while (iter != waits_.end() && iter->first <= applied) {
+    // the callback may add a read, copy it out before erasing
+    uint64_t index = iter->first;
+    ReadDone done = iter->second;
+    waits_.erase(iter);
+    done(OK, index);
+    iter = waits_.begin();
+  }
+}
+
+void
+readWaits::abortUnsent(int err) {
+  vector<ReadDone> dones;
+  dones.swap(open_);
+  size_t i;
+  for (i = 0; i < dones.size(); ++i) {
+    dones[i](err, 0);
+  }
+}
+
+void
+readWaits::abort(int err) {
+  open_.insert(open_.begin(), sent_.begin(), sent_.end());
+  sent_.clear();
+  sentId_ = 0;
+  abortUnsent(err);
+
+  multimap<uint64_t, ReadDone> waits;
+  waits.swap(waits_);
+  multimap<uint64_t, ReadDone>::iterator iter;
+  for (iter = waits.begin(); iter != waits.end(); ++iter) {
+    iter->second(err, iter->first);
+  }
+}
+
+}; // namespace libraft
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_READ_WAITS_H__
+#define __LIBRAFT_READ_WAITS_H__
+
+#include <map>
+#include "libraft.h"
+
+namespace libraft {
+
+// readWaits keeps the reads of Node.ReadIndexWithCallback and Node.WaitApplied.
+// The reads issued while a batch is in flight are queued, and sent together
+// in one MsgReadIndex once the batch in flight is resolved, so a follower
+// forwards one request to the leader per batch instead of one per read.
+// A resolved read waits, ordered by its read index, for the applied index.
+class readWaits {
+public:
+  readWaits() : nextId_(0), sentId_(0), age_(0) {}
+
+  // hasUnsent returns true if there are reads queued for the next batch
+  bool hasUnsent() const {
+    return !open_.empty();
+  }
+
+  // inFlight returns true if a batch has been sent and not resolved yet
+  bool inFlight() const {
+    return !sent_.empty();
+  }
+
+  // add queues done for the next batch
+  void add(const ReadDone& done);
+
+  // nextBatch sends the queued reads as the batch in flight,
+  // and returns the context of its MsgReadIndex in ctx.
+  void nextBatch(string *ctx);
+
+  // resolve returns true if ctx is the context of a batch, the reads of the
+  // batch in flight wait for index, or are done if applied has reached it.
+  // The contexts of the batches given up by tick are dropped.
+  bool resolve(const string& ctx, uint64_t index, uint64_t applied);
+
+  // tick ages the batch in flight, after timeout ticks it is given up and
+  // its reads are queued again at the head of the next batch, as the
+  // MsgReadIndex may have been dropped, e.g. by a leader yet to commit in its term.
+  void tick(int timeout);
+
+  // waitApplied calls done once applied reaches index, at once if it has.
+  void waitApplied(uint64_t index, uint64_t applied, const ReadDone& done);
+
+  // applied resolves the reads waiting for an index up to applied
+  void applied(uint64_t applied);
+
+  // abortUnsent fails the reads queued for the next batch with err
+  void abortUnsent(int err);
+
+  // abort fails all the reads with err
+  void abort(int err);
+
+private:
+  uint64_t nextId_;
+
+  // the id of the batch in flight, and the ticks since it was sent
+  uint64_t sentId_;
+  int age_;
+
+  vector<ReadDone> open_;
+  vector<ReadDone> sent_;
+  multimap<uint64_t, ReadDone> waits_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_READ_WAITS_H__
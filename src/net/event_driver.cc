@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <event2/event.h>
+#include "base/default_logger.h"
+#include "base/util.h"
+#include "core/node.h"
+#include "net/event_driver.h"
+#include "net/transport.h"
+
+namespace libraft {
+
+static void
+tickCallback(evutil_socket_t fd, short events, void *arg) {
+  static_cast<EventDriverImpl*>(arg)->onTick();
+}
+
+static void
+recvCallback(void *arg, const Message& msg) {
+  static_cast<EventDriverImpl*>(arg)->onMessage(msg);
+}
+
+EventDriverImpl::EventDriverImpl(const EventDriverConfig& config)
+  : base_(config.base),
+    id_(config.id),
+    node_(dynamic_cast<NodeImpl*>(config.node)),
+    storage_(config.storage),
+    applier_(config.applier),
+    logger_(config.logger),
+    ownLogger_(false),
+    tickInterval_(config.tickInterval),
+    ticker_(NULL),
+    transport_(NULL),
+    stopped_(false) {
+  if (logger_ == NULL) {
+    logger_ = new DefaultLogger();
+    ownLogger_ = true;
+  }
+  if (node_ == NULL) {
+    // the driver polls the Ready of the Node, which is not part of Node
+    logger_->Fatalf(__FILE__, __LINE__, "the node of the driver is not returned by StartNode or RestartNode");
+  }
+  transport_ = new transport(base_, id_, config.peers, logger_, recvCallback, this);
+}
+
+EventDriverImpl::~EventDriverImpl() {
+  Stop();
+  delete transport_;
+  delete node_;
+  if (ownLogger_) {
+    delete logger_;
+  }
+}
+
+int
+EventDriverImpl::Start() {
+  int err = transport_->start();
+  if (!SUCCESS(err)) {
+    return err;
+  }
+
+  ticker_ = event_new(base_, -1, EV_PERSIST, tickCallback, this);
+  struct timeval tv;
+  tv.tv_sec = tickInterval_ / 1000;
+  tv.tv_usec = (tickInterval_ % 1000) * 1000;
+  event_add(ticker_, &tv);
+
+  // the initial conf change entries of StartNode are to be saved and applied
+  Ready *ready;
+  node_->PollReady(&ready);
+  handleReady(ready);
+  return OK;
+}
+
+void
+EventDriverImpl::Stop() {
+  if (stopped_) {
+    return;
+  }
+  stopped_ = true;
+  if (ticker_ != NULL) {
+    event_free(ticker_);
+    ticker_ = NULL;
+  }
+  transport_->stop();
+  node_->Stop();
+}
+
+int
+EventDriverImpl::Campaign() {
+  Ready *ready;
+  int err = node_->Campaign(&ready);
+  handleReady(ready);
+  return err;
+}
+
+int
+EventDriverImpl::Propose(const string& data) {
+  Ready *ready;
+  int err = node_->Propose(data, &ready);
+  handleReady(ready);
+  return err;
+}
+
+int
+EventDriverImpl::ProposeConfChange(const ConfChange& cc) {
+  Ready *ready;
+  int err = node_->ProposeConfChange(cc, &ready);
+  handleReady(ready);
+  return err;
+}
+
+int
+EventDriverImpl::ReadIndex(const string &rctx) {
+  Ready *ready;
+  int err = node_->ReadIndex(rctx, &ready);
+  handleReady(ready);
+  return err;
+}
+
+void
+EventDriverImpl::onTick() {
+  Ready *ready;
+  node_->Tick(&ready);
+  handleReady(ready);
+}
+
+void
+EventDriverImpl::onMessage(const Message& msg) {
+  if (stopped_) {
+    return;
+  }
+  Ready *ready;
+  node_->Step(msg, &ready);
+  handleReady(ready);
+}
+
+void
+EventDriverImpl::handleReady(Ready *ready) {
+  while (ready != NULL && !stopped_) {
+    if (ready->sendFirst) {
+      // the leader replicates its entries while saving them
+      transport_->send(ready->messages);
+    }
+
+    // save the state BEFORE the other messages are sent
+    int err = OK;
+    if (!isEmptySnapshot(ready->snapshot)) {
+      err = storage_->ApplySnapshot(*ready->snapshot);
+    }
+    if (SUCCESS(err) && !ready->entries.empty()) {
+      err = storage_->Append(ready->entries);
+    }
+    if (SUCCESS(err) && !isHardStateEqual(ready->hardState, kEmptyHardState)) {
+      err = storage_->SetHardState(ready->hardState);
+    }
+    if (!SUCCESS(err)) {
+      logger_->Fatalf(__FILE__, __LINE__, "%x save ready fail: %s", id_, GetErrorString(err));
+    }
+
+    if (!ready->sendFirst) {
+      transport_->send(ready->messages);
+    }
+
+    size_t i;
+    for (i = 0; i < ready->committedEntries.size(); ++i) {
+      const Entry& entry = *ready->committedEntries[i];
+      if (entry.type() != EntryConfChange) {
+        continue;
+      }
+      ConfChange cc;
+      if (!cc.ParseFromString(entry.data())) {
+        logger_->Fatalf(__FILE__, __LINE__, "%x parse conf change at index %llu fail",
+          id_, entry.index());
+      }
+      ConfState cs;
+      Ready *unused;
+      node_->ApplyConfChange(cc, &cs, &unused);
+      // the ConfState is to be recorded in the snapshots
+      err = storage_->SetConfState(cs);
+      if (!SUCCESS(err)) {
+        logger_->Fatalf(__FILE__, __LINE__, "%x save conf state fail: %s", id_, GetErrorString(err));
+      }
+    }
+    if (applier_ != NULL) {
+      applier_->Apply(*ready);
+    }
+
+    node_->Advance();
+    // return what the node has done since the Ready
+    node_->PollReady(&ready);
+  }
+}
+
+EventDriver*
+NewEventDriver(const EventDriverConfig& config) {
+  // the driver advances the Readies with Advance
+  NodeImpl *node = dynamic_cast<NodeImpl*>(config.node);
+  if (node != NULL && node->asyncReady_) {
+    return NULL;
+  }
+  return new EventDriverImpl(config);
+}
+
+}; // namespace libraft
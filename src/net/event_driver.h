@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_EVENT_DRIVER_H__
+#define __LIBRAFT_EVENT_DRIVER_H__
+
+#include "libraft.h"
+
+struct event;
+
+namespace libraft {
+
+class NodeImpl;
+class transport;
+
+class EventDriverImpl : public EventDriver {
+public:
+  EventDriverImpl(const EventDriverConfig& config);
+  virtual ~EventDriverImpl();
+
+  virtual int  Start();
+  virtual int  Campaign();
+  virtual int  Propose(const string& data);
+  virtual int  ProposeConfChange(const ConfChange& cc);
+  virtual int  ReadIndex(const string &rctx);
+  virtual void Stop();
+
+  // called by the ticker and the transport
+  void onTick();
+  void onMessage(const Message& msg);
+
+private:
+  // handleReady saves ready, sends its messages, applies it and advances
+  // the node, until the node has nothing more to do.
+  void handleReady(Ready *ready);
+
+public:
+  event_base *base_;
+  uint64_t id_;
+  NodeImpl *node_;
+  WritableStorage *storage_;
+  Applier *applier_;
+
+  Logger *logger_;
+  bool ownLogger_;
+
+  int tickInterval_;
+  struct event *ticker_;
+
+  transport *transport_;
+
+  bool stopped_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_EVENT_DRIVER_H__
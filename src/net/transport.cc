@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/listener.h>
+#include "net/transport.h"
+
+namespace libraft {
+
+// the length prefix of a frame
+static const size_t kFrameHeaderSize = sizeof(uint32_t);
+
+// a larger frame is taken as a corrupted stream
+static const uint32_t kMaxFrameSize = 512 * 1024 * 1024;
+
+// the messages to a peer are dropped while this many bytes are pending
+// to it, e.g. when the peer is down or too slow.
+static const size_t kMaxPendingBytes = 64 * 1024 * 1024;
+
+static bool
+toSockAddr(const PeerAddress& addr, struct sockaddr_in *sin) {
+  memset(sin, 0, sizeof(*sin));
+  sin->sin_family = AF_INET;
+  sin->sin_port = htons(addr.port);
+  return inet_pton(AF_INET, addr.host.c_str(), &sin->sin_addr) == 1;
+}
+
+static void
+acceptCallback(struct evconnlistener *listener, evutil_socket_t fd,
+               struct sockaddr *addr, int len, void *arg) {
+  static_cast<transport*>(arg)->onAccept(fd);
+}
+
+static void
+inboundReadCallback(struct bufferevent *bev, void *arg) {
+  static_cast<transport*>(arg)->onRead(bev);
+}
+
+static void
+inboundEventCallback(struct bufferevent *bev, short events, void *arg) {
+  static_cast<transport*>(arg)->onInboundEvent(bev, events);
+}
+
+// nothing is read on the outgoing connections, the read side is only
+// enabled to find out the connection closed by the peer.
+static void
+peerReadCallback(struct bufferevent *bev, void *arg) {
+  struct evbuffer *input = bufferevent_get_input(bev);
+  evbuffer_drain(input, evbuffer_get_length(input));
+}
+
+static void
+peerEventCallback(struct bufferevent *bev, short events, void *arg) {
+  peerConn *peer = static_cast<peerConn*>(arg);
+  peer->trans_->onPeerEvent(peer, events);
+}
+
+// releaseEntries releases the encoded entries referenced by an output buffer
+static void
+releaseEntries(const void *data, size_t len, void *arg) {
+  delete static_cast<std::shared_ptr<const string>*>(arg);
+}
+
+transport::transport(event_base *base, uint64_t id, const vector<PeerAddress>& peers,
+                     Logger *logger, recvFunc recv, void *arg)
+  : base_(base),
+    id_(id),
+    logger_(logger),
+    recv_(recv),
+    arg_(arg),
+    stopped_(false),
+    listener_(NULL) {
+  local_.id = id;
+  local_.port = 0;
+  size_t i;
+  for (i = 0; i < peers.size(); ++i) {
+    if (peers[i].id == id) {
+      local_ = peers[i];
+      continue;
+    }
+    peers_[peers[i].id] = new peerConn(this, peers[i]);
+  }
+}
+
+transport::~transport() {
+  stop();
+  map<uint64_t, peerConn*>::iterator iter;
+  for (iter = peers_.begin(); iter != peers_.end(); ++iter) {
+    delete iter->second;
+  }
+}
+
+int
+transport::start() {
+  struct sockaddr_in sin;
+  if (!toSockAddr(local_, &sin)) {
+    logger_->Errorf(__FILE__, __LINE__, "%x invalid local address %s:%d",
+      id_, local_.host.c_str(), local_.port);
+    return ErrListenFail;
+  }
+  listener_ = evconnlistener_new_bind(base_, acceptCallback, this,
+    LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE, -1,
+    (struct sockaddr*)&sin, sizeof(sin));
+  if (listener_ == NULL) {
+    logger_->Errorf(__FILE__, __LINE__, "%x listen on %s:%d fail: %s",
+      id_, local_.host.c_str(), local_.port, strerror(errno));
+    return ErrListenFail;
+  }
+  return OK;
+}
+
+void
+transport::stop() {
+  if (stopped_) {
+    return;
+  }
+  stopped_ = true;
+  if (listener_ != NULL) {
+    evconnlistener_free(listener_);
+    listener_ = NULL;
+  }
+  map<uint64_t, peerConn*>::iterator iter;
+  for (iter = peers_.begin(); iter != peers_.end(); ++iter) {
+    closePeer(iter->second);
+  }
+  set<bufferevent*>::iterator bevIter;
+  for (bevIter = inbound_.begin(); bevIter != inbound_.end(); ++bevIter) {
+    bufferevent_free(*bevIter);
+  }
+  inbound_.clear();
+}
+
+void
+transport::send(const MessageVec& msgs) {
+  if (stopped_ || msgs.empty()) {
+    return;
+  }
+  encoded_.clear();
+  EncodeMessages(msgs, &encoded_);
+
+  size_t i;
+  for (i = 0; i < msgs.size(); ++i) {
+    map<uint64_t, peerConn*>::iterator iter = peers_.find(msgs[i]->to());
+    if (iter == peers_.end()) {
+      logger_->Warningf(__FILE__, __LINE__, "%x drop message to unknown peer %x",
+        id_, msgs[i]->to());
+      continue;
+    }
+    peerConn *peer = iter->second;
+    if (peer->bev_ == NULL && !connect(peer)) {
+      continue;
+    }
+
+    struct evbuffer *output = bufferevent_get_output(peer->bev_);
+    if (evbuffer_get_length(output) > kMaxPendingBytes) {
+      logger_->Debugf(__FILE__, __LINE__, "%x drop message to %x, too many bytes pending",
+        id_, peer->addr_.id);
+      continue;
+    }
+
+    const EncodedMessage& em = encoded_[i];
+    size_t size = em.header.size();
+    if (em.entries != NULL) {
+      size += em.entries->size();
+    }
+    uint32_t length = htonl((uint32_t)size);
+    evbuffer_add(output, &length, kFrameHeaderSize);
+    evbuffer_add(output, em.header.data(), em.header.size());
+    if (em.entries != NULL && !em.entries->empty()) {
+      // the entries shared by the messages of a broadcast are not copied
+      std::shared_ptr<const string> *entries = new std::shared_ptr<const string>(em.entries);
+      evbuffer_add_reference(output, (*entries)->data(), (*entries)->size(),
+        releaseEntries, entries);
+    }
+  }
+}
+
+bool
+transport::connect(peerConn *peer) {
+  struct sockaddr_in sin;
+  if (!toSockAddr(peer->addr_, &sin)) {
+    logger_->Errorf(__FILE__, __LINE__, "%x invalid address %s:%d of peer %x",
+      id_, peer->addr_.host.c_str(), peer->addr_.port, peer->addr_.id);
+    return false;
+  }
+  struct bufferevent *bev = bufferevent_socket_new(base_, -1, BEV_OPT_CLOSE_ON_FREE);
+  bufferevent_setcb(bev, peerReadCallback, NULL, peerEventCallback, peer);
+  if (bufferevent_socket_connect(bev, (struct sockaddr*)&sin, sizeof(sin)) < 0) {
+    bufferevent_free(bev);
+    return false;
+  }
+  bufferevent_enable(bev, EV_READ | EV_WRITE);
+  peer->bev_ = bev;
+  return true;
+}
+
+void
+transport::closePeer(peerConn *peer) {
+  if (peer->bev_ != NULL) {
+    bufferevent_free(peer->bev_);
+    peer->bev_ = NULL;
+  }
+}
+
+void
+transport::closeInbound(bufferevent *bev) {
+  inbound_.erase(bev);
+  bufferevent_free(bev);
+}
+
+void
+transport::onAccept(int fd) {
+  int on = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  evutil_make_socket_nonblocking(fd);
+  struct bufferevent *bev = bufferevent_socket_new(base_, fd, BEV_OPT_CLOSE_ON_FREE);
+  bufferevent_setcb(bev, inboundReadCallback, NULL, inboundEventCallback, this);
+  bufferevent_enable(bev, EV_READ);
+  inbound_.insert(bev);
+}
+
+void
+transport::onRead(bufferevent *bev) {
+  struct evbuffer *input = bufferevent_get_input(bev);
+  while (!stopped_) {
+    size_t length = evbuffer_get_length(input);
+    if (length < kFrameHeaderSize) {
+      return;
+    }
+    uint32_t size;
+    evbuffer_copyout(input, &size, kFrameHeaderSize);
+    size = ntohl(size);
+    if (size > kMaxFrameSize) {
+      logger_->Errorf(__FILE__, __LINE__, "%x close connection with frame of %u bytes", id_, size);
+      closeInbound(bev);
+      return;
+    }
+    if (length < kFrameHeaderSize + size) {
+      return;
+    }
+    evbuffer_drain(input, kFrameHeaderSize);
+
+    Message msg;
+    bool ok = msg.ParseFromArray(evbuffer_pullup(input, size), size);
+    evbuffer_drain(input, size);
+    if (!ok) {
+      logger_->Errorf(__FILE__, __LINE__, "%x close connection with malformed message", id_);
+      closeInbound(bev);
+      return;
+    }
+    // recv_ may stop the transport, which frees bev
+    recv_(arg_, msg);
+  }
+}
+
+void
+transport::onInboundEvent(bufferevent *bev, short events) {
+  if (events & (BEV_EVENT_EOF | BEV_EVENT_ERROR)) {
+    closeInbound(bev);
+  }
+}
+
+void
+transport::onPeerEvent(peerConn *peer, short events) {
+  if (events & BEV_EVENT_CONNECTED) {
+    int on = 1;
+    setsockopt(bufferevent_getfd(peer->bev_), IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    logger_->Debugf(__FILE__, __LINE__, "%x connected to %x", id_, peer->addr_.id);
+    return;
+  }
+  if (events & (BEV_EVENT_EOF | BEV_EVENT_ERROR)) {
+    // the pending messages are dropped, connect again on the next send
+    logger_->Debugf(__FILE__, __LINE__, "%x connection to %x closed", id_, peer->addr_.id);
+    closePeer(peer);
+  }
+}
+
+}; // namespace libraft
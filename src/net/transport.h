@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#ifndef __LIBRAFT_TRANSPORT_H__
+#define __LIBRAFT_TRANSPORT_H__
+
+#include <map>
+#include <set>
+#include "libraft.h"
+
+struct bufferevent;
+struct evconnlistener;
+
+namespace libraft {
+
+class transport;
+
+// recvFunc is called with each message read by a transport
+typedef void (*recvFunc)(void *arg, const Message& msg);
+
+// peerConn is the outgoing connection to a peer, it is connected on
+// the first send and connected again on the next send after it fails.
+struct peerConn {
+  transport *trans_;
+  PeerAddress addr_;
+  bufferevent *bev_;
+
+  peerConn(transport *trans, const PeerAddress& addr)
+    : trans_(trans),
+      addr_(addr),
+      bev_(NULL) {}
+};
+
+// transport sends the messages to the peers and reads the messages from
+// the peers over TCP. Each message is framed with its length in 4 bytes in
+// network order. A node sends on its own outgoing connections and reads on
+// the incoming ones, the messages lost with a broken connection are
+// recovered by raft.
+class transport {
+public:
+  transport(event_base *base, uint64_t id, const vector<PeerAddress>& peers,
+            Logger *logger, recvFunc recv, void *arg);
+  ~transport();
+
+  // start listens on the local address
+  int start();
+
+  // send queues msgs to the output buffers of the connections, which
+  // are flushed when the event loop gets back to them.
+  void send(const MessageVec& msgs);
+
+  // stop closes the listener and all the connections
+  void stop();
+
+  // called by the libevent callbacks
+  void onAccept(int fd);
+  void onRead(bufferevent *bev);
+  void onInboundEvent(bufferevent *bev, short events);
+  void onPeerEvent(peerConn *peer, short events);
+
+private:
+  bool connect(peerConn *peer);
+  void closePeer(peerConn *peer);
+  void closeInbound(bufferevent *bev);
+
+public:
+  event_base *base_;
+  uint64_t id_;
+  Logger *logger_;
+
+  recvFunc recv_;
+  void *arg_;
+
+  bool stopped_;
+
+  PeerAddress local_;
+  evconnlistener *listener_;
+
+  // the outgoing connections by peer id
+  map<uint64_t, peerConn*> peers_;
+
+  // the incoming connections
+  set<bufferevent*> inbound_;
+
+  // scratch buffer of send
+  vector<EncodedMessage> encoded_;
+};
+
+}; // namespace libraft
+
+#endif  // __LIBRAFT_TRANSPORT_H__
@@ -8,12 +8,12 @@
 #include <string>
 
 #include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3014000
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3014000 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -23,7 +23,6 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_table_driven.h>
 #include <google/protobuf/generated_message_util.h>
 #include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
@@ -43,38 +42,30 @@ PROTOBUF_NAMESPACE_CLOSE
 
 // Internal implementation detail -- do not use these members.
 struct TableStruct_src_2fproto_2fraft_2eproto {
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTableField entries[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::AuxiliaryParseTableField aux[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[7]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
-  static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
-  static const ::PROTOBUF_NAMESPACE_ID::uint32 offsets[];
+  static const uint32_t offsets[];
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_src_2fproto_2fraft_2eproto;
 namespace raftpb {
 class ConfChange;
-class ConfChangeDefaultTypeInternal;
+struct ConfChangeDefaultTypeInternal;
 extern ConfChangeDefaultTypeInternal _ConfChange_default_instance_;
 class ConfState;
-class ConfStateDefaultTypeInternal;
+struct ConfStateDefaultTypeInternal;
 extern ConfStateDefaultTypeInternal _ConfState_default_instance_;
 class Entry;
-class EntryDefaultTypeInternal;
+struct EntryDefaultTypeInternal;
 extern EntryDefaultTypeInternal _Entry_default_instance_;
 class HardState;
-class HardStateDefaultTypeInternal;
+struct HardStateDefaultTypeInternal;
 extern HardStateDefaultTypeInternal _HardState_default_instance_;
 class Message;
-class MessageDefaultTypeInternal;
+struct MessageDefaultTypeInternal;
 extern MessageDefaultTypeInternal _Message_default_instance_;
 class Snapshot;
-class SnapshotDefaultTypeInternal;
+struct SnapshotDefaultTypeInternal;
 extern SnapshotDefaultTypeInternal _Snapshot_default_instance_;
 class SnapshotMetadata;
-class SnapshotMetadataDefaultTypeInternal;
+struct SnapshotMetadataDefaultTypeInternal;
 extern SnapshotMetadataDefaultTypeInternal _SnapshotMetadata_default_instance_;
 }  // namespace raftpb
 PROTOBUF_NAMESPACE_OPEN
@@ -154,11 +145,12 @@ inline bool MessageType_Parse(
 enum ConfChangeType : int {
   ConfChangeAddNode = 0,
   ConfChangeRemoveNode = 1,
-  ConfChangeUpdateNode = 2
+  ConfChangeUpdateNode = 2,
+  ConfChangeAddLearnerNode = 3
 };
 bool ConfChangeType_IsValid(int value);
 constexpr ConfChangeType ConfChangeType_MIN = ConfChangeAddNode;
-constexpr ConfChangeType ConfChangeType_MAX = ConfChangeUpdateNode;
+constexpr ConfChangeType ConfChangeType_MAX = ConfChangeAddLearnerNode;
 constexpr int ConfChangeType_ARRAYSIZE = ConfChangeType_MAX + 1;
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ConfChangeType_descriptor();
@@ -177,11 +169,12 @@ inline bool ConfChangeType_Parse(
 }
 // ===================================================================
 
-class Entry PROTOBUF_FINAL :
+class Entry final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.Entry) */ {
  public:
   inline Entry() : Entry(nullptr) {}
-  virtual ~Entry();
+  ~Entry() override;
+  explicit PROTOBUF_CONSTEXPR Entry(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Entry(const Entry& from);
   Entry(Entry&& from) noexcept
@@ -194,8 +187,13 @@ class Entry PROTOBUF_FINAL :
     return *this;
   }
   inline Entry& operator=(Entry&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -213,13 +211,14 @@ class Entry PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Entry& default_instance() {
+    return *internal_default_instance();
   }
-  static const Entry& default_instance();
-
   static inline const Entry* internal_default_instance() {
     return reinterpret_cast<const Entry*>(
                &_Entry_default_instance_);
@@ -232,7 +231,12 @@ class Entry PROTOBUF_FINAL :
   }
   inline void Swap(Entry* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -240,56 +244,53 @@ class Entry PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(Entry* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline Entry* New() const final {
-    return CreateMaybeMessage<Entry>(nullptr);
-  }
-
-  Entry* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  Entry* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Entry>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Entry& from);
-  void MergeFrom(const Entry& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Entry& from) {
+    Entry::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Entry* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.Entry";
   }
   protected:
-  explicit Entry(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit Entry(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -308,16 +309,14 @@ class Entry PROTOBUF_FINAL :
   public:
   void clear_data();
   const std::string& data() const;
-  void set_data(const std::string& value);
-  void set_data(std::string&& value);
-  void set_data(const char* value);
-  void set_data(const void* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_data(ArgT0&& arg0, ArgT... args);
   std::string* mutable_data();
-  std::string* release_data();
+  PROTOBUF_NODISCARD std::string* release_data();
   void set_allocated_data(std::string* data);
   private:
   const std::string& _internal_data() const;
-  void _internal_set_data(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_data(const std::string& value);
   std::string* _internal_mutable_data();
   public:
 
@@ -327,11 +326,11 @@ class Entry PROTOBUF_FINAL :
   bool _internal_has_term() const;
   public:
   void clear_term();
-  ::PROTOBUF_NAMESPACE_ID::uint64 term() const;
-  void set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t term() const;
+  void set_term(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_term() const;
-  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_term() const;
+  void _internal_set_term(uint64_t value);
   public:
 
   // required uint64 Index = 3;
@@ -340,11 +339,11 @@ class Entry PROTOBUF_FINAL :
   bool _internal_has_index() const;
   public:
   void clear_index();
-  ::PROTOBUF_NAMESPACE_ID::uint64 index() const;
-  void set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t index() const;
+  void set_index(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_index() const;
-  void _internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_index() const;
+  void _internal_set_index(uint64_t value);
   public:
 
   // required .raftpb.EntryType Type = 1;
@@ -370,21 +369,25 @@ class Entry PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 term_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 index_;
-  int type_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
+    uint64_t term_;
+    uint64_t index_;
+    int type_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ConfState PROTOBUF_FINAL :
+class ConfState final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.ConfState) */ {
  public:
   inline ConfState() : ConfState(nullptr) {}
-  virtual ~ConfState();
+  ~ConfState() override;
+  explicit PROTOBUF_CONSTEXPR ConfState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ConfState(const ConfState& from);
   ConfState(ConfState&& from) noexcept
@@ -397,8 +400,13 @@ class ConfState PROTOBUF_FINAL :
     return *this;
   }
   inline ConfState& operator=(ConfState&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -416,13 +424,14 @@ class ConfState PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ConfState& default_instance() {
+    return *internal_default_instance();
   }
-  static const ConfState& default_instance();
-
   static inline const ConfState* internal_default_instance() {
     return reinterpret_cast<const ConfState*>(
                &_ConfState_default_instance_);
@@ -435,7 +444,12 @@ class ConfState PROTOBUF_FINAL :
   }
   inline void Swap(ConfState* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -443,56 +457,53 @@ class ConfState PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(ConfState* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline ConfState* New() const final {
-    return CreateMaybeMessage<ConfState>(nullptr);
-  }
-
-  ConfState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  ConfState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<ConfState>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ConfState& from);
-  void MergeFrom(const ConfState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ConfState& from) {
+    ConfState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(ConfState* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.ConfState";
   }
   protected:
-  explicit ConfState(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit ConfState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -500,6 +511,7 @@ class ConfState PROTOBUF_FINAL :
 
   enum : int {
     kNodesFieldNumber = 1,
+    kLearnersFieldNumber = 2,
   };
   // repeated uint64 nodes = 1;
   int nodes_size() const;
@@ -508,21 +520,43 @@ class ConfState PROTOBUF_FINAL :
   public:
   void clear_nodes();
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_nodes(int index) const;
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >&
+  uint64_t _internal_nodes(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
       _internal_nodes() const;
-  void _internal_add_nodes(::PROTOBUF_NAMESPACE_ID::uint64 value);
-  ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >*
+  void _internal_add_nodes(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
       _internal_mutable_nodes();
   public:
-  ::PROTOBUF_NAMESPACE_ID::uint64 nodes(int index) const;
-  void set_nodes(int index, ::PROTOBUF_NAMESPACE_ID::uint64 value);
-  void add_nodes(::PROTOBUF_NAMESPACE_ID::uint64 value);
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >&
+  uint64_t nodes(int index) const;
+  void set_nodes(int index, uint64_t value);
+  void add_nodes(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
       nodes() const;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >*
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
       mutable_nodes();
 
+  // repeated uint64 learners = 2;
+  int learners_size() const;
+  private:
+  int _internal_learners_size() const;
+  public:
+  void clear_learners();
+  private:
+  uint64_t _internal_learners(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_learners() const;
+  void _internal_add_learners(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_learners();
+  public:
+  uint64_t learners(int index) const;
+  void set_learners(int index, uint64_t value);
+  void add_learners(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      learners() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_learners();
+
   // @@protoc_insertion_point(class_scope:raftpb.ConfState)
  private:
   class _Internal;
@@ -530,17 +564,22 @@ class ConfState PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 > nodes_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > nodes_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > learners_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class SnapshotMetadata PROTOBUF_FINAL :
+class SnapshotMetadata final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.SnapshotMetadata) */ {
  public:
   inline SnapshotMetadata() : SnapshotMetadata(nullptr) {}
-  virtual ~SnapshotMetadata();
+  ~SnapshotMetadata() override;
+  explicit PROTOBUF_CONSTEXPR SnapshotMetadata(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   SnapshotMetadata(const SnapshotMetadata& from);
   SnapshotMetadata(SnapshotMetadata&& from) noexcept
@@ -553,8 +592,13 @@ class SnapshotMetadata PROTOBUF_FINAL :
     return *this;
   }
   inline SnapshotMetadata& operator=(SnapshotMetadata&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -572,13 +616,14 @@ class SnapshotMetadata PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SnapshotMetadata& default_instance() {
+    return *internal_default_instance();
   }
-  static const SnapshotMetadata& default_instance();
-
   static inline const SnapshotMetadata* internal_default_instance() {
     return reinterpret_cast<const SnapshotMetadata*>(
                &_SnapshotMetadata_default_instance_);
@@ -591,7 +636,12 @@ class SnapshotMetadata PROTOBUF_FINAL :
   }
   inline void Swap(SnapshotMetadata* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -599,56 +649,53 @@ class SnapshotMetadata PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(SnapshotMetadata* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline SnapshotMetadata* New() const final {
-    return CreateMaybeMessage<SnapshotMetadata>(nullptr);
-  }
-
-  SnapshotMetadata* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  SnapshotMetadata* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<SnapshotMetadata>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const SnapshotMetadata& from);
-  void MergeFrom(const SnapshotMetadata& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SnapshotMetadata& from) {
+    SnapshotMetadata::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(SnapshotMetadata* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.SnapshotMetadata";
   }
   protected:
-  explicit SnapshotMetadata(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit SnapshotMetadata(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -666,7 +713,7 @@ class SnapshotMetadata PROTOBUF_FINAL :
   public:
   void clear_conf_state();
   const ::raftpb::ConfState& conf_state() const;
-  ::raftpb::ConfState* release_conf_state();
+  PROTOBUF_NODISCARD ::raftpb::ConfState* release_conf_state();
   ::raftpb::ConfState* mutable_conf_state();
   void set_allocated_conf_state(::raftpb::ConfState* conf_state);
   private:
@@ -683,11 +730,11 @@ class SnapshotMetadata PROTOBUF_FINAL :
   bool _internal_has_index() const;
   public:
   void clear_index();
-  ::PROTOBUF_NAMESPACE_ID::uint64 index() const;
-  void set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t index() const;
+  void set_index(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_index() const;
-  void _internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_index() const;
+  void _internal_set_index(uint64_t value);
   public:
 
   // optional uint64 term = 3;
@@ -696,11 +743,11 @@ class SnapshotMetadata PROTOBUF_FINAL :
   bool _internal_has_term() const;
   public:
   void clear_term();
-  ::PROTOBUF_NAMESPACE_ID::uint64 term() const;
-  void set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t term() const;
+  void set_term(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_term() const;
-  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_term() const;
+  void _internal_set_term(uint64_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:raftpb.SnapshotMetadata)
@@ -710,20 +757,24 @@ class SnapshotMetadata PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::raftpb::ConfState* conf_state_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 index_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 term_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::raftpb::ConfState* conf_state_;
+    uint64_t index_;
+    uint64_t term_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Snapshot PROTOBUF_FINAL :
+class Snapshot final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.Snapshot) */ {
  public:
   inline Snapshot() : Snapshot(nullptr) {}
-  virtual ~Snapshot();
+  ~Snapshot() override;
+  explicit PROTOBUF_CONSTEXPR Snapshot(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Snapshot(const Snapshot& from);
   Snapshot(Snapshot&& from) noexcept
@@ -736,8 +787,13 @@ class Snapshot PROTOBUF_FINAL :
     return *this;
   }
   inline Snapshot& operator=(Snapshot&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -755,13 +811,14 @@ class Snapshot PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Snapshot& default_instance() {
+    return *internal_default_instance();
   }
-  static const Snapshot& default_instance();
-
   static inline const Snapshot* internal_default_instance() {
     return reinterpret_cast<const Snapshot*>(
                &_Snapshot_default_instance_);
@@ -774,7 +831,12 @@ class Snapshot PROTOBUF_FINAL :
   }
   inline void Swap(Snapshot* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -782,56 +844,53 @@ class Snapshot PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(Snapshot* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline Snapshot* New() const final {
-    return CreateMaybeMessage<Snapshot>(nullptr);
-  }
-
-  Snapshot* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  Snapshot* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Snapshot>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Snapshot& from);
-  void MergeFrom(const Snapshot& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Snapshot& from) {
+    Snapshot::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Snapshot* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.Snapshot";
   }
   protected:
-  explicit Snapshot(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit Snapshot(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -848,16 +907,14 @@ class Snapshot PROTOBUF_FINAL :
   public:
   void clear_data();
   const std::string& data() const;
-  void set_data(const std::string& value);
-  void set_data(std::string&& value);
-  void set_data(const char* value);
-  void set_data(const void* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_data(ArgT0&& arg0, ArgT... args);
   std::string* mutable_data();
-  std::string* release_data();
+  PROTOBUF_NODISCARD std::string* release_data();
   void set_allocated_data(std::string* data);
   private:
   const std::string& _internal_data() const;
-  void _internal_set_data(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_data(const std::string& value);
   std::string* _internal_mutable_data();
   public:
 
@@ -868,7 +925,7 @@ class Snapshot PROTOBUF_FINAL :
   public:
   void clear_metadata();
   const ::raftpb::SnapshotMetadata& metadata() const;
-  ::raftpb::SnapshotMetadata* release_metadata();
+  PROTOBUF_NODISCARD ::raftpb::SnapshotMetadata* release_metadata();
   ::raftpb::SnapshotMetadata* mutable_metadata();
   void set_allocated_metadata(::raftpb::SnapshotMetadata* metadata);
   private:
@@ -886,19 +943,23 @@ class Snapshot PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
-  ::raftpb::SnapshotMetadata* metadata_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
+    ::raftpb::SnapshotMetadata* metadata_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Message PROTOBUF_FINAL :
+class Message final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.Message) */ {
  public:
   inline Message() : Message(nullptr) {}
-  virtual ~Message();
+  ~Message() override;
+  explicit PROTOBUF_CONSTEXPR Message(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Message(const Message& from);
   Message(Message&& from) noexcept
@@ -911,8 +972,13 @@ class Message PROTOBUF_FINAL :
     return *this;
   }
   inline Message& operator=(Message&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -930,13 +996,14 @@ class Message PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Message& default_instance() {
+    return *internal_default_instance();
   }
-  static const Message& default_instance();
-
   static inline const Message* internal_default_instance() {
     return reinterpret_cast<const Message*>(
                &_Message_default_instance_);
@@ -949,7 +1016,12 @@ class Message PROTOBUF_FINAL :
   }
   inline void Swap(Message* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -957,56 +1029,53 @@ class Message PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(Message* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline Message* New() const final {
-    return CreateMaybeMessage<Message>(nullptr);
-  }
-
-  Message* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  Message* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Message>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Message& from);
-  void MergeFrom(const Message& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Message& from) {
+    Message::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Message* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.Message";
   }
   protected:
-  explicit Message(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit Message(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1020,11 +1089,13 @@ class Message PROTOBUF_FINAL :
     kFromFieldNumber = 3,
     kTermFieldNumber = 4,
     kLogTermFieldNumber = 5,
-    kTypeFieldNumber = 1,
-    kRejectFieldNumber = 10,
     kIndexFieldNumber = 6,
     kCommitFieldNumber = 8,
+    kTypeFieldNumber = 1,
+    kRejectFieldNumber = 10,
+    kQuiesceFieldNumber = 13,
     kRejectHintFieldNumber = 11,
+    kLeaseSentAtFieldNumber = 14,
   };
   // repeated .raftpb.Entry entries = 7;
   int entries_size() const;
@@ -1051,16 +1122,14 @@ class Message PROTOBUF_FINAL :
   public:
   void clear_context();
   const std::string& context() const;
-  void set_context(const std::string& value);
-  void set_context(std::string&& value);
-  void set_context(const char* value);
-  void set_context(const void* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_context(ArgT0&& arg0, ArgT... args);
   std::string* mutable_context();
-  std::string* release_context();
+  PROTOBUF_NODISCARD std::string* release_context();
   void set_allocated_context(std::string* context);
   private:
   const std::string& _internal_context() const;
-  void _internal_set_context(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_context(const std::string& value);
   std::string* _internal_mutable_context();
   public:
 
@@ -1071,7 +1140,7 @@ class Message PROTOBUF_FINAL :
   public:
   void clear_snapshot();
   const ::raftpb::Snapshot& snapshot() const;
-  ::raftpb::Snapshot* release_snapshot();
+  PROTOBUF_NODISCARD ::raftpb::Snapshot* release_snapshot();
   ::raftpb::Snapshot* mutable_snapshot();
   void set_allocated_snapshot(::raftpb::Snapshot* snapshot);
   private:
@@ -1088,11 +1157,11 @@ class Message PROTOBUF_FINAL :
   bool _internal_has_to() const;
   public:
   void clear_to();
-  ::PROTOBUF_NAMESPACE_ID::uint64 to() const;
-  void set_to(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t to() const;
+  void set_to(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_to() const;
-  void _internal_set_to(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_to() const;
+  void _internal_set_to(uint64_t value);
   public:
 
   // optional uint64 from = 3;
@@ -1101,11 +1170,11 @@ class Message PROTOBUF_FINAL :
   bool _internal_has_from() const;
   public:
   void clear_from();
-  ::PROTOBUF_NAMESPACE_ID::uint64 from() const;
-  void set_from(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t from() const;
+  void set_from(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_from() const;
-  void _internal_set_from(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_from() const;
+  void _internal_set_from(uint64_t value);
   public:
 
   // optional uint64 term = 4;
@@ -1114,11 +1183,11 @@ class Message PROTOBUF_FINAL :
   bool _internal_has_term() const;
   public:
   void clear_term();
-  ::PROTOBUF_NAMESPACE_ID::uint64 term() const;
-  void set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t term() const;
+  void set_term(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_term() const;
-  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_term() const;
+  void _internal_set_term(uint64_t value);
   public:
 
   // optional uint64 logTerm = 5;
@@ -1127,11 +1196,37 @@ class Message PROTOBUF_FINAL :
   bool _internal_has_logterm() const;
   public:
   void clear_logterm();
-  ::PROTOBUF_NAMESPACE_ID::uint64 logterm() const;
-  void set_logterm(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t logterm() const;
+  void set_logterm(uint64_t value);
+  private:
+  uint64_t _internal_logterm() const;
+  void _internal_set_logterm(uint64_t value);
+  public:
+
+  // optional uint64 index = 6;
+  bool has_index() const;
+  private:
+  bool _internal_has_index() const;
+  public:
+  void clear_index();
+  uint64_t index() const;
+  void set_index(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_logterm() const;
-  void _internal_set_logterm(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_index() const;
+  void _internal_set_index(uint64_t value);
+  public:
+
+  // optional uint64 commit = 8;
+  bool has_commit() const;
+  private:
+  bool _internal_has_commit() const;
+  public:
+  void clear_commit();
+  uint64_t commit() const;
+  void set_commit(uint64_t value);
+  private:
+  uint64_t _internal_commit() const;
+  void _internal_set_commit(uint64_t value);
   public:
 
   // optional .raftpb.MessageType type = 1;
@@ -1160,43 +1255,43 @@ class Message PROTOBUF_FINAL :
   void _internal_set_reject(bool value);
   public:
 
-  // optional uint64 index = 6;
-  bool has_index() const;
+  // optional bool quiesce = 13;
+  bool has_quiesce() const;
   private:
-  bool _internal_has_index() const;
+  bool _internal_has_quiesce() const;
   public:
-  void clear_index();
-  ::PROTOBUF_NAMESPACE_ID::uint64 index() const;
-  void set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  void clear_quiesce();
+  bool quiesce() const;
+  void set_quiesce(bool value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_index() const;
-  void _internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  bool _internal_quiesce() const;
+  void _internal_set_quiesce(bool value);
   public:
 
-  // optional uint64 commit = 8;
-  bool has_commit() const;
+  // optional uint64 rejectHint = 11;
+  bool has_rejecthint() const;
   private:
-  bool _internal_has_commit() const;
+  bool _internal_has_rejecthint() const;
   public:
-  void clear_commit();
-  ::PROTOBUF_NAMESPACE_ID::uint64 commit() const;
-  void set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  void clear_rejecthint();
+  uint64_t rejecthint() const;
+  void set_rejecthint(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_commit() const;
-  void _internal_set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_rejecthint() const;
+  void _internal_set_rejecthint(uint64_t value);
   public:
 
-  // optional uint64 rejectHint = 11;
-  bool has_rejecthint() const;
+  // optional uint64 leaseSentAt = 14;
+  bool has_leasesentat() const;
   private:
-  bool _internal_has_rejecthint() const;
+  bool _internal_has_leasesentat() const;
   public:
-  void clear_rejecthint();
-  ::PROTOBUF_NAMESPACE_ID::uint64 rejecthint() const;
-  void set_rejecthint(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  void clear_leasesentat();
+  uint64_t leasesentat() const;
+  void set_leasesentat(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_rejecthint() const;
-  void _internal_set_rejecthint(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_leasesentat() const;
+  void _internal_set_leasesentat(uint64_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:raftpb.Message)
@@ -1206,29 +1301,35 @@ class Message PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::raftpb::Entry > entries_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr context_;
-  ::raftpb::Snapshot* snapshot_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 to_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 from_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 term_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 logterm_;
-  int type_;
-  bool reject_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 index_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 commit_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 rejecthint_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::raftpb::Entry > entries_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr context_;
+    ::raftpb::Snapshot* snapshot_;
+    uint64_t to_;
+    uint64_t from_;
+    uint64_t term_;
+    uint64_t logterm_;
+    uint64_t index_;
+    uint64_t commit_;
+    int type_;
+    bool reject_;
+    bool quiesce_;
+    uint64_t rejecthint_;
+    uint64_t leasesentat_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class HardState PROTOBUF_FINAL :
+class HardState final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.HardState) */ {
  public:
   inline HardState() : HardState(nullptr) {}
-  virtual ~HardState();
+  ~HardState() override;
+  explicit PROTOBUF_CONSTEXPR HardState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   HardState(const HardState& from);
   HardState(HardState&& from) noexcept
@@ -1241,8 +1342,13 @@ class HardState PROTOBUF_FINAL :
     return *this;
   }
   inline HardState& operator=(HardState&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1260,13 +1366,14 @@ class HardState PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HardState& default_instance() {
+    return *internal_default_instance();
   }
-  static const HardState& default_instance();
-
   static inline const HardState* internal_default_instance() {
     return reinterpret_cast<const HardState*>(
                &_HardState_default_instance_);
@@ -1279,7 +1386,12 @@ class HardState PROTOBUF_FINAL :
   }
   inline void Swap(HardState* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1287,56 +1399,53 @@ class HardState PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(HardState* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline HardState* New() const final {
-    return CreateMaybeMessage<HardState>(nullptr);
-  }
-
-  HardState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  HardState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<HardState>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const HardState& from);
-  void MergeFrom(const HardState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HardState& from) {
+    HardState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(HardState* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.HardState";
   }
   protected:
-  explicit HardState(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit HardState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1353,11 +1462,11 @@ class HardState PROTOBUF_FINAL :
   bool _internal_has_term() const;
   public:
   void clear_term();
-  ::PROTOBUF_NAMESPACE_ID::uint64 term() const;
-  void set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t term() const;
+  void set_term(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_term() const;
-  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_term() const;
+  void _internal_set_term(uint64_t value);
   public:
 
   // optional uint64 vote = 2;
@@ -1366,11 +1475,11 @@ class HardState PROTOBUF_FINAL :
   bool _internal_has_vote() const;
   public:
   void clear_vote();
-  ::PROTOBUF_NAMESPACE_ID::uint64 vote() const;
-  void set_vote(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t vote() const;
+  void set_vote(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_vote() const;
-  void _internal_set_vote(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_vote() const;
+  void _internal_set_vote(uint64_t value);
   public:
 
   // optional uint64 commit = 3;
@@ -1379,11 +1488,11 @@ class HardState PROTOBUF_FINAL :
   bool _internal_has_commit() const;
   public:
   void clear_commit();
-  ::PROTOBUF_NAMESPACE_ID::uint64 commit() const;
-  void set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t commit() const;
+  void set_commit(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_commit() const;
-  void _internal_set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_commit() const;
+  void _internal_set_commit(uint64_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:raftpb.HardState)
@@ -1393,20 +1502,24 @@ class HardState PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 term_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 vote_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 commit_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t term_;
+    uint64_t vote_;
+    uint64_t commit_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ConfChange PROTOBUF_FINAL :
+class ConfChange final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:raftpb.ConfChange) */ {
  public:
   inline ConfChange() : ConfChange(nullptr) {}
-  virtual ~ConfChange();
+  ~ConfChange() override;
+  explicit PROTOBUF_CONSTEXPR ConfChange(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ConfChange(const ConfChange& from);
   ConfChange(ConfChange&& from) noexcept
@@ -1419,8 +1532,13 @@ class ConfChange PROTOBUF_FINAL :
     return *this;
   }
   inline ConfChange& operator=(ConfChange&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1438,13 +1556,14 @@ class ConfChange PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ConfChange& default_instance() {
+    return *internal_default_instance();
   }
-  static const ConfChange& default_instance();
-
   static inline const ConfChange* internal_default_instance() {
     return reinterpret_cast<const ConfChange*>(
                &_ConfChange_default_instance_);
@@ -1457,7 +1576,12 @@ class ConfChange PROTOBUF_FINAL :
   }
   inline void Swap(ConfChange* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1465,56 +1589,53 @@ class ConfChange PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(ConfChange* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline ConfChange* New() const final {
-    return CreateMaybeMessage<ConfChange>(nullptr);
-  }
-
-  ConfChange* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  ConfChange* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<ConfChange>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ConfChange& from);
-  void MergeFrom(const ConfChange& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ConfChange& from) {
+    ConfChange::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(ConfChange* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "raftpb.ConfChange";
   }
   protected:
-  explicit ConfChange(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit ConfChange(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_src_2fproto_2fraft_2eproto);
-    return ::descriptor_table_src_2fproto_2fraft_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1533,16 +1654,14 @@ class ConfChange PROTOBUF_FINAL :
   public:
   void clear_context();
   const std::string& context() const;
-  void set_context(const std::string& value);
-  void set_context(std::string&& value);
-  void set_context(const char* value);
-  void set_context(const void* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_context(ArgT0&& arg0, ArgT... args);
   std::string* mutable_context();
-  std::string* release_context();
+  PROTOBUF_NODISCARD std::string* release_context();
   void set_allocated_context(std::string* context);
   private:
   const std::string& _internal_context() const;
-  void _internal_set_context(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_context(const std::string& value);
   std::string* _internal_mutable_context();
   public:
 
@@ -1552,11 +1671,11 @@ class ConfChange PROTOBUF_FINAL :
   bool _internal_has_id() const;
   public:
   void clear_id();
-  ::PROTOBUF_NAMESPACE_ID::uint64 id() const;
-  void set_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t id() const;
+  void set_id(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_id() const;
-  void _internal_set_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_id() const;
+  void _internal_set_id(uint64_t value);
   public:
 
   // optional uint64 NodeID = 3;
@@ -1565,11 +1684,11 @@ class ConfChange PROTOBUF_FINAL :
   bool _internal_has_nodeid() const;
   public:
   void clear_nodeid();
-  ::PROTOBUF_NAMESPACE_ID::uint64 nodeid() const;
-  void set_nodeid(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t nodeid() const;
+  void set_nodeid(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_nodeid() const;
-  void _internal_set_nodeid(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_nodeid() const;
+  void _internal_set_nodeid(uint64_t value);
   public:
 
   // optional .raftpb.ConfChangeType Type = 2;
@@ -1592,12 +1711,15 @@ class ConfChange PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr context_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 id_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 nodeid_;
-  int type_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr context_;
+    uint64_t id_;
+    uint64_t nodeid_;
+    int type_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_src_2fproto_2fraft_2eproto;
 };
 // ===================================================================
@@ -1613,18 +1735,18 @@ class ConfChange PROTOBUF_FINAL :
 
 // required .raftpb.EntryType Type = 1;
 inline bool Entry::_internal_has_type() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool Entry::has_type() const {
   return _internal_has_type();
 }
 inline void Entry::clear_type() {
-  type_ = 0;
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
 inline ::raftpb::EntryType Entry::_internal_type() const {
-  return static_cast< ::raftpb::EntryType >(type_);
+  return static_cast< ::raftpb::EntryType >(_impl_.type_);
 }
 inline ::raftpb::EntryType Entry::type() const {
   // @@protoc_insertion_point(field_get:raftpb.Entry.Type)
@@ -1632,8 +1754,8 @@ inline ::raftpb::EntryType Entry::type() const {
 }
 inline void Entry::_internal_set_type(::raftpb::EntryType value) {
   assert(::raftpb::EntryType_IsValid(value));
-  _has_bits_[0] |= 0x00000008u;
-  type_ = value;
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.type_ = value;
 }
 inline void Entry::set_type(::raftpb::EntryType value) {
   _internal_set_type(value);
@@ -1642,130 +1764,125 @@ inline void Entry::set_type(::raftpb::EntryType value) {
 
 // required uint64 Term = 2;
 inline bool Entry::_internal_has_term() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool Entry::has_term() const {
   return _internal_has_term();
 }
 inline void Entry::clear_term() {
-  term_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.term_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Entry::_internal_term() const {
-  return term_;
+inline uint64_t Entry::_internal_term() const {
+  return _impl_.term_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Entry::term() const {
+inline uint64_t Entry::term() const {
   // @@protoc_insertion_point(field_get:raftpb.Entry.Term)
   return _internal_term();
 }
-inline void Entry::_internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000002u;
-  term_ = value;
+inline void Entry::_internal_set_term(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.term_ = value;
 }
-inline void Entry::set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Entry::set_term(uint64_t value) {
   _internal_set_term(value);
   // @@protoc_insertion_point(field_set:raftpb.Entry.Term)
 }
 
 // required uint64 Index = 3;
 inline bool Entry::_internal_has_index() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool Entry::has_index() const {
   return _internal_has_index();
 }
 inline void Entry::clear_index() {
-  index_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.index_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Entry::_internal_index() const {
-  return index_;
+inline uint64_t Entry::_internal_index() const {
+  return _impl_.index_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Entry::index() const {
+inline uint64_t Entry::index() const {
   // @@protoc_insertion_point(field_get:raftpb.Entry.Index)
   return _internal_index();
 }
-inline void Entry::_internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000004u;
-  index_ = value;
+inline void Entry::_internal_set_index(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.index_ = value;
 }
-inline void Entry::set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Entry::set_index(uint64_t value) {
   _internal_set_index(value);
   // @@protoc_insertion_point(field_set:raftpb.Entry.Index)
 }
 
 // optional bytes Data = 4;
 inline bool Entry::_internal_has_data() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool Entry::has_data() const {
   return _internal_has_data();
 }
 inline void Entry::clear_data() {
-  data_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.data_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& Entry::data() const {
   // @@protoc_insertion_point(field_get:raftpb.Entry.Data)
   return _internal_data();
 }
-inline void Entry::set_data(const std::string& value) {
-  _internal_set_data(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Entry::set_data(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.data_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:raftpb.Entry.Data)
 }
 inline std::string* Entry::mutable_data() {
+  std::string* _s = _internal_mutable_data();
   // @@protoc_insertion_point(field_mutable:raftpb.Entry.Data)
-  return _internal_mutable_data();
+  return _s;
 }
 inline const std::string& Entry::_internal_data() const {
-  return data_.Get();
+  return _impl_.data_.Get();
 }
 inline void Entry::_internal_set_data(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void Entry::set_data(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:raftpb.Entry.Data)
-}
-inline void Entry::set_data(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:raftpb.Entry.Data)
-}
-inline void Entry::set_data(const void* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:raftpb.Entry.Data)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.data_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Entry::_internal_mutable_data() {
-  _has_bits_[0] |= 0x00000001u;
-  return data_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.data_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Entry::release_data() {
   // @@protoc_insertion_point(field_release:raftpb.Entry.Data)
   if (!_internal_has_data()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return data_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.data_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Entry::set_allocated_data(std::string* data) {
   if (data != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.data_.SetAllocated(data, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
   }
-  data_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), data,
-      GetArena());
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:raftpb.Entry.Data)
 }
 
@@ -1775,70 +1892,117 @@ inline void Entry::set_allocated_data(std::string* data) {
 
 // repeated uint64 nodes = 1;
 inline int ConfState::_internal_nodes_size() const {
-  return nodes_.size();
+  return _impl_.nodes_.size();
 }
 inline int ConfState::nodes_size() const {
   return _internal_nodes_size();
 }
 inline void ConfState::clear_nodes() {
-  nodes_.Clear();
+  _impl_.nodes_.Clear();
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfState::_internal_nodes(int index) const {
-  return nodes_.Get(index);
+inline uint64_t ConfState::_internal_nodes(int index) const {
+  return _impl_.nodes_.Get(index);
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfState::nodes(int index) const {
+inline uint64_t ConfState::nodes(int index) const {
   // @@protoc_insertion_point(field_get:raftpb.ConfState.nodes)
   return _internal_nodes(index);
 }
-inline void ConfState::set_nodes(int index, ::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  nodes_.Set(index, value);
+inline void ConfState::set_nodes(int index, uint64_t value) {
+  _impl_.nodes_.Set(index, value);
   // @@protoc_insertion_point(field_set:raftpb.ConfState.nodes)
 }
-inline void ConfState::_internal_add_nodes(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  nodes_.Add(value);
+inline void ConfState::_internal_add_nodes(uint64_t value) {
+  _impl_.nodes_.Add(value);
 }
-inline void ConfState::add_nodes(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void ConfState::add_nodes(uint64_t value) {
   _internal_add_nodes(value);
   // @@protoc_insertion_point(field_add:raftpb.ConfState.nodes)
 }
-inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
 ConfState::_internal_nodes() const {
-  return nodes_;
+  return _impl_.nodes_;
 }
-inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
 ConfState::nodes() const {
   // @@protoc_insertion_point(field_list:raftpb.ConfState.nodes)
   return _internal_nodes();
 }
-inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
 ConfState::_internal_mutable_nodes() {
-  return &nodes_;
+  return &_impl_.nodes_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::uint64 >*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
 ConfState::mutable_nodes() {
   // @@protoc_insertion_point(field_mutable_list:raftpb.ConfState.nodes)
   return _internal_mutable_nodes();
 }
 
+// repeated uint64 learners = 2;
+inline int ConfState::_internal_learners_size() const {
+  return _impl_.learners_.size();
+}
+inline int ConfState::learners_size() const {
+  return _internal_learners_size();
+}
+inline void ConfState::clear_learners() {
+  _impl_.learners_.Clear();
+}
+inline uint64_t ConfState::_internal_learners(int index) const {
+  return _impl_.learners_.Get(index);
+}
+inline uint64_t ConfState::learners(int index) const {
+  // @@protoc_insertion_point(field_get:raftpb.ConfState.learners)
+  return _internal_learners(index);
+}
+inline void ConfState::set_learners(int index, uint64_t value) {
+  _impl_.learners_.Set(index, value);
+  // @@protoc_insertion_point(field_set:raftpb.ConfState.learners)
+}
+inline void ConfState::_internal_add_learners(uint64_t value) {
+  _impl_.learners_.Add(value);
+}
+inline void ConfState::add_learners(uint64_t value) {
+  _internal_add_learners(value);
+  // @@protoc_insertion_point(field_add:raftpb.ConfState.learners)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+ConfState::_internal_learners() const {
+  return _impl_.learners_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+ConfState::learners() const {
+  // @@protoc_insertion_point(field_list:raftpb.ConfState.learners)
+  return _internal_learners();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+ConfState::_internal_mutable_learners() {
+  return &_impl_.learners_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+ConfState::mutable_learners() {
+  // @@protoc_insertion_point(field_mutable_list:raftpb.ConfState.learners)
+  return _internal_mutable_learners();
+}
+
 // -------------------------------------------------------------------
 
 // SnapshotMetadata
 
 // optional .raftpb.ConfState conf_state = 1;
 inline bool SnapshotMetadata::_internal_has_conf_state() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
-  PROTOBUF_ASSUME(!value || conf_state_ != nullptr);
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.conf_state_ != nullptr);
   return value;
 }
 inline bool SnapshotMetadata::has_conf_state() const {
   return _internal_has_conf_state();
 }
 inline void SnapshotMetadata::clear_conf_state() {
-  if (conf_state_ != nullptr) conf_state_->Clear();
-  _has_bits_[0] &= ~0x00000001u;
+  if (_impl_.conf_state_ != nullptr) _impl_.conf_state_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const ::raftpb::ConfState& SnapshotMetadata::_internal_conf_state() const {
-  const ::raftpb::ConfState* p = conf_state_;
+  const ::raftpb::ConfState* p = _impl_.conf_state_;
   return p != nullptr ? *p : reinterpret_cast<const ::raftpb::ConfState&>(
       ::raftpb::_ConfState_default_instance_);
 }
@@ -1848,117 +2012,124 @@ inline const ::raftpb::ConfState& SnapshotMetadata::conf_state() const {
 }
 inline void SnapshotMetadata::unsafe_arena_set_allocated_conf_state(
     ::raftpb::ConfState* conf_state) {
-  if (GetArena() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(conf_state_);
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.conf_state_);
   }
-  conf_state_ = conf_state;
+  _impl_.conf_state_ = conf_state;
   if (conf_state) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:raftpb.SnapshotMetadata.conf_state)
 }
 inline ::raftpb::ConfState* SnapshotMetadata::release_conf_state() {
-  _has_bits_[0] &= ~0x00000001u;
-  ::raftpb::ConfState* temp = conf_state_;
-  conf_state_ = nullptr;
-  if (GetArena() != nullptr) {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::raftpb::ConfState* temp = _impl_.conf_state_;
+  _impl_.conf_state_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
     temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
   }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
   return temp;
 }
 inline ::raftpb::ConfState* SnapshotMetadata::unsafe_arena_release_conf_state() {
   // @@protoc_insertion_point(field_release:raftpb.SnapshotMetadata.conf_state)
-  _has_bits_[0] &= ~0x00000001u;
-  ::raftpb::ConfState* temp = conf_state_;
-  conf_state_ = nullptr;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::raftpb::ConfState* temp = _impl_.conf_state_;
+  _impl_.conf_state_ = nullptr;
   return temp;
 }
 inline ::raftpb::ConfState* SnapshotMetadata::_internal_mutable_conf_state() {
-  _has_bits_[0] |= 0x00000001u;
-  if (conf_state_ == nullptr) {
-    auto* p = CreateMaybeMessage<::raftpb::ConfState>(GetArena());
-    conf_state_ = p;
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.conf_state_ == nullptr) {
+    auto* p = CreateMaybeMessage<::raftpb::ConfState>(GetArenaForAllocation());
+    _impl_.conf_state_ = p;
   }
-  return conf_state_;
+  return _impl_.conf_state_;
 }
 inline ::raftpb::ConfState* SnapshotMetadata::mutable_conf_state() {
+  ::raftpb::ConfState* _msg = _internal_mutable_conf_state();
   // @@protoc_insertion_point(field_mutable:raftpb.SnapshotMetadata.conf_state)
-  return _internal_mutable_conf_state();
+  return _msg;
 }
 inline void SnapshotMetadata::set_allocated_conf_state(::raftpb::ConfState* conf_state) {
-  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete conf_state_;
+    delete _impl_.conf_state_;
   }
   if (conf_state) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
-      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(conf_state);
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(conf_state);
     if (message_arena != submessage_arena) {
       conf_state = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
           message_arena, conf_state, submessage_arena);
     }
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  conf_state_ = conf_state;
+  _impl_.conf_state_ = conf_state;
   // @@protoc_insertion_point(field_set_allocated:raftpb.SnapshotMetadata.conf_state)
 }
 
 // optional uint64 index = 2;
 inline bool SnapshotMetadata::_internal_has_index() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool SnapshotMetadata::has_index() const {
   return _internal_has_index();
 }
 inline void SnapshotMetadata::clear_index() {
-  index_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.index_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 SnapshotMetadata::_internal_index() const {
-  return index_;
+inline uint64_t SnapshotMetadata::_internal_index() const {
+  return _impl_.index_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 SnapshotMetadata::index() const {
+inline uint64_t SnapshotMetadata::index() const {
   // @@protoc_insertion_point(field_get:raftpb.SnapshotMetadata.index)
   return _internal_index();
 }
-inline void SnapshotMetadata::_internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000002u;
-  index_ = value;
+inline void SnapshotMetadata::_internal_set_index(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.index_ = value;
 }
-inline void SnapshotMetadata::set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void SnapshotMetadata::set_index(uint64_t value) {
   _internal_set_index(value);
   // @@protoc_insertion_point(field_set:raftpb.SnapshotMetadata.index)
 }
 
 // optional uint64 term = 3;
 inline bool SnapshotMetadata::_internal_has_term() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool SnapshotMetadata::has_term() const {
   return _internal_has_term();
 }
 inline void SnapshotMetadata::clear_term() {
-  term_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.term_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 SnapshotMetadata::_internal_term() const {
-  return term_;
+inline uint64_t SnapshotMetadata::_internal_term() const {
+  return _impl_.term_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 SnapshotMetadata::term() const {
+inline uint64_t SnapshotMetadata::term() const {
   // @@protoc_insertion_point(field_get:raftpb.SnapshotMetadata.term)
   return _internal_term();
 }
-inline void SnapshotMetadata::_internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000004u;
-  term_ = value;
+inline void SnapshotMetadata::_internal_set_term(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.term_ = value;
 }
-inline void SnapshotMetadata::set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void SnapshotMetadata::set_term(uint64_t value) {
   _internal_set_term(value);
   // @@protoc_insertion_point(field_set:raftpb.SnapshotMetadata.term)
 }
@@ -1969,92 +2140,87 @@ inline void SnapshotMetadata::set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
 
 // optional bytes data = 1;
 inline bool Snapshot::_internal_has_data() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool Snapshot::has_data() const {
   return _internal_has_data();
 }
 inline void Snapshot::clear_data() {
-  data_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.data_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& Snapshot::data() const {
   // @@protoc_insertion_point(field_get:raftpb.Snapshot.data)
   return _internal_data();
 }
-inline void Snapshot::set_data(const std::string& value) {
-  _internal_set_data(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Snapshot::set_data(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.data_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:raftpb.Snapshot.data)
 }
 inline std::string* Snapshot::mutable_data() {
+  std::string* _s = _internal_mutable_data();
   // @@protoc_insertion_point(field_mutable:raftpb.Snapshot.data)
-  return _internal_mutable_data();
+  return _s;
 }
 inline const std::string& Snapshot::_internal_data() const {
-  return data_.Get();
+  return _impl_.data_.Get();
 }
 inline void Snapshot::_internal_set_data(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void Snapshot::set_data(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:raftpb.Snapshot.data)
-}
-inline void Snapshot::set_data(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:raftpb.Snapshot.data)
-}
-inline void Snapshot::set_data(const void* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  data_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:raftpb.Snapshot.data)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.data_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Snapshot::_internal_mutable_data() {
-  _has_bits_[0] |= 0x00000001u;
-  return data_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.data_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Snapshot::release_data() {
   // @@protoc_insertion_point(field_release:raftpb.Snapshot.data)
   if (!_internal_has_data()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return data_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.data_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Snapshot::set_allocated_data(std::string* data) {
   if (data != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.data_.SetAllocated(data, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
   }
-  data_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), data,
-      GetArena());
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:raftpb.Snapshot.data)
 }
 
 // optional .raftpb.SnapshotMetadata metadata = 2;
 inline bool Snapshot::_internal_has_metadata() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
-  PROTOBUF_ASSUME(!value || metadata_ != nullptr);
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.metadata_ != nullptr);
   return value;
 }
 inline bool Snapshot::has_metadata() const {
   return _internal_has_metadata();
 }
 inline void Snapshot::clear_metadata() {
-  if (metadata_ != nullptr) metadata_->Clear();
-  _has_bits_[0] &= ~0x00000002u;
+  if (_impl_.metadata_ != nullptr) _impl_.metadata_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
 inline const ::raftpb::SnapshotMetadata& Snapshot::_internal_metadata() const {
-  const ::raftpb::SnapshotMetadata* p = metadata_;
+  const ::raftpb::SnapshotMetadata* p = _impl_.metadata_;
   return p != nullptr ? *p : reinterpret_cast<const ::raftpb::SnapshotMetadata&>(
       ::raftpb::_SnapshotMetadata_default_instance_);
 }
@@ -2064,62 +2230,69 @@ inline const ::raftpb::SnapshotMetadata& Snapshot::metadata() const {
 }
 inline void Snapshot::unsafe_arena_set_allocated_metadata(
     ::raftpb::SnapshotMetadata* metadata) {
-  if (GetArena() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(metadata_);
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.metadata_);
   }
-  metadata_ = metadata;
+  _impl_.metadata_ = metadata;
   if (metadata) {
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:raftpb.Snapshot.metadata)
 }
 inline ::raftpb::SnapshotMetadata* Snapshot::release_metadata() {
-  _has_bits_[0] &= ~0x00000002u;
-  ::raftpb::SnapshotMetadata* temp = metadata_;
-  metadata_ = nullptr;
-  if (GetArena() != nullptr) {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::raftpb::SnapshotMetadata* temp = _impl_.metadata_;
+  _impl_.metadata_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
     temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
   }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
   return temp;
 }
 inline ::raftpb::SnapshotMetadata* Snapshot::unsafe_arena_release_metadata() {
   // @@protoc_insertion_point(field_release:raftpb.Snapshot.metadata)
-  _has_bits_[0] &= ~0x00000002u;
-  ::raftpb::SnapshotMetadata* temp = metadata_;
-  metadata_ = nullptr;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::raftpb::SnapshotMetadata* temp = _impl_.metadata_;
+  _impl_.metadata_ = nullptr;
   return temp;
 }
 inline ::raftpb::SnapshotMetadata* Snapshot::_internal_mutable_metadata() {
-  _has_bits_[0] |= 0x00000002u;
-  if (metadata_ == nullptr) {
-    auto* p = CreateMaybeMessage<::raftpb::SnapshotMetadata>(GetArena());
-    metadata_ = p;
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.metadata_ == nullptr) {
+    auto* p = CreateMaybeMessage<::raftpb::SnapshotMetadata>(GetArenaForAllocation());
+    _impl_.metadata_ = p;
   }
-  return metadata_;
+  return _impl_.metadata_;
 }
 inline ::raftpb::SnapshotMetadata* Snapshot::mutable_metadata() {
+  ::raftpb::SnapshotMetadata* _msg = _internal_mutable_metadata();
   // @@protoc_insertion_point(field_mutable:raftpb.Snapshot.metadata)
-  return _internal_mutable_metadata();
+  return _msg;
 }
 inline void Snapshot::set_allocated_metadata(::raftpb::SnapshotMetadata* metadata) {
-  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete metadata_;
+    delete _impl_.metadata_;
   }
   if (metadata) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
-      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(metadata);
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(metadata);
     if (message_arena != submessage_arena) {
       metadata = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
           message_arena, metadata, submessage_arena);
     }
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
-  metadata_ = metadata;
+  _impl_.metadata_ = metadata;
   // @@protoc_insertion_point(field_set_allocated:raftpb.Snapshot.metadata)
 }
 
@@ -2129,18 +2302,18 @@ inline void Snapshot::set_allocated_metadata(::raftpb::SnapshotMetadata* metadat
 
 // optional .raftpb.MessageType type = 1;
 inline bool Message::_internal_has_type() const {
-  bool value = (_has_bits_[0] & 0x00000040u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000100u) != 0;
   return value;
 }
 inline bool Message::has_type() const {
   return _internal_has_type();
 }
 inline void Message::clear_type() {
-  type_ = 0;
-  _has_bits_[0] &= ~0x00000040u;
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000100u;
 }
 inline ::raftpb::MessageType Message::_internal_type() const {
-  return static_cast< ::raftpb::MessageType >(type_);
+  return static_cast< ::raftpb::MessageType >(_impl_.type_);
 }
 inline ::raftpb::MessageType Message::type() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.type)
@@ -2148,8 +2321,8 @@ inline ::raftpb::MessageType Message::type() const {
 }
 inline void Message::_internal_set_type(::raftpb::MessageType value) {
   assert(::raftpb::MessageType_IsValid(value));
-  _has_bits_[0] |= 0x00000040u;
-  type_ = value;
+  _impl_._has_bits_[0] |= 0x00000100u;
+  _impl_.type_ = value;
 }
 inline void Message::set_type(::raftpb::MessageType value) {
   _internal_set_type(value);
@@ -2158,226 +2331,227 @@ inline void Message::set_type(::raftpb::MessageType value) {
 
 // optional uint64 to = 2;
 inline bool Message::_internal_has_to() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool Message::has_to() const {
   return _internal_has_to();
 }
 inline void Message::clear_to() {
-  to_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.to_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_to() const {
-  return to_;
+inline uint64_t Message::_internal_to() const {
+  return _impl_.to_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::to() const {
+inline uint64_t Message::to() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.to)
   return _internal_to();
 }
-inline void Message::_internal_set_to(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000004u;
-  to_ = value;
+inline void Message::_internal_set_to(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.to_ = value;
 }
-inline void Message::set_to(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_to(uint64_t value) {
   _internal_set_to(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.to)
 }
 
 // optional uint64 from = 3;
 inline bool Message::_internal_has_from() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool Message::has_from() const {
   return _internal_has_from();
 }
 inline void Message::clear_from() {
-  from_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.from_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_from() const {
-  return from_;
+inline uint64_t Message::_internal_from() const {
+  return _impl_.from_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::from() const {
+inline uint64_t Message::from() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.from)
   return _internal_from();
 }
-inline void Message::_internal_set_from(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000008u;
-  from_ = value;
+inline void Message::_internal_set_from(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.from_ = value;
 }
-inline void Message::set_from(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_from(uint64_t value) {
   _internal_set_from(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.from)
 }
 
 // optional uint64 term = 4;
 inline bool Message::_internal_has_term() const {
-  bool value = (_has_bits_[0] & 0x00000010u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
   return value;
 }
 inline bool Message::has_term() const {
   return _internal_has_term();
 }
 inline void Message::clear_term() {
-  term_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000010u;
+  _impl_.term_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000010u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_term() const {
-  return term_;
+inline uint64_t Message::_internal_term() const {
+  return _impl_.term_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::term() const {
+inline uint64_t Message::term() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.term)
   return _internal_term();
 }
-inline void Message::_internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000010u;
-  term_ = value;
+inline void Message::_internal_set_term(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.term_ = value;
 }
-inline void Message::set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_term(uint64_t value) {
   _internal_set_term(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.term)
 }
 
 // optional uint64 logTerm = 5;
 inline bool Message::_internal_has_logterm() const {
-  bool value = (_has_bits_[0] & 0x00000020u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
   return value;
 }
 inline bool Message::has_logterm() const {
   return _internal_has_logterm();
 }
 inline void Message::clear_logterm() {
-  logterm_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000020u;
+  _impl_.logterm_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000020u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_logterm() const {
-  return logterm_;
+inline uint64_t Message::_internal_logterm() const {
+  return _impl_.logterm_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::logterm() const {
+inline uint64_t Message::logterm() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.logTerm)
   return _internal_logterm();
 }
-inline void Message::_internal_set_logterm(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000020u;
-  logterm_ = value;
+inline void Message::_internal_set_logterm(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.logterm_ = value;
 }
-inline void Message::set_logterm(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_logterm(uint64_t value) {
   _internal_set_logterm(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.logTerm)
 }
 
 // optional uint64 index = 6;
 inline bool Message::_internal_has_index() const {
-  bool value = (_has_bits_[0] & 0x00000100u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
   return value;
 }
 inline bool Message::has_index() const {
   return _internal_has_index();
 }
 inline void Message::clear_index() {
-  index_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000100u;
+  _impl_.index_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000040u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_index() const {
-  return index_;
+inline uint64_t Message::_internal_index() const {
+  return _impl_.index_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::index() const {
+inline uint64_t Message::index() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.index)
   return _internal_index();
 }
-inline void Message::_internal_set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000100u;
-  index_ = value;
+inline void Message::_internal_set_index(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.index_ = value;
 }
-inline void Message::set_index(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_index(uint64_t value) {
   _internal_set_index(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.index)
 }
 
 // repeated .raftpb.Entry entries = 7;
 inline int Message::_internal_entries_size() const {
-  return entries_.size();
+  return _impl_.entries_.size();
 }
 inline int Message::entries_size() const {
   return _internal_entries_size();
 }
 inline void Message::clear_entries() {
-  entries_.Clear();
+  _impl_.entries_.Clear();
 }
 inline ::raftpb::Entry* Message::mutable_entries(int index) {
   // @@protoc_insertion_point(field_mutable:raftpb.Message.entries)
-  return entries_.Mutable(index);
+  return _impl_.entries_.Mutable(index);
 }
 inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::raftpb::Entry >*
 Message::mutable_entries() {
   // @@protoc_insertion_point(field_mutable_list:raftpb.Message.entries)
-  return &entries_;
+  return &_impl_.entries_;
 }
 inline const ::raftpb::Entry& Message::_internal_entries(int index) const {
-  return entries_.Get(index);
+  return _impl_.entries_.Get(index);
 }
 inline const ::raftpb::Entry& Message::entries(int index) const {
   // @@protoc_insertion_point(field_get:raftpb.Message.entries)
   return _internal_entries(index);
 }
 inline ::raftpb::Entry* Message::_internal_add_entries() {
-  return entries_.Add();
+  return _impl_.entries_.Add();
 }
 inline ::raftpb::Entry* Message::add_entries() {
+  ::raftpb::Entry* _add = _internal_add_entries();
   // @@protoc_insertion_point(field_add:raftpb.Message.entries)
-  return _internal_add_entries();
+  return _add;
 }
 inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::raftpb::Entry >&
 Message::entries() const {
   // @@protoc_insertion_point(field_list:raftpb.Message.entries)
-  return entries_;
+  return _impl_.entries_;
 }
 
 // optional uint64 commit = 8;
 inline bool Message::_internal_has_commit() const {
-  bool value = (_has_bits_[0] & 0x00000200u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
   return value;
 }
 inline bool Message::has_commit() const {
   return _internal_has_commit();
 }
 inline void Message::clear_commit() {
-  commit_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000200u;
+  _impl_.commit_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000080u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_commit() const {
-  return commit_;
+inline uint64_t Message::_internal_commit() const {
+  return _impl_.commit_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::commit() const {
+inline uint64_t Message::commit() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.commit)
   return _internal_commit();
 }
-inline void Message::_internal_set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000200u;
-  commit_ = value;
+inline void Message::_internal_set_commit(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.commit_ = value;
 }
-inline void Message::set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_commit(uint64_t value) {
   _internal_set_commit(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.commit)
 }
 
 // optional .raftpb.Snapshot snapshot = 9;
 inline bool Message::_internal_has_snapshot() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
-  PROTOBUF_ASSUME(!value || snapshot_ != nullptr);
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.snapshot_ != nullptr);
   return value;
 }
 inline bool Message::has_snapshot() const {
   return _internal_has_snapshot();
 }
 inline void Message::clear_snapshot() {
-  if (snapshot_ != nullptr) snapshot_->Clear();
-  _has_bits_[0] &= ~0x00000002u;
+  if (_impl_.snapshot_ != nullptr) _impl_.snapshot_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
 inline const ::raftpb::Snapshot& Message::_internal_snapshot() const {
-  const ::raftpb::Snapshot* p = snapshot_;
+  const ::raftpb::Snapshot* p = _impl_.snapshot_;
   return p != nullptr ? *p : reinterpret_cast<const ::raftpb::Snapshot&>(
       ::raftpb::_Snapshot_default_instance_);
 }
@@ -2387,87 +2561,94 @@ inline const ::raftpb::Snapshot& Message::snapshot() const {
 }
 inline void Message::unsafe_arena_set_allocated_snapshot(
     ::raftpb::Snapshot* snapshot) {
-  if (GetArena() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(snapshot_);
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.snapshot_);
   }
-  snapshot_ = snapshot;
+  _impl_.snapshot_ = snapshot;
   if (snapshot) {
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:raftpb.Message.snapshot)
 }
 inline ::raftpb::Snapshot* Message::release_snapshot() {
-  _has_bits_[0] &= ~0x00000002u;
-  ::raftpb::Snapshot* temp = snapshot_;
-  snapshot_ = nullptr;
-  if (GetArena() != nullptr) {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::raftpb::Snapshot* temp = _impl_.snapshot_;
+  _impl_.snapshot_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
     temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
   }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
   return temp;
 }
 inline ::raftpb::Snapshot* Message::unsafe_arena_release_snapshot() {
   // @@protoc_insertion_point(field_release:raftpb.Message.snapshot)
-  _has_bits_[0] &= ~0x00000002u;
-  ::raftpb::Snapshot* temp = snapshot_;
-  snapshot_ = nullptr;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::raftpb::Snapshot* temp = _impl_.snapshot_;
+  _impl_.snapshot_ = nullptr;
   return temp;
 }
 inline ::raftpb::Snapshot* Message::_internal_mutable_snapshot() {
-  _has_bits_[0] |= 0x00000002u;
-  if (snapshot_ == nullptr) {
-    auto* p = CreateMaybeMessage<::raftpb::Snapshot>(GetArena());
-    snapshot_ = p;
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.snapshot_ == nullptr) {
+    auto* p = CreateMaybeMessage<::raftpb::Snapshot>(GetArenaForAllocation());
+    _impl_.snapshot_ = p;
   }
-  return snapshot_;
+  return _impl_.snapshot_;
 }
 inline ::raftpb::Snapshot* Message::mutable_snapshot() {
+  ::raftpb::Snapshot* _msg = _internal_mutable_snapshot();
   // @@protoc_insertion_point(field_mutable:raftpb.Message.snapshot)
-  return _internal_mutable_snapshot();
+  return _msg;
 }
 inline void Message::set_allocated_snapshot(::raftpb::Snapshot* snapshot) {
-  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete snapshot_;
+    delete _impl_.snapshot_;
   }
   if (snapshot) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
-      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(snapshot);
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(snapshot);
     if (message_arena != submessage_arena) {
       snapshot = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
           message_arena, snapshot, submessage_arena);
     }
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
-  snapshot_ = snapshot;
+  _impl_.snapshot_ = snapshot;
   // @@protoc_insertion_point(field_set_allocated:raftpb.Message.snapshot)
 }
 
 // optional bool reject = 10;
 inline bool Message::_internal_has_reject() const {
-  bool value = (_has_bits_[0] & 0x00000080u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000200u) != 0;
   return value;
 }
 inline bool Message::has_reject() const {
   return _internal_has_reject();
 }
 inline void Message::clear_reject() {
-  reject_ = false;
-  _has_bits_[0] &= ~0x00000080u;
+  _impl_.reject_ = false;
+  _impl_._has_bits_[0] &= ~0x00000200u;
 }
 inline bool Message::_internal_reject() const {
-  return reject_;
+  return _impl_.reject_;
 }
 inline bool Message::reject() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.reject)
   return _internal_reject();
 }
 inline void Message::_internal_set_reject(bool value) {
-  _has_bits_[0] |= 0x00000080u;
-  reject_ = value;
+  _impl_._has_bits_[0] |= 0x00000200u;
+  _impl_.reject_ = value;
 }
 inline void Message::set_reject(bool value) {
   _internal_set_reject(value);
@@ -2476,189 +2657,240 @@ inline void Message::set_reject(bool value) {
 
 // optional uint64 rejectHint = 11;
 inline bool Message::_internal_has_rejecthint() const {
-  bool value = (_has_bits_[0] & 0x00000400u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000800u) != 0;
   return value;
 }
 inline bool Message::has_rejecthint() const {
   return _internal_has_rejecthint();
 }
 inline void Message::clear_rejecthint() {
-  rejecthint_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000400u;
+  _impl_.rejecthint_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000800u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::_internal_rejecthint() const {
-  return rejecthint_;
+inline uint64_t Message::_internal_rejecthint() const {
+  return _impl_.rejecthint_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 Message::rejecthint() const {
+inline uint64_t Message::rejecthint() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.rejectHint)
   return _internal_rejecthint();
 }
-inline void Message::_internal_set_rejecthint(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000400u;
-  rejecthint_ = value;
+inline void Message::_internal_set_rejecthint(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000800u;
+  _impl_.rejecthint_ = value;
 }
-inline void Message::set_rejecthint(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void Message::set_rejecthint(uint64_t value) {
   _internal_set_rejecthint(value);
   // @@protoc_insertion_point(field_set:raftpb.Message.rejectHint)
 }
 
 // optional bytes context = 12;
 inline bool Message::_internal_has_context() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool Message::has_context() const {
   return _internal_has_context();
 }
 inline void Message::clear_context() {
-  context_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.context_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& Message::context() const {
   // @@protoc_insertion_point(field_get:raftpb.Message.context)
   return _internal_context();
 }
-inline void Message::set_context(const std::string& value) {
-  _internal_set_context(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Message::set_context(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.context_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:raftpb.Message.context)
 }
 inline std::string* Message::mutable_context() {
+  std::string* _s = _internal_mutable_context();
   // @@protoc_insertion_point(field_mutable:raftpb.Message.context)
-  return _internal_mutable_context();
+  return _s;
 }
 inline const std::string& Message::_internal_context() const {
-  return context_.Get();
+  return _impl_.context_.Get();
 }
 inline void Message::_internal_set_context(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void Message::set_context(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:raftpb.Message.context)
-}
-inline void Message::set_context(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:raftpb.Message.context)
-}
-inline void Message::set_context(const void* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:raftpb.Message.context)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.context_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Message::_internal_mutable_context() {
-  _has_bits_[0] |= 0x00000001u;
-  return context_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.context_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Message::release_context() {
   // @@protoc_insertion_point(field_release:raftpb.Message.context)
   if (!_internal_has_context()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return context_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.context_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.context_.IsDefault()) {
+    _impl_.context_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Message::set_allocated_context(std::string* context) {
   if (context != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  context_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), context,
-      GetArena());
+  _impl_.context_.SetAllocated(context, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.context_.IsDefault()) {
+    _impl_.context_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:raftpb.Message.context)
 }
 
+// optional bool quiesce = 13;
+inline bool Message::_internal_has_quiesce() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000400u) != 0;
+  return value;
+}
+inline bool Message::has_quiesce() const {
+  return _internal_has_quiesce();
+}
+inline void Message::clear_quiesce() {
+  _impl_.quiesce_ = false;
+  _impl_._has_bits_[0] &= ~0x00000400u;
+}
+inline bool Message::_internal_quiesce() const {
+  return _impl_.quiesce_;
+}
+inline bool Message::quiesce() const {
+  // @@protoc_insertion_point(field_get:raftpb.Message.quiesce)
+  return _internal_quiesce();
+}
+inline void Message::_internal_set_quiesce(bool value) {
+  _impl_._has_bits_[0] |= 0x00000400u;
+  _impl_.quiesce_ = value;
+}
+inline void Message::set_quiesce(bool value) {
+  _internal_set_quiesce(value);
+  // @@protoc_insertion_point(field_set:raftpb.Message.quiesce)
+}
+
+// optional uint64 leaseSentAt = 14;
+inline bool Message::_internal_has_leasesentat() const {
+  bool value = (_impl_._has_bits_[0] & 0x00001000u) != 0;
+  return value;
+}
+inline bool Message::has_leasesentat() const {
+  return _internal_has_leasesentat();
+}
+inline void Message::clear_leasesentat() {
+  _impl_.leasesentat_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00001000u;
+}
+inline uint64_t Message::_internal_leasesentat() const {
+  return _impl_.leasesentat_;
+}
+inline uint64_t Message::leasesentat() const {
+  // @@protoc_insertion_point(field_get:raftpb.Message.leaseSentAt)
+  return _internal_leasesentat();
+}
+inline void Message::_internal_set_leasesentat(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00001000u;
+  _impl_.leasesentat_ = value;
+}
+inline void Message::set_leasesentat(uint64_t value) {
+  _internal_set_leasesentat(value);
+  // @@protoc_insertion_point(field_set:raftpb.Message.leaseSentAt)
+}
+
 // -------------------------------------------------------------------
 
 // HardState
 
 // optional uint64 term = 1;
 inline bool HardState::_internal_has_term() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool HardState::has_term() const {
   return _internal_has_term();
 }
 inline void HardState::clear_term() {
-  term_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.term_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::_internal_term() const {
-  return term_;
+inline uint64_t HardState::_internal_term() const {
+  return _impl_.term_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::term() const {
+inline uint64_t HardState::term() const {
   // @@protoc_insertion_point(field_get:raftpb.HardState.term)
   return _internal_term();
 }
-inline void HardState::_internal_set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000001u;
-  term_ = value;
+inline void HardState::_internal_set_term(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.term_ = value;
 }
-inline void HardState::set_term(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void HardState::set_term(uint64_t value) {
   _internal_set_term(value);
   // @@protoc_insertion_point(field_set:raftpb.HardState.term)
 }
 
 // optional uint64 vote = 2;
 inline bool HardState::_internal_has_vote() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool HardState::has_vote() const {
   return _internal_has_vote();
 }
 inline void HardState::clear_vote() {
-  vote_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.vote_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::_internal_vote() const {
-  return vote_;
+inline uint64_t HardState::_internal_vote() const {
+  return _impl_.vote_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::vote() const {
+inline uint64_t HardState::vote() const {
   // @@protoc_insertion_point(field_get:raftpb.HardState.vote)
   return _internal_vote();
 }
-inline void HardState::_internal_set_vote(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000002u;
-  vote_ = value;
+inline void HardState::_internal_set_vote(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.vote_ = value;
 }
-inline void HardState::set_vote(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void HardState::set_vote(uint64_t value) {
   _internal_set_vote(value);
   // @@protoc_insertion_point(field_set:raftpb.HardState.vote)
 }
 
 // optional uint64 commit = 3;
 inline bool HardState::_internal_has_commit() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool HardState::has_commit() const {
   return _internal_has_commit();
 }
 inline void HardState::clear_commit() {
-  commit_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.commit_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::_internal_commit() const {
-  return commit_;
+inline uint64_t HardState::_internal_commit() const {
+  return _impl_.commit_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 HardState::commit() const {
+inline uint64_t HardState::commit() const {
   // @@protoc_insertion_point(field_get:raftpb.HardState.commit)
   return _internal_commit();
 }
-inline void HardState::_internal_set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000004u;
-  commit_ = value;
+inline void HardState::_internal_set_commit(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.commit_ = value;
 }
-inline void HardState::set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void HardState::set_commit(uint64_t value) {
   _internal_set_commit(value);
   // @@protoc_insertion_point(field_set:raftpb.HardState.commit)
 }
@@ -2669,46 +2901,46 @@ inline void HardState::set_commit(::PROTOBUF_NAMESPACE_ID::uint64 value) {
 
 // optional uint64 ID = 1;
 inline bool ConfChange::_internal_has_id() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool ConfChange::has_id() const {
   return _internal_has_id();
 }
 inline void ConfChange::clear_id() {
-  id_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.id_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfChange::_internal_id() const {
-  return id_;
+inline uint64_t ConfChange::_internal_id() const {
+  return _impl_.id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfChange::id() const {
+inline uint64_t ConfChange::id() const {
   // @@protoc_insertion_point(field_get:raftpb.ConfChange.ID)
   return _internal_id();
 }
-inline void ConfChange::_internal_set_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000002u;
-  id_ = value;
+inline void ConfChange::_internal_set_id(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.id_ = value;
 }
-inline void ConfChange::set_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void ConfChange::set_id(uint64_t value) {
   _internal_set_id(value);
   // @@protoc_insertion_point(field_set:raftpb.ConfChange.ID)
 }
 
 // optional .raftpb.ConfChangeType Type = 2;
 inline bool ConfChange::_internal_has_type() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool ConfChange::has_type() const {
   return _internal_has_type();
 }
 inline void ConfChange::clear_type() {
-  type_ = 0;
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
 inline ::raftpb::ConfChangeType ConfChange::_internal_type() const {
-  return static_cast< ::raftpb::ConfChangeType >(type_);
+  return static_cast< ::raftpb::ConfChangeType >(_impl_.type_);
 }
 inline ::raftpb::ConfChangeType ConfChange::type() const {
   // @@protoc_insertion_point(field_get:raftpb.ConfChange.Type)
@@ -2716,8 +2948,8 @@ inline ::raftpb::ConfChangeType ConfChange::type() const {
 }
 inline void ConfChange::_internal_set_type(::raftpb::ConfChangeType value) {
   assert(::raftpb::ConfChangeType_IsValid(value));
-  _has_bits_[0] |= 0x00000008u;
-  type_ = value;
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.type_ = value;
 }
 inline void ConfChange::set_type(::raftpb::ConfChangeType value) {
   _internal_set_type(value);
@@ -2726,102 +2958,97 @@ inline void ConfChange::set_type(::raftpb::ConfChangeType value) {
 
 // optional uint64 NodeID = 3;
 inline bool ConfChange::_internal_has_nodeid() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool ConfChange::has_nodeid() const {
   return _internal_has_nodeid();
 }
 inline void ConfChange::clear_nodeid() {
-  nodeid_ = PROTOBUF_ULONGLONG(0);
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.nodeid_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfChange::_internal_nodeid() const {
-  return nodeid_;
+inline uint64_t ConfChange::_internal_nodeid() const {
+  return _impl_.nodeid_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 ConfChange::nodeid() const {
+inline uint64_t ConfChange::nodeid() const {
   // @@protoc_insertion_point(field_get:raftpb.ConfChange.NodeID)
   return _internal_nodeid();
 }
-inline void ConfChange::_internal_set_nodeid(::PROTOBUF_NAMESPACE_ID::uint64 value) {
-  _has_bits_[0] |= 0x00000004u;
-  nodeid_ = value;
+inline void ConfChange::_internal_set_nodeid(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.nodeid_ = value;
 }
-inline void ConfChange::set_nodeid(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void ConfChange::set_nodeid(uint64_t value) {
   _internal_set_nodeid(value);
   // @@protoc_insertion_point(field_set:raftpb.ConfChange.NodeID)
 }
 
 // optional bytes Context = 4;
 inline bool ConfChange::_internal_has_context() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool ConfChange::has_context() const {
   return _internal_has_context();
 }
 inline void ConfChange::clear_context() {
-  context_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.context_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& ConfChange::context() const {
   // @@protoc_insertion_point(field_get:raftpb.ConfChange.Context)
   return _internal_context();
 }
-inline void ConfChange::set_context(const std::string& value) {
-  _internal_set_context(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void ConfChange::set_context(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.context_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:raftpb.ConfChange.Context)
 }
 inline std::string* ConfChange::mutable_context() {
+  std::string* _s = _internal_mutable_context();
   // @@protoc_insertion_point(field_mutable:raftpb.ConfChange.Context)
-  return _internal_mutable_context();
+  return _s;
 }
 inline const std::string& ConfChange::_internal_context() const {
-  return context_.Get();
+  return _impl_.context_.Get();
 }
 inline void ConfChange::_internal_set_context(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void ConfChange::set_context(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:raftpb.ConfChange.Context)
-}
-inline void ConfChange::set_context(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:raftpb.ConfChange.Context)
-}
-inline void ConfChange::set_context(const void* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  context_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:raftpb.ConfChange.Context)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.context_.Set(value, GetArenaForAllocation());
 }
 inline std::string* ConfChange::_internal_mutable_context() {
-  _has_bits_[0] |= 0x00000001u;
-  return context_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.context_.Mutable(GetArenaForAllocation());
 }
 inline std::string* ConfChange::release_context() {
   // @@protoc_insertion_point(field_release:raftpb.ConfChange.Context)
   if (!_internal_has_context()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return context_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.context_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.context_.IsDefault()) {
+    _impl_.context_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void ConfChange::set_allocated_context(std::string* context) {
   if (context != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.context_.SetAllocated(context, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.context_.IsDefault()) {
+    _impl_.context_.Set("", GetArenaForAllocation());
   }
-  context_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), context,
-      GetArena());
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:raftpb.ConfChange.Context)
 }
 
@@ -11,6 +11,7 @@ raftLog::raftLog(Storage *storage, Logger *logger)
   : storage_(storage),
     committed_(0),
     applied_(0),
+    applying_(0),
     logger_(logger) {
 }
 
@@ -45,7 +46,7 @@ raftLog::maybeAppend(uint64_t index, uint64_t logTerm,
   if (ci != 0) {
     offset = index + 1;
     EntryVec appendEntries(entries.begin() + ci - offset, entries.end());
-    append(appendEntries);
+    append(&appendEntries);
   }
 
   commitTo(min(committed, lastNewI));
@@ -84,6 +85,7 @@ raftLog::appliedTo(uint64_t i) {
     logger_->Fatalf(__FILE__, __LINE__, "applied(%llu) is out of range [prevApplied(%llu), committed(%llu)]", i, applied_, committed_);
   }
   applied_ = i;
+  applying_ = max(applying_, i);
 }
 
 void
@@ -122,6 +124,19 @@ raftLog::entries(uint64_t i, uint64_t maxSize, EntryVec *entries) {
   return slice(i, lasti + 1, maxSize, entries);
 }
 
+int
+raftLog::entries(uint64_t i, uint64_t maxSize, SharedEntryVec *entries) {
+  entries->clear();
+  uint64_t lasti = lastIndex();
+
+  // valid index check
+  if (i > lasti) {
+    return OK;
+  }
+
+  return slice(i, lasti + 1, maxSize, entries);
+}
+
 // allEntries returns all entries in the log.
 void
 raftLog::allEntries(EntryVec *entries) {
@@ -175,7 +190,17 @@ raftLog::append(const EntryVec& entries) {
     return lastIndex();
   }
 
-  uint64_t after = entries[0].index() - 1;
+  EntryVec copy(entries);
+  return append(&copy);
+}
+
+uint64_t
+raftLog::append(EntryVec *entries) {
+  if (entries->empty()) {
+    return lastIndex();
+  }
+
+  uint64_t after = (*entries)[0].index() - 1;
   if (after < committed_) {
     logger_->Fatalf(__FILE__, __LINE__, "after(%llu) is out of range [committed(%llu)]", after, committed_);
   }
@@ -217,13 +242,36 @@ uint64_t raftLog::findConflict(const EntryVec& entries) {
   return 0;
 }
 
+uint64_t
+raftLog::findConflictByTerm(uint64_t index, uint64_t term) {
+  uint64_t li = lastIndex();
+  if (index > li) {
+    // NB: such calls should not exist, but since there is a straightforward
+    // way to recover, do it.
+    logger_->Warningf(__FILE__, __LINE__, "index(%llu) is out of range [0, lastIndex(%llu)] in findConflictByTerm",
+      index, li);
+    return index;
+  }
+  while (true) {
+    uint64_t logTerm;
+    int err = this->term(index, &logTerm);
+    if (!SUCCESS(err) || logTerm <= term) {
+      break;
+    }
+    index--;
+  }
+  return index;
+}
+
 void
 raftLog::unstableEntries(EntryVec *entries) {
   entries->clear();
-  size_t i;
-  for (i = 0; i < unstable_.entries_.size(); ++i) {
-    entries->push_back(unstable_.entries_[i]);
-  }
+  copySharedEntries(unstable_.entries_, entries);
+}
+
+void
+raftLog::unstableEntries(SharedEntryVec *entries) {
+  *entries = unstable_.entries_;
 }
 
 // nextEntries returns all the available entries for execution.
@@ -231,6 +279,14 @@ raftLog::unstableEntries(EntryVec *entries) {
 // entries after the index of snapshot.
 void
 raftLog::nextEntries(EntryVec* entries) {
+  entries->clear();
+  SharedEntryVec shared;
+  nextEntries(&shared);
+  copySharedEntries(shared, entries);
+}
+
+void
+raftLog::nextEntries(SharedEntryVec* entries) {
   entries->clear();
   uint64_t offset = max(applied_ + 1, firstIndex());
   if (committed_ + 1 > offset) {
@@ -241,6 +297,37 @@ raftLog::nextEntries(EntryVec* entries) {
   }
 }
 
+void
+raftLog::nextUnstableEntries(SharedEntryVec* entries) {
+  entries->clear();
+  unstable_.nextEntries(entries);
+}
+
+// nextCommittedEntries does not return the entries that are not stable
+// locally, so an entry is never applied before it is persisted.
+void
+raftLog::nextCommittedEntries(SharedEntryVec* entries) {
+  entries->clear();
+  uint64_t offset = max(max(applied_, applying_) + 1, firstIndex());
+  uint64_t hi = min(committed_, unstable_.offset_ - 1) + 1;
+  if (hi > offset) {
+    int err = slice(offset, hi, kNoLimit, entries);
+    if (!SUCCESS(err)) {
+      logger_->Fatalf(__FILE__, __LINE__, "unexpected error when getting unapplied entries (%s)", kErrString[err]);
+    }
+  }
+}
+
+void
+raftLog::acceptUnstable() {
+  unstable_.acceptInProgress();
+}
+
+void
+raftLog::acceptApplying(uint64_t i) {
+  applying_ = max(applying_, i);
+}
+
 string
 raftLog::String() {
   char tmp[200];
@@ -370,6 +457,13 @@ raftLog::lastIndex() {
 
 // slice returns a slice of log entries from lo through hi-1, inclusive.
 int raftLog::slice(uint64_t lo, uint64_t hi, uint64_t maxSize, EntryVec* entries) {
+  SharedEntryVec shared;
+  int err = slice(lo, hi, maxSize, &shared);
+  copySharedEntries(shared, entries);
+  return err;
+}
+
+int raftLog::slice(uint64_t lo, uint64_t hi, uint64_t maxSize, SharedEntryVec* entries) {
   int err;
 
   // first check if index out of bounds
@@ -384,7 +478,8 @@ int raftLog::slice(uint64_t lo, uint64_t hi, uint64_t maxSize, EntryVec* entries
 
   // if lo index in unstable storage
   if (lo < unstable_.offset_) {
-    err = storage_->Entries(lo, min(hi,unstable_.offset_), maxSize, entries);
+    EntryVec stored;
+    err = storage_->Entries(lo, min(hi,unstable_.offset_), maxSize, &stored);
     if (err == ErrCompacted) {
       return err;
     } else if (err == ErrUnavailable) {
@@ -393,20 +488,16 @@ int raftLog::slice(uint64_t lo, uint64_t hi, uint64_t maxSize, EntryVec* entries
       logger_->Fatalf(__FILE__, __LINE__, "storage entries err:%s", kErrString[err]);
     }
 
-    if ((uint64_t)entries->size() < min(hi, unstable_.offset_) - lo) {
+    bool limited = (uint64_t)stored.size() < min(hi, unstable_.offset_) - lo;
+    shareEntries(&stored, entries);
+    if (limited) {
       return OK;
     }
   }
 
   // if hi index not in unstable storage
   if (hi > unstable_.offset_) {
-    EntryVec unstable;
-    unstable_.slice(max(lo, unstable_.offset_), hi, &unstable);
-    if (entries->size() > 0) {
-      entries->insert(entries->end(), unstable.begin(), unstable.end());
-    } else {
-      *entries = unstable;
-    }
+    unstable_.slice(max(lo, unstable_.offset_), hi, entries);
   }
 
   limitSize(maxSize, entries); 
@@ -28,6 +28,11 @@ struct raftLog {
   // Invariant: applied <= committed
   uint64_t applied_;
 
+  // applying is the highest log position that the application has been
+  // handed to apply by the asynchronous Ready pipeline.
+  // Invariant: applied <= applying <= committed
+  uint64_t applying_;
+
   Logger *logger_;
 
   raftLog(Storage *, Logger *);
@@ -43,18 +48,39 @@ struct raftLog {
   // append entries to unstable storage and return last index
   uint64_t append(const EntryVec& entries);
 
+  // append moves entries to unstable storage and return last index,
+  // entries is left empty after the call.
+  uint64_t append(EntryVec *entries);
+
   // finds the index of the conflict.
   uint64_t findConflict(const EntryVec& entries);
 
+  // findConflictByTerm returns the largest index up to index whose term is
+  // not larger than term, i.e. the entries after it are known not to match
+  // a log whose entry at index has the given term. The first unavailable
+  // index stops the scan. If index is beyond the last index it is returned.
+  uint64_t findConflictByTerm(uint64_t index, uint64_t term);
+
   // get all unstable entries
   void unstableEntries(EntryVec *entries);
+  void unstableEntries(SharedEntryVec *entries);
 
   // nextEntries returns all the available entries for execution.
   void nextEntries(EntryVec* entries);
+  void nextEntries(SharedEntryVec* entries);
 
   // hasNextEntries returns if there is any available entries for execution.
   bool hasNextEntries();
 
+  // nextUnstableEntries returns the unstable entries that are not yet being
+  // persisted, and nextCommittedEntries the committed entries that are stable
+  // and not yet being applied. Both are used by the asynchronous Ready pipeline,
+  // acceptUnstable and acceptApplying mark the returned ones in progress.
+  void nextUnstableEntries(SharedEntryVec* entries);
+  void nextCommittedEntries(SharedEntryVec* entries);
+  void acceptUnstable();
+  void acceptApplying(uint64_t i);
+
   // return snapshot of raft log
   int snapshot(Snapshot **snapshot);
 
@@ -79,6 +105,7 @@ struct raftLog {
 
   // get entries from index i, no more than maxSize
   int entries(uint64_t i, uint64_t maxSize, EntryVec *entries);
+  int entries(uint64_t i, uint64_t maxSize, SharedEntryVec *entries);
 
   // allEntries returns all entries in the log.
   void allEntries(EntryVec *entries);
@@ -99,6 +126,9 @@ struct raftLog {
   // slice returns a slice of log entries from lo through hi-1, inclusive.
   int slice(uint64_t lo, uint64_t hi, uint64_t maxSize, EntryVec* entries);
 
+  // slice returns the shared entries, entries in the unstable log are not copied.
+  int slice(uint64_t lo, uint64_t hi, uint64_t maxSize, SharedEntryVec* entries);
+
   // check if [lo,hi] is out of bounds
   int mustCheckOutOfBounds(uint64_t lo, uint64_t hi);
 
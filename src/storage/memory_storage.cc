@@ -9,6 +9,7 @@ namespace libraft {
 
 MemoryStorage::MemoryStorage(Logger *logger, EntryVec* entries) 
   : snapShot_(new Snapshot())
+  , hasConfState_(false)
   , logger_(logger) {
   if (entries == NULL) {
     // When starting from scratch populate the list with a dummy entry at term zero.
@@ -27,7 +28,11 @@ MemoryStorage::~MemoryStorage() {
 int
 MemoryStorage::InitialState(HardState *hs, ConfState *cs) {
   *hs = hardState_;
-  *cs = snapShot_->metadata().conf_state();
+  if (hasConfState_) {
+    *cs = confState_;
+  } else {
+    *cs = snapShot_->metadata().conf_state();
+  }
   return OK;
 }
 
@@ -38,6 +43,14 @@ MemoryStorage::SetHardState(const HardState& hs) {
   return OK;
 }
 
+int
+MemoryStorage::SetConfState(const ConfState& cs) {
+  Mutex mutex(&locker_);
+  confState_ = cs;
+  hasConfState_ = true;
+  return OK;
+}
+
 uint64_t
 MemoryStorage::firstIndex() {
   return entries_[0].index() + 1;
@@ -151,6 +164,8 @@ MemoryStorage::ApplySnapshot(const Snapshot& snapshot) {
   }
 
   snapShot_->CopyFrom(snapshot);
+  // the ConfState of the snapshot supersedes the saved one
+  hasConfState_ = false;
   entries_.clear();
   Entry entry;
   entry.set_index(snapshot.metadata().index());
@@ -215,6 +230,18 @@ MemoryStorage::Append(const EntryVec& entries) {
   return OK;
 }
 
+// Append the new shared entries to storage, MemoryStorage keeps its own copy.
+int
+MemoryStorage::Append(const SharedEntryVec& entries) {
+  EntryVec copy;
+  copy.reserve(entries.size());
+  size_t i;
+  for (i = 0; i < entries.size(); ++i) {
+    copy.push_back(*entries[i]);
+  }
+  return Append(copy);
+}
+
 // CreateSnapshot makes a snapshot which can be retrieved with Snapshot() and
 // can be used to reconstruct the state at that point.
 // If any configuration changes have been made since the last compaction,
@@ -10,9 +10,9 @@
 
 namespace libraft {
 
-// MemoryStorage implements the Storage interface backed by an
+// MemoryStorage implements the WritableStorage interface backed by an
 // in-memory array.
-class MemoryStorage : public Storage {
+class MemoryStorage : public WritableStorage {
 public:
   MemoryStorage(Logger *logger, EntryVec* entries = NULL);
   virtual ~MemoryStorage();
@@ -24,8 +24,10 @@ public:
   int Entries(uint64_t lo, uint64_t hi, uint64_t maxSize, EntryVec *entries);
   int GetSnapshot(Snapshot **snapshot);
   int SetHardState(const HardState& );
+  int SetConfState(const ConfState& cs);
 
   int Append(const EntryVec& entries);
+  int Append(const SharedEntryVec& entries);
   int Compact(uint64_t compactIndex);
   int ApplySnapshot(const Snapshot& snapshot);
   int CreateSnapshot(uint64_t i, ConfState *cs, const string& data, Snapshot *ss);
@@ -37,6 +39,11 @@ private:
 public:
   HardState hardState_;
   Snapshot  *snapShot_;
+
+  // the ConfState saved by SetConfState, if hasConfState_ is set
+  // InitialState returns it instead of the one of the snapshot.
+  ConfState confState_;
+  bool      hasConfState_;
   
   // ents[i] has raft log position i+snapshot.Metadata.Index
   EntryVec entries_;
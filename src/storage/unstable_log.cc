@@ -2,6 +2,7 @@
  * Copyright (C) lichuang
  */
 
+#include "base/util.h"
 #include "storage/unstable_log.h"
 
 namespace libraft {
@@ -64,7 +65,7 @@ unstableLog::maybeTerm(uint64_t i, uint64_t *term) {
   if (i > last) {
     return false;
   }
-  *term = entries_[i - offset_].term();
+  *term = entries_[i - offset_]->term();
   return true;
 }
 
@@ -80,8 +81,10 @@ unstableLog::stableTo(uint64_t i, uint64_t t) {
   // only update the unstable entries if term is matched with
   // an unstable entry.
   if (gt == t && i >= offset_) {
-    entries_.erase(entries_.begin(), entries_.begin() + i + 1 - offset_);
+    size_t n = i + 1 - offset_;
+    entries_.erase(entries_.begin(), entries_.begin() + n);
     offset_ = i + 1;
+    inProgress_ = (inProgress_ > n) ? inProgress_ - n : 0;
     //logger_->Debugf(__FILE__, __LINE__, "stable to %llu, entries size:%d, offset:%llu", i, entries_.size(), offset_);
   }
 }
@@ -91,6 +94,20 @@ unstableLog::stableSnapTo(uint64_t i) {
   if (snapshot_ != NULL && snapshot_->metadata().index() == i) {
     delete snapshot_;
     snapshot_ = NULL;
+    snapshotInProgress_ = false;
+  }
+}
+
+void
+unstableLog::nextEntries(SharedEntryVec *entries) {
+  entries->insert(entries->end(), entries_.begin() + inProgress_, entries_.end());
+}
+
+void
+unstableLog::acceptInProgress() {
+  inProgress_ = entries_.size();
+  if (snapshot_ != NULL) {
+    snapshotInProgress_ = true;
   }
 }
 
@@ -98,6 +115,8 @@ void
 unstableLog::restore(const Snapshot& snapshot) {
   offset_ = snapshot.metadata().index() + 1;
   entries_.clear();
+  inProgress_ = 0;
+  snapshotInProgress_ = false;
   if (snapshot_ == NULL) {
     snapshot_ = new Snapshot();
   }
@@ -106,12 +125,18 @@ unstableLog::restore(const Snapshot& snapshot) {
 
 void 
 unstableLog::truncateAndAppend(const EntryVec& entries) {
-  uint64_t after = entries[0].index();
+  EntryVec copy(entries);
+  truncateAndAppend(&copy);
+}
+
+void 
+unstableLog::truncateAndAppend(EntryVec *entries) {
+  uint64_t after = (*entries)[0].index();
 
   if (after == offset_ + uint64_t(entries_.size())) {
     // after is the next index in the u.entries
     // directly append
-    entries_.insert(entries_.end(), entries.begin(), entries.end());
+    shareEntries(entries, &entries_);
     logger_->Infof(__FILE__, __LINE__, "ENTRY size: %d", entries_.size());
     return;
   }
@@ -121,22 +146,35 @@ unstableLog::truncateAndAppend(const EntryVec& entries) {
     // portion, so set the offset and replace the entries
     logger_->Infof(__FILE__, __LINE__, "replace the unstable entries from index %llu", after);
     offset_ = after;
-    entries_ = entries;
+    entries_.clear();
+    inProgress_ = 0;
+    shareEntries(entries, &entries_);
     return;
   }
 
-  // truncate to after and copy to u.entries then append
+  // truncate to after and move to u.entries then append
   logger_->Infof(__FILE__, __LINE__, "truncate the unstable entries before index %llu", after);
-  vector<Entry> slice;
-  this->slice(offset_, after, &slice);
-  entries_ = slice;
-  entries_.insert(entries_.end(), entries.begin(), entries.end());
+  mustCheckOutOfBounds(offset_, after);
+  entries_.erase(entries_.begin() + after - offset_, entries_.end());
+  inProgress_ = min(inProgress_, (size_t)(after - offset_));
+  shareEntries(entries, &entries_);
 }
 
 void 
 unstableLog::slice(uint64_t lo, uint64_t hi, EntryVec *entries) {
   mustCheckOutOfBounds(lo, hi);
-  entries->assign(entries_.begin() + lo - offset_, entries_.begin() + hi - offset_);
+  entries->clear();
+  entries->reserve(hi - lo);
+  uint64_t i;
+  for (i = lo; i < hi; ++i) {
+    entries->push_back(*entries_[i - offset_]);
+  }
+}
+
+void 
+unstableLog::slice(uint64_t lo, uint64_t hi, SharedEntryVec *entries) {
+  mustCheckOutOfBounds(lo, hi);
+  entries->insert(entries->end(), entries_.begin() + lo - offset_, entries_.begin() + hi - offset_);
 }
 
 // u.offset <= lo <= hi <= u.offset+len(u.offset)
@@ -14,19 +14,31 @@ namespace libraft {
 // position in storage; this means that the next write to storage
 // might need to truncate the log before persisting unstable.entries.
 struct unstableLog {
-  unstableLog() : snapshot_(NULL) {
+  unstableLog() : snapshot_(NULL), inProgress_(0), snapshotInProgress_(false) {
   }
 
   // the incoming unstable snapshot, if any.
   Snapshot* snapshot_;
 
-  // all entries that have not yet been written to storage.
-  EntryVec entries_;
+  // all entries that have not yet been written to storage,
+  // shared with the Ready entries handed out to the application.
+  SharedEntryVec entries_;
   uint64_t offset_;
   Logger *logger_;
 
+  // inProgress_ is the number of the entries at the front of entries_ that
+  // have been handed out to be persisted but are not stable yet, and
+  // snapshotInProgress_ is set once snapshot_ has been handed out.
+  // They are only used by the asynchronous Ready pipeline.
+  size_t inProgress_;
+  bool snapshotInProgress_;
+
   void truncateAndAppend(const EntryVec& entries);
 
+  // truncateAndAppend moves the entries into entries_ instead of copying them,
+  // entries is left empty after the call.
+  void truncateAndAppend(EntryVec *entries);
+
   // maybeFirstIndex returns the index of the first possible entry in entries
   // if it has a snapshot.
   bool maybeFirstIndex(uint64_t *first);
@@ -39,12 +51,22 @@ struct unstableLog {
 
   void stableTo(uint64_t i, uint64_t t);
 
+  // nextEntries appends the entries that are not in progress to entries.
+  void nextEntries(SharedEntryVec *entries);
+
+  // acceptInProgress marks all the entries and the snapshot in progress.
+  void acceptInProgress();
+
   void stableSnapTo(uint64_t i);
 
   void restore(const Snapshot& snapshot);
 
+  // slice returns copies of the entries in [lo, hi)
   void slice(uint64_t lo, uint64_t hi, EntryVec *entries);
 
+  // slice appends the shared entries in [lo, hi) to entries without copying them
+  void slice(uint64_t lo, uint64_t hi, SharedEntryVec *entries);
+
   void mustCheckOutOfBounds(uint64_t lo, uint64_t hi);
 };
 
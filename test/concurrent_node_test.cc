@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include "libraft.h"
+#include "base/default_logger.h"
+#include "base/mpsc_queue.h"
+#include "core/concurrent_node.h"
+#include "storage/memory_storage.h"
+
+using namespace libraft;
+
+static const int kProducers = 8;
+static const int kPerProducer = 10000;
+
+// TestMpscQueue ensures that the values of every producer are popped
+// once each and in the order they are pushed.
+TEST(concurrentNodeTests, TestMpscQueue) {
+  mpscQueue<uint64_t> queue;
+  vector<std::thread> producers;
+  int p;
+  for (p = 0; p < kProducers; ++p) {
+    producers.push_back(std::thread([&queue, p]() {
+      uint64_t i;
+      for (i = 0; i < (uint64_t)kPerProducer; ++i) {
+        queue.push(((uint64_t)p << 32) | i);
+      }
+    }));
+  }
+
+  vector<uint64_t> next(kProducers, 0);
+  int popped = 0;
+  while (popped < kProducers * kPerProducer) {
+    uint64_t value;
+    if (!queue.pop(&value)) {
+      continue;
+    }
+    uint64_t producer = value >> 32;
+    EXPECT_EQ(value & 0xffffffff, next[producer]);
+    next[producer] = (value & 0xffffffff) + 1;
+    ++popped;
+  }
+  for (p = 0; p < kProducers; ++p) {
+    producers[p].join();
+  }
+  uint64_t value;
+  EXPECT_FALSE(queue.pop(&value));
+}
+
+// storageHandler saves the Ready to a MemoryStorage and counts the
+// applied proposals, as a single node has no message to send.
+struct storageHandler : public ReadyHandler {
+  MemoryStorage *storage;
+  std::atomic<uint64_t> leader;
+  std::atomic<int> applied;
+  std::atomic<uint64_t> readIndex;
+  std::atomic<int> confNodes;
+
+  // the raft thread waits in HandleReady while block is set
+  std::atomic<bool> block;
+  std::atomic<bool> blocked;
+
+  storageHandler(MemoryStorage *s)
+    : storage(s), leader(0), applied(0), readIndex(0), confNodes(0),
+      block(false), blocked(false) {}
+
+  void HandleReady(const Ready& ready) {
+    while (block) {
+      blocked = true;
+      usleep(1000);
+    }
+    if (ready.softState.leader != kEmptyPeerId) {
+      leader = ready.softState.leader;
+    }
+    storage->Append(ready.entries);
+    if (ready.hardState.commit() != 0) {
+      storage->SetHardState(ready.hardState);
+    }
+    size_t i;
+    for (i = 0; i < ready.committedEntries.size(); ++i) {
+      const Entry& entry = *ready.committedEntries[i];
+      if (entry.type() == EntryNormal && !entry.data().empty()) {
+        ++applied;
+      }
+    }
+    if (!ready.readStates.empty()) {
+      readIndex = ready.readStates.back()->index_;
+    }
+  }
+
+  void HandleConfState(const ConfState& cs) {
+    storage->SetConfState(cs);
+    confNodes = cs.nodes_size();
+  }
+};
+
+// waitFor waits up to timeout milliseconds for cond
+template <typename Cond>
+static bool
+waitFor(Cond cond, int timeout) {
+  int i;
+  for (i = 0; i < timeout && !cond(); ++i) {
+    usleep(1000);
+  }
+  return cond();
+}
+
+static ConcurrentNode*
+newSingleNode(storageHandler **handler) {
+  Config c;
+  c.id = 1;
+  c.logger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(c.logger);
+  c.storage = s;
+  c.readOnlyOption = ReadOnlySafe;
+  vector<Peer> peers(1);
+  peers[0].Id = 1;
+
+  *handler = new storageHandler(s);
+  ConcurrentNodeConfig cc;
+  cc.node = StartNode(&c, peers);
+  cc.handler = *handler;
+  cc.tickInterval = 5;
+  return NewConcurrentNode(cc);
+}
+
+// TestConcurrentNodeAsyncReady ensures that a Node with the asynchronous
+// Ready pipeline is rejected, as the raft thread advances with Advance.
+TEST(concurrentNodeTests, TestConcurrentNodeAsyncReady) {
+  Config c;
+  c.id = 1;
+  c.logger = new DefaultLogger();
+  c.storage = new MemoryStorage(c.logger);
+  c.asyncReady = true;
+  vector<Peer> peers(1);
+  peers[0].Id = 1;
+
+  ConcurrentNodeConfig cc;
+  cc.node = StartNode(&c, peers);
+  EXPECT_TRUE(NewConcurrentNode(cc) == NULL);
+
+  delete cc.node;
+}
+
+// TestConcurrentNodePropose ensures that the proposals of many threads are
+// all committed, and that they are batched into fewer Readies.
+TEST(concurrentNodeTests, TestConcurrentNodePropose) {
+  storageHandler *handler;
+  ConcurrentNode *node = newSingleNode(&handler);
+  EXPECT_TRUE(waitFor([handler]() { return handler->leader == 1; }, 5000));
+
+  vector<std::thread> producers;
+  int p;
+  for (p = 0; p < kProducers; ++p) {
+    producers.push_back(std::thread([node, p]() {
+      int i;
+      for (i = 0; i < kPerProducer; ++i) {
+        EXPECT_EQ(node->Propose(std::to_string(p) + ":" + std::to_string(i)), OK);
+      }
+    }));
+  }
+  for (p = 0; p < kProducers; ++p) {
+    producers[p].join();
+  }
+
+  const int total = kProducers * kPerProducer;
+  EXPECT_TRUE(waitFor([handler, total]() { return handler->applied == total; }, 10000));
+  EXPECT_EQ(handler->applied, total);
+
+  ConcurrentNodeImpl *impl = static_cast<ConcurrentNodeImpl*>(node);
+  EXPECT_LT(impl->readies_, (uint64_t)total);
+
+  // a linearizable read is served at the commit index
+  EXPECT_EQ(node->ReadIndex("ctx"), OK);
+  uint64_t lastIndex;
+  handler->storage->LastIndex(&lastIndex);
+  EXPECT_TRUE(waitFor([handler, lastIndex]() { return handler->readIndex == lastIndex; }, 5000));
+
+  node->Stop();
+  EXPECT_EQ(node->Propose("after stop"), ErrStopped);
+  delete node;
+  delete handler;
+}
+
+// TestConcurrentNodeConfState ensures that the ConfState of the applied
+// conf changes is handed to the handler.
+TEST(concurrentNodeTests, TestConcurrentNodeConfState) {
+  storageHandler *handler;
+  ConcurrentNode *node = newSingleNode(&handler);
+  EXPECT_TRUE(waitFor([handler]() { return handler->leader == 1; }, 5000));
+  // the initial conf change of StartNode
+  EXPECT_EQ(handler->confNodes, 1);
+
+  delete node;
+  delete handler;
+}
+
+// TestConcurrentNodeProposeWithCallback ensures that the callbacks of the
+// proposals of many threads are all called with their committed index.
+TEST(concurrentNodeTests, TestConcurrentNodeProposeWithCallback) {
+  storageHandler *handler;
+  ConcurrentNode *node = newSingleNode(&handler);
+  EXPECT_TRUE(waitFor([handler]() { return handler->leader == 1; }, 5000));
+
+  const int perProducer = 1000;
+  std::atomic<int> done(0);
+  std::atomic<uint64_t> indexSum(0);
+  vector<std::thread> producers;
+  int p;
+  for (p = 0; p < kProducers; ++p) {
+    producers.push_back(std::thread([node, &done, &indexSum]() {
+      int i;
+      for (i = 0; i < perProducer; ++i) {
+        node->ProposeWithCallback("data", [&done, &indexSum](int err, uint64_t term, uint64_t index) {
+          EXPECT_EQ(err, OK);
+          indexSum += index;
+          ++done;
+        });
+      }
+    }));
+  }
+  for (p = 0; p < kProducers; ++p) {
+    producers[p].join();
+  }
+
+  const int total = kProducers * perProducer;
+  EXPECT_TRUE(waitFor([&done, total]() { return done == total; }, 10000));
+  // every index is resolved once
+  uint64_t lastIndex;
+  handler->storage->LastIndex(&lastIndex);
+  uint64_t first = lastIndex - total + 1;
+  EXPECT_EQ(indexSum, (first + lastIndex) * total / 2);
+
+  delete node;
+  delete handler;
+}
+
+// TestConcurrentNodeReadIndexWithCallback ensures that the reads of many
+// threads are all done with a read index the applied index has reached.
+TEST(concurrentNodeTests, TestConcurrentNodeReadIndexWithCallback) {
+  storageHandler *handler;
+  ConcurrentNode *node = newSingleNode(&handler);
+  EXPECT_TRUE(waitFor([handler]() { return handler->leader == 1; }, 5000));
+  uint64_t lastIndex;
+  handler->storage->LastIndex(&lastIndex);
+
+  const int perProducer = 1000;
+  std::atomic<int> done(0);
+  vector<std::thread> producers;
+  int p;
+  for (p = 0; p < kProducers; ++p) {
+    producers.push_back(std::thread([node, &done, lastIndex]() {
+      int i;
+      for (i = 0; i < perProducer; ++i) {
+        node->ReadIndexWithCallback([&done, lastIndex](int err, uint64_t index) {
+          EXPECT_EQ(err, OK);
+          EXPECT_GE(index, lastIndex);
+          ++done;
+        });
+      }
+    }));
+  }
+  for (p = 0; p < kProducers; ++p) {
+    producers[p].join();
+  }
+
+  const int total = kProducers * perProducer;
+  EXPECT_TRUE(waitFor([&done, total]() { return done == total; }, 10000));
+  // the read states of the reads are not handed out
+  EXPECT_EQ(handler->readIndex, 0);
+
+  delete node;
+  delete handler;
+}
+
+// TestConcurrentNodeStopQueued ensures that the callbacks of the requests
+// still queued when the raft thread exits are called with ErrStopped.
+TEST(concurrentNodeTests, TestConcurrentNodeStopQueued) {
+  storageHandler *handler;
+  ConcurrentNode *node = newSingleNode(&handler);
+  EXPECT_TRUE(waitFor([handler]() { return handler->leader == 1; }, 5000));
+
+  // hold the raft thread in the Ready of a proposal
+  handler->block = true;
+  EXPECT_EQ(node->Propose("block"), OK);
+  EXPECT_TRUE(waitFor([handler]() { return handler->blocked.load(); }, 5000));
+
+  const int queued = 100;
+  std::atomic<int> proposeStopped(0), readStopped(0);
+  int i;
+  for (i = 0; i < queued; ++i) {
+    EXPECT_EQ(node->ProposeWithCallback("data", [&proposeStopped](int err, uint64_t term, uint64_t index) {
+      EXPECT_EQ(err, ErrStopped);
+      ++proposeStopped;
+    }), OK);
+    EXPECT_EQ(node->ReadIndexWithCallback([&readStopped](int err, uint64_t index) {
+      EXPECT_EQ(err, ErrStopped);
+      ++readStopped;
+    }), OK);
+  }
+
+  ConcurrentNodeImpl *impl = static_cast<ConcurrentNodeImpl*>(node);
+  std::thread stopper([node]() { node->Stop(); });
+  EXPECT_TRUE(waitFor([impl]() { return impl->stopped_.load(); }, 5000));
+  handler->block = false;
+  stopper.join();
+
+  EXPECT_EQ(proposeStopped, queued);
+  EXPECT_EQ(readStopped, queued);
+
+  delete node;
+  delete handler;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <gtest/gtest.h>
+#include "libraft.h"
+#include "base/default_logger.h"
+#include "base/util.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+#include "raft_test_util.h"
+
+using namespace libraft;
+
+static void
+decodeMessage(const EncodedMessage& encoded, Message* msg) {
+  string data = encoded.header;
+  if (encoded.entries != NULL) {
+    data += *encoded.entries;
+  }
+  EXPECT_TRUE(msg->ParseFromString(data));
+}
+
+// TestEncodeMessagesShareEntries ensures that the MsgApps broadcast to
+// the followers share one encoding of the entries, and decode to the
+// same messages as the original ones.
+TEST(encodingTests, TestEncodeMessagesShareEntries) {
+  vector<uint64_t> peers = {1, 2, 3, 4, 5};
+  raft *r = newTestRaft(1, peers, 10, 1, new MemoryStorage(&kDefaultLogger));
+  r->becomeCandidate();
+  r->becomeLeader();
+  MessageVec msgs;
+  r->readMessages(&msgs);
+
+  size_t i;
+  for (i = 2; i <= peers.size(); ++i) {
+    r->progressMap_[i]->becomeReplicate();
+  }
+
+  EntryVec entries;
+  for (i = 0; i < 3; ++i) {
+    entries.push_back(initEntry(0, 0, "somedata"));
+    entries[i].set_type(EntryNormal);
+  }
+  r->propose(&entries);
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 4);
+
+  vector<EncodedMessage> encoded;
+  EncodeMessages(msgs, &encoded);
+  EXPECT_EQ(encoded.size(), msgs.size());
+
+  for (i = 0; i < msgs.size(); ++i) {
+    EXPECT_EQ(msgs[i]->type(), MsgApp);
+    EXPECT_TRUE(encoded[i].entries != NULL);
+    EXPECT_EQ(encoded[i].entries.get(), encoded[0].entries.get());
+
+    Message msg;
+    decodeMessage(encoded[i], &msg);
+    EXPECT_TRUE(isDeepEqualMessage(msg, *msgs[i])) << "i: " << i;
+    EXPECT_EQ(msg.index(), msgs[i]->index());
+    EXPECT_EQ(msg.logterm(), msgs[i]->logterm());
+    EXPECT_EQ(msg.commit(), msgs[i]->commit());
+    EXPECT_EQ(msg.term(), msgs[i]->term());
+    delete msgs[i];
+  }
+
+  delete r;
+}
+
+// TestEncodeMessagesWithoutEntries ensures that messages without entries,
+// and MsgApps with different entries, are encoded on their own.
+TEST(encodingTests, TestEncodeMessagesWithoutEntries) {
+  EntryVec entries1 = {initEntry(2, 1, "a")};
+  EntryVec entries2 = {initEntry(2, 1, "a"), initEntry(3, 1, "b")};
+  entries1[0].set_type(EntryNormal);
+  entries2[0].set_type(EntryNormal);
+  entries2[1].set_type(EntryNormal);
+
+  Message heartbeat = initMessage(1, 2, MsgHeartbeat);
+  heartbeat.set_commit(1);
+  heartbeat.set_context("ctx");
+  Message app1 = initMessage(1, 2, MsgApp, &entries1, 1);
+  Message app2 = initMessage(1, 3, MsgApp, &entries2, 1);
+  app1.set_term(1);
+  app2.set_term(1);
+  MessageVec msgs = {&heartbeat, &app1, &app2};
+
+  vector<EncodedMessage> encoded;
+  EncodeMessages(msgs, &encoded);
+  EXPECT_EQ(encoded.size(), msgs.size());
+  EXPECT_TRUE(encoded[0].entries == NULL);
+  EXPECT_TRUE(encoded[1].entries != NULL);
+  EXPECT_TRUE(encoded[2].entries != NULL);
+  EXPECT_NE(encoded[1].entries.get(), encoded[2].entries.get());
+
+  size_t i;
+  for (i = 0; i < msgs.size(); ++i) {
+    Message msg;
+    decodeMessage(encoded[i], &msg);
+    EXPECT_TRUE(isDeepEqualMessage(msg, *msgs[i])) << "i: " << i;
+    EXPECT_EQ(msg.commit(), msgs[i]->commit());
+    EXPECT_EQ(msg.context(), msgs[i]->context());
+  }
+}
+
+TEST(encodingTests, TestEncodeHeartbeatBatch) {
+  HeartbeatBatch batch;
+  batch.type = MsgHeartbeat;
+  batch.from = 1;
+  batch.to = 2;
+  uint64_t i;
+  for (i = 1; i <= 3; ++i) {
+    GroupHeartbeat hb;
+    hb.groupId = i * 1000;
+    hb.term = i;
+    hb.commit = i * 10;
+    hb.context = i == 2 ? "ctx" : "";
+    hb.quiesce = (i == 3);
+    hb.leaseSentAt = i == 1 ? 0 : i * 1000000;
+    batch.heartbeats.push_back(hb);
+  }
+
+  string data;
+  EncodeHeartbeatBatch(batch, &data);
+
+  HeartbeatBatch decoded;
+  EXPECT_TRUE(DecodeHeartbeatBatch(data, &decoded));
+  EXPECT_EQ(decoded.type, batch.type);
+  EXPECT_EQ(decoded.from, batch.from);
+  EXPECT_EQ(decoded.to, batch.to);
+  EXPECT_EQ(decoded.heartbeats.size(), batch.heartbeats.size());
+  for (i = 0; i < decoded.heartbeats.size(); ++i) {
+    EXPECT_EQ(decoded.heartbeats[i].groupId, batch.heartbeats[i].groupId);
+    EXPECT_EQ(decoded.heartbeats[i].term, batch.heartbeats[i].term);
+    EXPECT_EQ(decoded.heartbeats[i].commit, batch.heartbeats[i].commit);
+    EXPECT_EQ(decoded.heartbeats[i].context, batch.heartbeats[i].context);
+    EXPECT_EQ(decoded.heartbeats[i].quiesce, batch.heartbeats[i].quiesce);
+    EXPECT_EQ(decoded.heartbeats[i].leaseSentAt, batch.heartbeats[i].leaseSentAt);
+  }
+
+  // truncated data
+  EXPECT_FALSE(DecodeHeartbeatBatch(data.substr(0, data.size() - 1), &decoded));
+}
+
+// TestDecodeHeartbeatBatchType ensures that a batch of any type
+// other than the heartbeats is rejected.
+TEST(encodingTests, TestDecodeHeartbeatBatchType) {
+  MessageType types[] = {MsgApp, MsgVote, MsgSnap, MsgTimeoutNow, MsgHeartbeatResp};
+  size_t i;
+  for (i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+    HeartbeatBatch batch;
+    batch.type = types[i];
+    batch.from = 1;
+    batch.to = 2;
+    GroupHeartbeat hb;
+    hb.groupId = 1;
+    hb.term = 5;
+    hb.commit = 0;
+    hb.quiesce = false;
+    hb.leaseSentAt = 0;
+    batch.heartbeats.push_back(hb);
+
+    string data;
+    EncodeHeartbeatBatch(batch, &data);
+    HeartbeatBatch decoded;
+    EXPECT_EQ(DecodeHeartbeatBatch(data, &decoded), types[i] == MsgHeartbeatResp) << "i: " << i;
+  }
+}
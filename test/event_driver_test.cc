@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <event2/event.h>
+#include <gtest/gtest.h>
+#include "libraft.h"
+#include "base/default_logger.h"
+#include "core/node.h"
+#include "core/raft.h"
+#include "net/event_driver.h"
+#include "net/transport.h"
+#include "storage/memory_storage.h"
+
+using namespace libraft;
+
+static const int kDrivers = 3;
+
+// freePort returns a loopback port free for now
+static int
+freePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in sin;
+  memset(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  sin.sin_port = 0;
+  bind(fd, (struct sockaddr*)&sin, sizeof(sin));
+  socklen_t len = sizeof(sin);
+  getsockname(fd, (struct sockaddr*)&sin, &len);
+  close(fd);
+  return ntohs(sin.sin_port);
+}
+
+static int
+connectTo(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in sin;
+  memset(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  sin.sin_port = htons(port);
+  EXPECT_EQ(connect(fd, (struct sockaddr*)&sin, sizeof(sin)), 0);
+  return fd;
+}
+
+// runUntil runs the loop until *done or the timeout in milliseconds
+static bool
+runUntil(event_base *base, bool (*done)(void *), void *arg, int timeout) {
+  int i;
+  for (i = 0; i < timeout && !done(arg); ++i) {
+    struct timeval tv = {0, 1000};
+    event_base_loopexit(base, &tv);
+    event_base_dispatch(base);
+  }
+  return done(arg);
+}
+
+struct recordApplier : public Applier {
+  vector<string> applied;
+
+  void Apply(const Ready& ready) {
+    size_t i;
+    for (i = 0; i < ready.committedEntries.size(); ++i) {
+      const Entry& entry = *ready.committedEntries[i];
+      if (entry.type() == EntryNormal && !entry.data().empty()) {
+        applied.push_back(entry.data());
+      }
+    }
+  }
+};
+
+struct loopbackCluster {
+  event_base *base;
+  EventDriver *drivers[kDrivers + 1];
+  recordApplier appliers[kDrivers + 1];
+  MemoryStorage *storages[kDrivers + 1];
+
+  loopbackCluster() {
+    base = event_base_new();
+    vector<PeerAddress> addrs;
+    vector<Peer> peers;
+    uint64_t id;
+    for (id = 1; id <= kDrivers; ++id) {
+      PeerAddress addr;
+      addr.id = id;
+      addr.host = "127.0.0.1";
+      addr.port = freePort();
+      addrs.push_back(addr);
+      Peer peer;
+      peer.Id = id;
+      peers.push_back(peer);
+    }
+    for (id = 1; id <= kDrivers; ++id) {
+      Config c;
+      c.id = id;
+      c.logger = new DefaultLogger();
+      c.storage = storages[id] = new MemoryStorage(c.logger);
+      c.readOnlyOption = ReadOnlySafe;
+
+      EventDriverConfig dc;
+      dc.base = base;
+      dc.id = id;
+      dc.node = StartNode(&c, peers);
+      dc.storage = storages[id];
+      dc.applier = &appliers[id];
+      dc.peers = addrs;
+      dc.tickInterval = 10;
+      drivers[id] = NewEventDriver(dc);
+      EXPECT_EQ(drivers[id]->Start(), OK);
+    }
+  }
+
+  ~loopbackCluster() {
+    uint64_t id;
+    for (id = 1; id <= kDrivers; ++id) {
+      delete drivers[id];
+    }
+    event_base_free(base);
+  }
+
+  raft* driverRaft(uint64_t id) {
+    return static_cast<EventDriverImpl*>(drivers[id])->node_->raft_;
+  }
+};
+
+static bool
+hasLeader(void *arg) {
+  loopbackCluster *c = static_cast<loopbackCluster*>(arg);
+  uint64_t id;
+  for (id = 1; id <= kDrivers; ++id) {
+    if (c->driverRaft(id)->leader_ != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool
+allApplied(void *arg) {
+  loopbackCluster *c = static_cast<loopbackCluster*>(arg);
+  uint64_t id;
+  for (id = 1; id <= kDrivers; ++id) {
+    if (c->appliers[id].applied.size() < 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// TestEventDriverReplicate ensures that the drivers elect a leader and
+// replicate the proposals over the loopback TCP connections.
+TEST(eventDriverTests, TestEventDriverReplicate) {
+  loopbackCluster c;
+  EXPECT_EQ(c.drivers[1]->Campaign(), OK);
+  EXPECT_TRUE(runUntil(c.base, hasLeader, &c, 5000));
+
+  EXPECT_EQ(c.drivers[1]->Propose("foo"), OK);
+  EXPECT_EQ(c.drivers[1]->Propose("bar"), OK);
+  EXPECT_TRUE(runUntil(c.base, allApplied, &c, 5000));
+
+  uint64_t id;
+  for (id = 1; id <= kDrivers; ++id) {
+    EXPECT_EQ((int)c.appliers[id].applied.size(), 2);
+    EXPECT_EQ(c.appliers[id].applied[0], "foo");
+    EXPECT_EQ(c.appliers[id].applied[1], "bar");
+
+    // the entries and the hard state have been saved
+    uint64_t lastIndex;
+    c.storages[id]->LastIndex(&lastIndex);
+    EXPECT_EQ(lastIndex, c.driverRaft(1)->raftLog_->lastIndex());
+    EXPECT_EQ(c.storages[id]->hardState_.commit(), lastIndex);
+
+    // the ConfState of the initial conf changes has been saved
+    HardState hs;
+    ConfState cs;
+    c.storages[id]->InitialState(&hs, &cs);
+    EXPECT_EQ(cs.nodes_size(), kDrivers);
+  }
+
+  for (id = 1; id <= kDrivers; ++id) {
+    c.drivers[id]->Stop();
+  }
+  // nothing is left in the loop after Stop
+  EXPECT_EQ(event_base_dispatch(c.base), 1);
+}
+
+struct recvRecorder {
+  vector<Message> msgs;
+};
+
+static void
+recordMessage(void *arg, const Message& msg) {
+  static_cast<recvRecorder*>(arg)->msgs.push_back(msg);
+}
+
+static bool
+received(void *arg) {
+  return static_cast<recvRecorder*>(arg)->msgs.size() >= 2;
+}
+
+static void
+writeFrame(int fd, const string& data, size_t split) {
+  uint32_t length = htonl(data.size());
+  string frame((const char*)&length, sizeof(length));
+  frame += data;
+  // write the frame in two parts
+  EXPECT_EQ(write(fd, frame.data(), split), (ssize_t)split);
+  usleep(1000);
+  EXPECT_EQ(write(fd, frame.data() + split, frame.size() - split), (ssize_t)(frame.size() - split));
+}
+
+// TestTransportFraming ensures that the messages split across reads are
+// framed by their length prefix.
+TEST(eventDriverTests, TestTransportFraming) {
+  event_base *base = event_base_new();
+  DefaultLogger logger;
+  vector<PeerAddress> addrs(1);
+  addrs[0].id = 1;
+  addrs[0].host = "127.0.0.1";
+  addrs[0].port = freePort();
+  recvRecorder recorder;
+  transport *trans = new transport(base, 1, addrs, &logger, recordMessage, &recorder);
+  EXPECT_EQ(trans->start(), OK);
+
+  int fd = connectTo(addrs[0].port);
+  Message msg;
+  msg.set_type(MsgApp);
+  msg.set_from(2);
+  msg.set_to(1);
+  msg.set_term(3);
+  Entry *entry = msg.add_entries();
+  entry->set_type(EntryNormal);
+  entry->set_index(5);
+  entry->set_term(3);
+  entry->set_data(string(1000, 'x'));
+  string data;
+  msg.SerializeToString(&data);
+  writeFrame(fd, data, 2);
+  writeFrame(fd, data, 500);
+
+  EXPECT_TRUE(runUntil(base, received, &recorder, 5000));
+  EXPECT_EQ((int)recorder.msgs.size(), 2);
+  size_t i;
+  for (i = 0; i < recorder.msgs.size(); ++i) {
+    EXPECT_EQ(recorder.msgs[i].SerializeAsString(), data);
+  }
+  EXPECT_EQ((int)trans->inbound_.size(), 1);
+
+  // a corrupted length closes the connection
+  uint32_t length = 0xffffffff;
+  EXPECT_EQ(write(fd, &length, sizeof(length)), (ssize_t)sizeof(length));
+  struct timeval tv = {0, 50000};
+  event_base_loopexit(base, &tv);
+  event_base_dispatch(base);
+  EXPECT_TRUE(trans->inbound_.empty());
+
+  close(fd);
+  delete trans;
+  event_base_free(base);
+}
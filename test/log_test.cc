@@ -57,6 +57,49 @@ TEST(logTests, TestFindConflict) {
   }
 }
 
+TEST(logTests, TestFindConflictByTerm) {
+  EntryVec previousEnts = {
+    initEntry(1,1),
+    initEntry(2,2),
+    initEntry(3,2),
+    initEntry(4,4),
+    initEntry(5,4),
+  };
+
+  struct tmp {
+    uint64_t index;
+    uint64_t term;
+    uint64_t want;
+  } tests[] = {
+    // the term of index matches
+    {.index = 5, .term = 4, .want = 5},
+    {.index = 3, .term = 2, .want = 3},
+    // larger than all the terms
+    {.index = 5, .term = 5, .want = 5},
+    // skip the entries of the larger terms
+    {.index = 5, .term = 3, .want = 3},
+    {.index = 5, .term = 2, .want = 3},
+    {.index = 5, .term = 1, .want = 1},
+    {.index = 3, .term = 1, .want = 1},
+    {.index = 5, .term = 0, .want = 0},
+    // out of range
+    {.index = 7, .term = 1, .want = 7},
+  };
+
+  size_t i = 0;
+  for (i = 0; i < SIZEOF_ARRAY(tests); i++) {
+    const tmp &test = tests[i];
+    MemoryStorage *s = new MemoryStorage(&kDefaultLogger);
+    raftLog *log = newLog(s, &kDefaultLogger);
+
+    log->append(previousEnts);
+
+    EXPECT_EQ(log->findConflictByTerm(test.index, test.term), test.want) << "i: " << i;
+
+    delete log;
+  }
+}
+
 TEST(logTests, TestIsUpToDate) {
   // first fill up previous entries
   EntryVec previousEnts = {
@@ -493,6 +536,41 @@ TEST(logTests, TestUnstableEnts) {
   }
 }
 
+// TestSharedEntries ensures the shared entries handed out by the log are
+// the same allocations as the unstable log entries, not copies.
+TEST(logTests, TestSharedEntries) {
+  EntryVec previousEnts = {
+    initEntry(1,1),
+    initEntry(2,2),
+    initEntry(3,3),
+  };
+  MemoryStorage *s = new MemoryStorage(&kDefaultLogger);
+  s->Append(EntryVec(previousEnts.begin(), previousEnts.begin() + 1));
+  raftLog *log = newLog(s, &kDefaultLogger);
+  log->append(EntryVec(previousEnts.begin() + 1, previousEnts.end()));
+  log->commitTo(3);
+
+  SharedEntryVec unstableEntries;
+  log->unstableEntries(&unstableEntries);
+  EXPECT_TRUE(isDeepEqualEntries(unstableEntries, EntryVec(previousEnts.begin() + 1, previousEnts.end())));
+  EXPECT_EQ(unstableEntries[0].get(), log->unstable_.entries_[0].get());
+  EXPECT_EQ(unstableEntries[1].get(), log->unstable_.entries_[1].get());
+
+  SharedEntryVec nextEntries;
+  log->nextEntries(&nextEntries);
+  EXPECT_TRUE(isDeepEqualEntries(nextEntries, previousEnts));
+  EXPECT_EQ(nextEntries[1].get(), log->unstable_.entries_[0].get());
+  EXPECT_EQ(nextEntries[2].get(), log->unstable_.entries_[1].get());
+
+  // the shared entries outlive the unstable log entries
+  log->stableTo(3, 3);
+  EXPECT_EQ((int)log->unstable_.entries_.size(), 0);
+  EXPECT_EQ(unstableEntries[1]->index(), 3);
+  EXPECT_EQ(unstableEntries[1]->term(), 3);
+
+  delete log;
+}
+
 TEST(logTests, TestCommitTo) {
   uint64_t commit = 2;
   EntryVec previousEnts = {
@@ -0,0 +1,455 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <gtest/gtest.h>
+#include "libraft.h"
+#include "base/default_logger.h"
+#include "core/multi_node.h"
+#include "core/node.h"
+#include "core/raft.h"
+#include "storage/memory_storage.h"
+#include "raft_test_util.h"
+
+using namespace libraft;
+
+static const int kHosts  = 3;
+static const int kGroups = 20;
+
+struct groupMessage {
+  uint64_t groupId;
+  Message  msg;
+};
+
+struct multiHosts {
+  MultiNode* hosts[kHosts + 1];
+  map<uint64_t, MemoryStorage*> storages[kHosts + 1];
+
+  // the groups hold a lease by leaseClock if it is set
+  multiHosts(bool quiesce = false, Clock *leaseClock = NULL) {
+    vector<Peer> peers;
+    uint64_t id;
+    for (id = 1; id <= kHosts; ++id) {
+      Peer peer;
+      peer.Id = id;
+      peers.push_back(peer);
+    }
+    for (id = 1; id <= kHosts; ++id) {
+      hosts[id] = NewMultiNode();
+      uint64_t group;
+      for (group = 1; group <= kGroups; ++group) {
+        Config c;
+        c.id = id;
+        c.logger = new DefaultLogger();
+        c.storage = storages[id][group] = new MemoryStorage(c.logger);
+        c.readOnlyOption = ReadOnlySafe;
+        c.quiesce = quiesce;
+        if (leaseClock != NULL) {
+          c.readOnlyOption = ReadOnlyLeaseBased;
+          c.checkQuorum = true;
+          c.leaseDuration = 100;
+          c.maxClockDrift = 10;
+          c.clock = leaseClock;
+        }
+        EXPECT_EQ(hosts[id]->CreateGroup(group, &c, peers), OK);
+      }
+    }
+  }
+
+  ~multiHosts() {
+    uint64_t id;
+    for (id = 1; id <= kHosts; ++id) {
+      delete hosts[id];
+    }
+  }
+
+  // drain saves and applies the readies of all the hosts and delivers
+  // their messages until no group changes any more.
+  void drain() {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      vector<groupMessage> msgs;
+      HeartbeatBatchVec batches;
+      uint64_t id;
+      for (id = 1; id <= kHosts; ++id) {
+        GroupReadyVec readies;
+        hosts[id]->Readies(&readies);
+        HeartbeatBatchVec hbs;
+        hosts[id]->Heartbeats(&hbs);
+        batches.insert(batches.end(), hbs.begin(), hbs.end());
+        size_t i, j;
+        for (i = 0; i < readies.size(); ++i) {
+          changed = true;
+          Ready *ready = readies[i].ready;
+          storages[id][readies[i].groupId]->Append(ready->entries);
+          for (j = 0; j < ready->committedEntries.size(); ++j) {
+            const Entry& entry = *ready->committedEntries[j];
+            if (entry.type() == EntryConfChange) {
+              ConfChange cc;
+              cc.ParseFromString(entry.data());
+              ConfState cs;
+              hosts[id]->ApplyConfChange(readies[i].groupId, cc, &cs);
+            }
+          }
+          for (j = 0; j < ready->messages.size(); ++j) {
+            groupMessage gm;
+            gm.groupId = readies[i].groupId;
+            gm.msg = *ready->messages[j];
+            msgs.push_back(gm);
+          }
+        }
+        hosts[id]->Advance(readies);
+      }
+
+      size_t i;
+      for (i = 0; i < msgs.size(); ++i) {
+        hosts[msgs[i].msg.to()]->Step(msgs[i].groupId, msgs[i].msg);
+      }
+      for (i = 0; i < batches.size(); ++i) {
+        changed = true;
+        hosts[batches[i].to]->StepHeartbeats(batches[i]);
+      }
+    }
+  }
+
+  raft* groupRaft(uint64_t id, uint64_t group) {
+    MultiNodeImpl *host = static_cast<MultiNodeImpl*>(hosts[id]);
+    return host->groups_[group]->node_->raft_;
+  }
+};
+
+// TestMultiNodeElection ensures that messages are routed by group, and
+// every group elects its leader independently.
+TEST(multiNodeTests, TestMultiNodeElection) {
+  multiHosts h;
+  h.drain();
+
+  uint64_t group;
+  for (group = 1; group <= kGroups; ++group) {
+    // spread the leaders over the hosts
+    EXPECT_EQ(h.hosts[group % kHosts + 1]->Campaign(group), OK);
+  }
+  h.drain();
+
+  for (group = 1; group <= kGroups; ++group) {
+    uint64_t leader = group % kHosts + 1;
+    uint64_t id;
+    for (id = 1; id <= kHosts; ++id) {
+      raft *r = h.groupRaft(id, group);
+      EXPECT_EQ(r->leader_, leader) << "group: " << group << ", id: " << id;
+      EXPECT_EQ(r->state_, id == leader ? StateLeader : StateFollower);
+    }
+  }
+}
+
+// TestMultiNodeReadies ensures that Readies only returns the groups which have changed.
+TEST(multiNodeTests, TestMultiNodeReadies) {
+  multiHosts h;
+  h.drain();
+
+  uint64_t group;
+  for (group = 1; group <= kGroups; ++group) {
+    h.hosts[1]->Campaign(group);
+  }
+  h.drain();
+
+  EXPECT_EQ(h.hosts[1]->Propose(3, "somedata"), OK);
+  GroupReadyVec readies;
+  h.hosts[1]->Readies(&readies);
+  EXPECT_EQ((int)readies.size(), 1);
+  EXPECT_EQ(readies[0].groupId, 3);
+  EXPECT_EQ((int)readies[0].ready->entries.size(), 1);
+  EXPECT_EQ(readies[0].ready->entries[0]->data(), "somedata");
+
+  // the Ready is returned only once
+  GroupReadyVec again;
+  h.hosts[1]->Readies(&again);
+  EXPECT_TRUE(again.empty());
+
+  h.storages[1][3]->Append(readies[0].ready->entries);
+  vector<Message> msgs;
+  size_t i;
+  for (i = 0; i < readies[0].ready->messages.size(); ++i) {
+    msgs.push_back(*readies[0].ready->messages[i]);
+  }
+  h.hosts[1]->Advance(readies);
+  for (i = 0; i < msgs.size(); ++i) {
+    h.hosts[msgs[i].to()]->Step(3, msgs[i]);
+  }
+  h.drain();
+
+  uint64_t id;
+  for (id = 1; id <= kHosts; ++id) {
+    raft *r = h.groupRaft(id, 3);
+    EXPECT_EQ(r->raftLog_->committed_, h.groupRaft(1, 3)->raftLog_->lastIndex());
+  }
+}
+
+// TestMultiNodeCoalesceHeartbeats ensures that the heartbeats of all the groups
+// are sent in one batch per destination, and the responses are split back to the groups.
+TEST(multiNodeTests, TestMultiNodeCoalesceHeartbeats) {
+  multiHosts h;
+  h.drain();
+
+  uint64_t group, id;
+  for (group = 1; group <= kGroups; ++group) {
+    h.hosts[1]->Campaign(group);
+  }
+  h.drain();
+  for (group = 1; group <= kGroups; ++group) {
+    h.groupRaft(1, group)->progressMap_[2]->recentActive_ = false;
+    h.groupRaft(1, group)->progressMap_[3]->recentActive_ = false;
+  }
+
+  // heartbeatTick is 1
+  h.hosts[1]->Tick();
+
+  // groups that only send heartbeats have nothing to do for the application
+  GroupReadyVec readies;
+  h.hosts[1]->Readies(&readies);
+  EXPECT_TRUE(readies.empty());
+
+  HeartbeatBatchVec batches;
+  h.hosts[1]->Heartbeats(&batches);
+  EXPECT_EQ((int)batches.size(), 2);
+  size_t i;
+  for (i = 0; i < batches.size(); ++i) {
+    EXPECT_EQ(batches[i].type, MsgHeartbeat);
+    EXPECT_EQ(batches[i].from, 1);
+    EXPECT_EQ((int)batches[i].heartbeats.size(), kGroups);
+    h.hosts[batches[i].to]->StepHeartbeats(batches[i]);
+  }
+
+  for (id = 2; id <= kHosts; ++id) {
+    h.hosts[id]->Readies(&readies);
+    EXPECT_TRUE(readies.empty());
+    h.hosts[id]->Heartbeats(&batches);
+    EXPECT_EQ((int)batches.size(), 1);
+    EXPECT_EQ(batches[0].type, MsgHeartbeatResp);
+    EXPECT_EQ(batches[0].to, 1);
+    EXPECT_EQ((int)batches[0].heartbeats.size(), kGroups);
+    h.hosts[1]->StepHeartbeats(batches[0]);
+  }
+
+  for (group = 1; group <= kGroups; ++group) {
+    EXPECT_TRUE(h.groupRaft(1, group)->progressMap_[2]->recentActive_);
+    EXPECT_TRUE(h.groupRaft(1, group)->progressMap_[3]->recentActive_);
+  }
+}
+
+// TestMultiNodeStepHeartbeatsType ensures that a batch of a type other than
+// the heartbeats does not step the groups.
+TEST(multiNodeTests, TestMultiNodeStepHeartbeatsType) {
+  multiHosts h;
+  h.drain();
+
+  uint64_t group;
+  for (group = 1; group <= kGroups; ++group) {
+    h.hosts[1]->Campaign(group);
+  }
+  h.drain();
+
+  HeartbeatBatch batch;
+  batch.type = MsgVote;
+  batch.from = 3;
+  batch.to = 2;
+  for (group = 1; group <= kGroups; ++group) {
+    GroupHeartbeat hb;
+    hb.groupId = group;
+    hb.term = h.groupRaft(2, group)->term_ + 1;
+    hb.commit = 0;
+    hb.quiesce = false;
+    hb.leaseSentAt = 0;
+    batch.heartbeats.push_back(hb);
+  }
+  h.hosts[2]->StepHeartbeats(batch);
+
+  for (group = 1; group <= kGroups; ++group) {
+    EXPECT_EQ(h.groupRaft(2, group)->term_, batch.heartbeats[group - 1].term - 1);
+    EXPECT_EQ(h.groupRaft(2, group)->leader_, 1);
+  }
+}
+
+// TestMultiNodeLeaseRead ensures that the coalesced heartbeats carry the
+// time they are sent at, so the leaders hold the lease and serve the reads
+// without a round of heartbeats.
+TEST(multiNodeTests, TestMultiNodeLeaseRead) {
+  manualClock clock;
+  clock.now_ = 1000;
+  multiHosts h(false, &clock);
+  h.drain();
+
+  uint64_t group;
+  for (group = 1; group <= kGroups; ++group) {
+    h.hosts[1]->Campaign(group);
+  }
+  h.drain();
+
+  // heartbeatTick is 1
+  h.hosts[1]->Tick();
+  GroupReadyVec readies;
+  h.hosts[1]->Readies(&readies);
+  EXPECT_TRUE(readies.empty());
+  HeartbeatBatchVec batches;
+  h.hosts[1]->Heartbeats(&batches);
+  EXPECT_EQ((int)batches.size(), kHosts - 1);
+  size_t i, j;
+  for (i = 0; i < batches.size(); ++i) {
+    for (j = 0; j < batches[i].heartbeats.size(); ++j) {
+      EXPECT_EQ(batches[i].heartbeats[j].leaseSentAt, 1000);
+    }
+    h.hosts[batches[i].to]->StepHeartbeats(batches[i]);
+  }
+  h.drain();
+
+  clock.now_ = 1050;
+  for (group = 1; group <= kGroups; ++group) {
+    EXPECT_TRUE(h.groupRaft(1, group)->inLease()) << "group: " << group;
+  }
+  EXPECT_EQ(h.hosts[1]->ReadIndex(3, "ctx"), OK);
+  h.hosts[1]->Readies(&readies);
+  EXPECT_EQ((int)readies.size(), 1);
+  EXPECT_EQ((int)readies[0].ready->readStates.size(), 1);
+  EXPECT_EQ(readies[0].ready->readStates[0]->requestCtx_, "ctx");
+  h.hosts[1]->Heartbeats(&batches);
+  EXPECT_TRUE(batches.empty());
+  h.hosts[1]->Advance(readies);
+}
+
+// TestMultiNodeTickElection ensures that the groups elect their leaders
+// and keep them when driven only at their deadlines by Tick.
+TEST(multiNodeTests, TestMultiNodeTickElection) {
+  multiHosts h;
+  h.drain();
+
+  uint64_t group, id;
+  int i;
+  // the rafts created in the same second share the randomized election
+  // timeout, only tick the first host to avoid the split votes. The
+  // randomized election timeout is less than 2 * electionTick.
+  for (i = 0; i < 2 * 10; ++i) {
+    h.hosts[1]->Tick();
+    h.drain();
+  }
+
+  uint64_t terms[kGroups + 1];
+  for (group = 1; group <= kGroups; ++group) {
+    raft *r = h.groupRaft(1, group);
+    EXPECT_NE(r->leader_, kEmptyPeerId) << "group: " << group;
+    terms[group] = r->term_;
+  }
+
+  // the heartbeats keep the leaders
+  for (i = 0; i < 100; ++i) {
+    for (id = 1; id <= kHosts; ++id) {
+      h.hosts[id]->Tick();
+    }
+    h.drain();
+  }
+  for (group = 1; group <= kGroups; ++group) {
+    EXPECT_EQ(h.groupRaft(1, group)->term_, terms[group]) << "group: " << group;
+  }
+
+  // every group is scheduled at its next deadline
+  for (id = 1; id <= kHosts; ++id) {
+    MultiNodeImpl *host = static_cast<MultiNodeImpl*>(h.hosts[id]);
+    EXPECT_EQ((int)host->wheel_.size(), kGroups);
+  }
+}
+
+// TestMultiNodeQuiesce ensures that the idle groups quiesce and are not ticked.
+TEST(multiNodeTests, TestMultiNodeQuiesce) {
+  multiHosts h(true);
+  h.drain();
+
+  uint64_t group, id;
+  for (group = 1; group <= kGroups; ++group) {
+    h.hosts[1]->Campaign(group);
+  }
+  h.drain();
+
+  for (id = 1; id <= kHosts; ++id) {
+    h.hosts[id]->Tick();
+  }
+  h.drain();
+
+  // the hosts keep ticking the groups until they find the groups quiescent
+  for (id = 1; id <= kHosts; ++id) {
+    h.hosts[id]->Tick();
+    MultiNodeImpl *host = static_cast<MultiNodeImpl*>(h.hosts[id]);
+    EXPECT_EQ((int)host->wheel_.size(), 0);
+  }
+
+  int i;
+  for (i = 0; i < 100; ++i) {
+    for (id = 1; id <= kHosts; ++id) {
+      h.hosts[id]->Tick();
+      GroupReadyVec readies;
+      h.hosts[id]->Readies(&readies);
+      EXPECT_TRUE(readies.empty());
+      HeartbeatBatchVec batches;
+      h.hosts[id]->Heartbeats(&batches);
+      EXPECT_TRUE(batches.empty());
+    }
+  }
+
+  // a proposal wakes the group up on all the hosts
+  EXPECT_EQ(h.hosts[1]->Propose(2, "somedata"), OK);
+  h.drain();
+  for (id = 1; id <= kHosts; ++id) {
+    MultiNodeImpl *host = static_cast<MultiNodeImpl*>(h.hosts[id]);
+    EXPECT_EQ((int)host->wheel_.size(), 1);
+    EXPECT_TRUE(host->groups_[2]->timer_.scheduled());
+  }
+}
+
+TEST(multiNodeTests, TestMultiNodeGroupNotFound) {
+  MultiNode *host = NewMultiNode();
+  vector<Peer> peers(1);
+  peers[0].Id = 1;
+
+  Config c;
+  c.id = 1;
+  c.logger = new DefaultLogger();
+  c.storage = new MemoryStorage(c.logger);
+  c.readOnlyOption = ReadOnlySafe;
+  EXPECT_EQ(host->CreateGroup(1, &c, peers), OK);
+  EXPECT_EQ(host->CreateGroup(1, &c, peers), ErrGroupExists);
+
+  Message msg;
+  msg.set_type(MsgHeartbeat);
+  msg.set_from(2);
+  msg.set_to(1);
+  EXPECT_EQ(host->Step(2, msg), ErrGroupNotFound);
+  EXPECT_EQ(host->Propose(2, "somedata"), ErrGroupNotFound);
+
+  EXPECT_EQ(host->RemoveGroup(1), OK);
+  EXPECT_EQ(host->RemoveGroup(1), ErrGroupNotFound);
+  GroupReadyVec readies;
+  host->Readies(&readies);
+  EXPECT_TRUE(readies.empty());
+
+  delete host;
+}
+
+// TestMultiNodeAsyncReady ensures that a group with the asynchronous Ready
+// pipeline is rejected, as MultiNode advances the groups with Advance.
+TEST(multiNodeTests, TestMultiNodeAsyncReady) {
+  MultiNode *host = NewMultiNode();
+  vector<Peer> peers(1);
+  peers[0].Id = 1;
+
+  Config c;
+  c.id = 1;
+  c.logger = new DefaultLogger();
+  c.storage = new MemoryStorage(c.logger);
+  c.readOnlyOption = ReadOnlySafe;
+  c.asyncReady = true;
+  EXPECT_EQ(host->CreateGroup(1, &c, peers), ErrInvalidConfig);
+  EXPECT_EQ(host->RemoveGroup(1), ErrGroupNotFound);
+
+  delete host;
+  delete c.storage;
+  delete c.logger;
+}
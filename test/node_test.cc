@@ -192,6 +192,645 @@ TEST(nodeTests, TestNodeProposeConfig) {
   delete n;
 }
 
+// TestNodeProposeBatch ensures that node.ProposeBatch on a follower forwards all
+// the given proposals to the leader in one MsgProp.
+TEST(nodeTests, TestNodeProposeBatch) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  r->becomeFollower(1, 2);
+  NodeImpl *n = new NodeImpl(defaultLogger, r); 
+
+  Ready *ready;
+  vector<string> datas = {"a", "b", "c"};
+  n->ProposeBatch(datas, &ready);
+
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  Message *msg = ready->messages[0];
+  EXPECT_EQ(msg->type(), MsgProp);
+  EXPECT_EQ(msg->to(), 2);
+  EXPECT_EQ(msg->entries_size(), 3);
+  int i;
+  for (i = 0; i < msg->entries_size(); ++i) {
+    EXPECT_EQ(msg->entries(i).data(), datas[i]);
+  }
+  n->Advance();
+
+  n->ProposeBatch(std::move(datas), &ready);
+
+  EXPECT_TRUE(datas.empty());
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  EXPECT_EQ(ready->messages[0]->entries_size(), 3);
+  EXPECT_EQ(ready->messages[0]->entries(2).data(), "c");
+  n->Advance();
+
+  delete n;
+}
+
+// TestNodeProposeBatchReady ensures that a batch of proposals is returned
+// in a single Ready.
+TEST(nodeTests, TestNodeProposeBatchReady) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  NodeImpl *n = new NodeImpl(defaultLogger, r); 
+
+  Ready *ready;
+  n->Campaign(&ready);
+
+  while (true) {
+    s->Append(ready->entries);
+    if (ready->softState.leader == r->id_) {
+      n->Advance();
+      break;
+    }
+    n->Advance();
+  }
+
+  uint64_t lastIndex = r->raftLog_->lastIndex();
+  vector<string> datas = {"a", "b", "c"};
+  n->ProposeBatch(datas, &ready);
+
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->entries.size(), 3);
+  EXPECT_EQ((int)ready->committedEntries.size(), 3);
+  size_t i;
+  for (i = 0; i < ready->entries.size(); ++i) {
+    EXPECT_EQ(ready->entries[i]->index(), lastIndex + 1 + i);
+    EXPECT_EQ(ready->entries[i]->data(), datas[i]);
+  }
+  s->Append(ready->entries);
+  n->Advance();
+
+  // an empty batch has nothing to do
+  n->ProposeBatch(vector<string>(), &ready);
+  EXPECT_TRUE(ready == NULL);
+
+  // the moved payload goes straight into the leader log
+  string data = "d";
+  n->Propose(std::move(data), &ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->entries.size(), 1);
+  EXPECT_EQ(ready->entries[0]->index(), lastIndex + 4);
+  EXPECT_EQ(ready->entries[0]->data(), "d");
+  s->Append(ready->entries);
+  n->Advance();
+
+  delete n;
+}
+
+struct proposeResult {
+  int err;
+  uint64_t term;
+  uint64_t index;
+  int calls;
+
+  proposeResult() : err(-1), term(0), index(0), calls(0) {}
+};
+
+static ProposeDone
+recordResult(proposeResult *result) {
+  return [result](int err, uint64_t term, uint64_t index) {
+    result->err = err;
+    result->term = term;
+    result->index = index;
+    result->calls++;
+  };
+}
+
+// TestNodeProposeWithCallback ensures that the callback of a proposal is called
+// once its committed entry is advanced, and at once when it is dropped.
+TEST(nodeTests, TestNodeProposeWithCallback) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+
+  // not the leader
+  proposeResult dropped;
+  Ready *ready;
+  EXPECT_EQ(n->ProposeWithCallback("a", recordResult(&dropped), &ready), ErrProposalDropped);
+  EXPECT_EQ(dropped.calls, 1);
+  EXPECT_EQ(dropped.err, ErrProposalDropped);
+  EXPECT_EQ(n->Propose("a", &ready), ErrProposalDropped);
+
+  n->Campaign(&ready);
+  while (true) {
+    s->Append(ready->entries);
+    if (ready->softState.leader == r->id_) {
+      n->Advance();
+      break;
+    }
+    n->Advance();
+  }
+
+  uint64_t lastIndex = r->raftLog_->lastIndex();
+  proposeResult results[3];
+  int i;
+  for (i = 0; i < 3; ++i) {
+    EXPECT_EQ(n->ProposeWithCallback("b", recordResult(&results[i]), &ready), OK);
+    EXPECT_TRUE(ready != NULL);
+    EXPECT_EQ((int)ready->committedEntries.size(), 1);
+    // not resolved until the committed entry is advanced
+    EXPECT_EQ(results[i].calls, 0);
+    s->Append(ready->entries);
+    n->Advance();
+    EXPECT_EQ(results[i].calls, 1);
+    EXPECT_EQ(results[i].err, OK);
+    EXPECT_EQ(results[i].term, r->term_);
+    EXPECT_EQ(results[i].index, lastIndex + 1 + i);
+  }
+
+  // dropped during a leadership transfer
+  r->leadTransferee_ = 2;
+  proposeResult transfer;
+  EXPECT_EQ(n->ProposeWithCallback("c", recordResult(&transfer), &ready), ErrProposalDropped);
+  EXPECT_EQ(transfer.err, ErrProposalDropped);
+  r->leadTransferee_ = kEmptyPeerId;
+
+  delete n;
+}
+
+// TestNodeProposeBatchWithCallbacksFollower ensures that a follower only drops
+// the proposals of a batch with a callback, and forwards the others to the leader.
+TEST(nodeTests, TestNodeProposeBatchWithCallbacksFollower) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2, 3};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  r->becomeFollower(1, 2);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+  Ready *ready;
+  n->PollReady(&ready);
+  if (ready != NULL) {
+    n->Advance();
+  }
+
+  proposeResult results[2];
+  vector<string> datas = {"a", "b", "c", "d"};
+  vector<ProposeDone> dones = {recordResult(&results[0]), ProposeDone(),
+                               recordResult(&results[1]), ProposeDone()};
+  EXPECT_EQ(n->ProposeBatchWithCallbacks(std::move(datas), dones, &ready), ErrProposalDropped);
+  int i;
+  for (i = 0; i < 2; ++i) {
+    EXPECT_EQ(results[i].calls, 1);
+    EXPECT_EQ(results[i].err, ErrProposalDropped);
+  }
+
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  const Message *msg = ready->messages[0];
+  EXPECT_EQ(msg->type(), MsgProp);
+  EXPECT_EQ(msg->to(), 2);
+  EXPECT_EQ(msg->entries_size(), 2);
+  EXPECT_EQ(msg->entries(0).data(), "b");
+  EXPECT_EQ(msg->entries(1).data(), "d");
+  n->Advance();
+
+  delete n;
+}
+
+// TestNodeProposeTermChanged ensures that the uncommitted proposals fail once
+// the term changes, and the committed ones are still resolved.
+TEST(nodeTests, TestNodeProposeTermChanged) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2, 3};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  r->becomeCandidate();
+  r->becomeLeader();
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+  Ready *ready;
+  n->PollReady(&ready);
+  s->Append(ready->entries);
+  n->Advance();
+
+  uint64_t term = r->term_;
+  uint64_t lastIndex = r->raftLog_->lastIndex();
+  proposeResult committed, uncommitted;
+  EXPECT_EQ(n->ProposeWithCallback("a", recordResult(&committed), &ready), OK);
+  s->Append(ready->entries);
+  n->Advance();
+  EXPECT_EQ(n->ProposeWithCallback("b", recordResult(&uncommitted), &ready), OK);
+  s->Append(ready->entries);
+  n->Advance();
+
+  // "a" is acked by 2, which commits it
+  Message resp;
+  resp.set_type(MsgAppResp);
+  resp.set_from(2);
+  resp.set_to(1);
+  resp.set_term(term);
+  resp.set_index(lastIndex + 1);
+  n->Step(resp, &ready);
+  EXPECT_EQ(r->raftLog_->committed_, lastIndex + 1);
+  Ready *committedReady = ready;
+  EXPECT_EQ(committed.calls, 0);
+
+  // a new leader is elected
+  Message hb;
+  hb.set_type(MsgHeartbeat);
+  hb.set_from(3);
+  hb.set_to(1);
+  hb.set_term(term + 1);
+  n->Step(hb, &ready);
+  EXPECT_EQ(uncommitted.calls, 1);
+  EXPECT_EQ(uncommitted.err, ErrTermChanged);
+  EXPECT_EQ(uncommitted.index, lastIndex + 2);
+  EXPECT_EQ(committed.calls, 0);
+
+  EXPECT_EQ(committedReady->committedEntries.back()->index(), lastIndex + 1);
+  n->Advance();
+  EXPECT_EQ(committed.calls, 1);
+  EXPECT_EQ(committed.err, OK);
+  EXPECT_EQ(committed.index, lastIndex + 1);
+
+  delete n;
+}
+
+struct readResult {
+  int err;
+  uint64_t index;
+  int calls;
+
+  readResult() : err(-1), index(0), calls(0) {}
+};
+
+static ReadDone
+recordRead(readResult *result) {
+  return [result](int err, uint64_t index) {
+    result->err = err;
+    result->index = index;
+    result->calls++;
+  };
+}
+
+// TestNodeReadIndexWithCallback ensures that the reads of a follower issued
+// while a read index is requested share the next MsgReadIndex, and that they
+// are done once the applied index reaches the read index.
+TEST(nodeTests, TestNodeReadIndexWithCallback) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2, 3};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+  Ready *ready;
+
+  // no leader
+  readResult dropped;
+  EXPECT_EQ(n->ReadIndexWithCallback(recordRead(&dropped), &ready), ErrReadIndexDropped);
+  EXPECT_EQ(dropped.calls, 1);
+  EXPECT_EQ(dropped.err, ErrReadIndexDropped);
+
+  Message hb;
+  hb.set_type(MsgHeartbeat);
+  hb.set_from(2);
+  hb.set_to(1);
+  hb.set_term(1);
+  n->Step(hb, &ready);
+  n->Advance();
+
+  readResult results[3];
+  EXPECT_EQ(n->ReadIndexWithCallback(recordRead(&results[0]), &ready), OK);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  Message first = *ready->messages[0];
+  EXPECT_EQ(first.type(), MsgReadIndex);
+  EXPECT_EQ(first.to(), 2);
+  n->Advance();
+
+  // queued while the first batch is in flight
+  int i;
+  for (i = 1; i < 3; ++i) {
+    EXPECT_EQ(n->ReadIndexWithCallback(recordRead(&results[i]), &ready), OK);
+    EXPECT_TRUE(ready == NULL);
+  }
+
+  Message resp;
+  resp.set_type(MsgReadIndexResp);
+  resp.set_from(2);
+  resp.set_to(1);
+  resp.set_term(1);
+  resp.set_index(1);
+  resp.mutable_entries()->CopyFrom(first.entries());
+  n->Step(resp, &ready);
+  EXPECT_TRUE(ready != NULL);
+  // the read state of a batch is not handed out
+  EXPECT_TRUE(ready->readStates.empty());
+  // the second batch holds the other two reads
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  Message second = *ready->messages[0];
+  EXPECT_EQ(second.type(), MsgReadIndex);
+  EXPECT_NE(second.entries(0).data(), first.entries(0).data());
+  n->Advance();
+  EXPECT_EQ(results[0].calls, 0);
+
+  resp.mutable_entries()->CopyFrom(second.entries());
+  n->Step(resp, &ready);
+  n->Advance();
+  for (i = 0; i < 3; ++i) {
+    EXPECT_EQ(results[i].calls, 0);
+  }
+
+  // the entry at the read index is applied
+  Message app;
+  app.set_type(MsgApp);
+  app.set_from(2);
+  app.set_to(1);
+  app.set_term(1);
+  app.set_commit(1);
+  Entry *entry = app.add_entries();
+  entry->set_index(1);
+  entry->set_term(1);
+  n->Step(app, &ready);
+  EXPECT_EQ((int)ready->committedEntries.size(), 1);
+  s->Append(ready->entries);
+  EXPECT_EQ(results[0].calls, 0);
+  n->Advance();
+  for (i = 0; i < 3; ++i) {
+    EXPECT_EQ(results[i].calls, 1);
+    EXPECT_EQ(results[i].err, OK);
+    EXPECT_EQ(results[i].index, 1);
+  }
+
+  // the applied index has reached 1
+  readResult applied;
+  n->WaitApplied(1, recordRead(&applied));
+  EXPECT_EQ(applied.calls, 1);
+  EXPECT_EQ(applied.err, OK);
+
+  readResult stopped;
+  n->WaitApplied(2, recordRead(&stopped));
+  EXPECT_EQ(stopped.calls, 0);
+  n->Stop();
+  EXPECT_EQ(stopped.calls, 1);
+  EXPECT_EQ(stopped.err, ErrStopped);
+
+  delete n;
+}
+
+// TestNodeReadIndexWithCallbackRetry ensures that a batch without a response
+// is sent again after an election timeout, and the response to the batch
+// given up is ignored.
+TEST(nodeTests, TestNodeReadIndexWithCallbackRetry) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2, 3};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+  Ready *ready;
+
+  Message hb;
+  hb.set_type(MsgHeartbeat);
+  hb.set_from(2);
+  hb.set_to(1);
+  hb.set_term(1);
+  n->Step(hb, &ready);
+  n->Advance();
+
+  readResult result;
+  n->ReadIndexWithCallback(recordRead(&result), &ready);
+  Message first = *ready->messages[0];
+  n->Advance();
+
+  int i;
+  bool resent = false;
+  for (i = 0; i < r->electionTimeout_ && !resent; ++i) {
+    // heartbeats keep the follower from campaigning
+    n->Step(hb, &ready);
+    if (ready != NULL) {
+      n->Advance();
+    }
+    n->Tick(&ready);
+    if (ready == NULL) {
+      continue;
+    }
+    size_t j;
+    for (j = 0; j < ready->messages.size(); ++j) {
+      if (ready->messages[j]->type() == MsgReadIndex) {
+        EXPECT_NE(ready->messages[j]->entries(0).data(), first.entries(0).data());
+        resent = true;
+      }
+    }
+    n->Advance();
+  }
+  EXPECT_TRUE(resent);
+
+  Message resp;
+  resp.set_type(MsgReadIndexResp);
+  resp.set_from(2);
+  resp.set_to(1);
+  resp.set_term(1);
+  resp.set_index(0);
+  resp.mutable_entries()->CopyFrom(first.entries());
+  n->Step(resp, &ready);
+  EXPECT_EQ(result.calls, 0);
+  EXPECT_TRUE(ready == NULL || ready->readStates.empty());
+
+  delete n;
+}
+
+// TestNodeAsyncReady ensures that with the asynchronous Ready pipeline a new
+// Ready is returned while the earlier ones are being persisted, and that the
+// committed entries are only handed out once they are stable.
+TEST(nodeTests, TestNodeAsyncReady) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+  n->asyncReady_ = true;
+
+  Ready *ready;
+  n->Campaign(&ready);
+  while (ready != NULL) {
+    s->Append(ready->entries);
+    n->AdvanceStable(ready);
+    n->AdvanceSent(ready);
+    n->AdvanceApplied(ready);
+    n->PollReady(&ready);
+  }
+  EXPECT_EQ(r->state_, StateLeader);
+  uint64_t lastIndex = r->raftLog_->lastIndex();
+  EXPECT_EQ(r->raftLog_->applied_, lastIndex);
+
+  proposeResult result;
+  Ready *rd1, *rd2, *rd3, *rd4;
+  EXPECT_EQ(n->ProposeWithCallback("a", recordResult(&result), &rd1), OK);
+  EXPECT_TRUE(rd1 != NULL);
+  EXPECT_EQ((int)rd1->entries.size(), 1);
+  // committed but not stable yet
+  EXPECT_EQ(r->raftLog_->committed_, lastIndex + 1);
+  EXPECT_TRUE(rd1->committedEntries.empty());
+
+  // rd1 is still being persisted
+  n->Propose("b", &rd2);
+  EXPECT_TRUE(rd2 != NULL);
+  EXPECT_EQ((int)rd2->entries.size(), 1);
+  EXPECT_EQ(rd2->entries[0]->index(), lastIndex + 2);
+  EXPECT_TRUE(rd2->committedEntries.empty());
+
+  s->Append(rd1->entries);
+  n->AdvanceStable(rd1);
+  n->AdvanceSent(rd1);
+  n->PollReady(&rd3);
+  EXPECT_TRUE(rd3 != NULL);
+  EXPECT_TRUE(rd3->entries.empty());
+  EXPECT_EQ((int)rd3->committedEntries.size(), 1);
+  EXPECT_EQ(rd3->committedEntries[0]->index(), lastIndex + 1);
+
+  // "b" is persisted while "a" is being applied
+  s->Append(rd2->entries);
+  n->AdvanceStable(rd2);
+  n->AdvanceSent(rd2);
+  n->PollReady(&rd4);
+  EXPECT_TRUE(rd4 != NULL);
+  EXPECT_EQ((int)rd4->committedEntries.size(), 1);
+  EXPECT_EQ(rd4->committedEntries[0]->index(), lastIndex + 2);
+
+  // nothing else to hand out
+  n->PollReady(&ready);
+  EXPECT_TRUE(ready == NULL);
+
+  n->AdvanceApplied(rd1);
+  n->AdvanceApplied(rd2);
+  EXPECT_EQ(r->raftLog_->applied_, lastIndex);
+  n->AdvanceStable(rd3);
+  n->AdvanceSent(rd3);
+  n->AdvanceApplied(rd3);
+  EXPECT_EQ(r->raftLog_->applied_, lastIndex + 1);
+  EXPECT_EQ(result.calls, 1);
+  EXPECT_EQ(result.err, OK);
+  n->AdvanceStable(rd4);
+  n->AdvanceSent(rd4);
+  n->AdvanceApplied(rd4);
+  EXPECT_EQ(r->raftLog_->applied_, lastIndex + 2);
+
+  // the slots are recycled
+  EXPECT_EQ(n->freeSlots_.size(), n->slots_.size());
+  n->Propose("c", &ready);
+  EXPECT_EQ(n->freeSlots_.size() + 1, n->slots_.size());
+
+  delete n;
+}
+
+// TestNodeParallelAppend ensures that with parallelAppend the Ready of the
+// leader can be sent first, and its entries commit once they are stable.
+TEST(nodeTests, TestNodeParallelAppend) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  Config *c = newTestConfig(1, {1}, 10, 1, s);
+  c->parallelAppend = true;
+  raft *r = newRaft(c);
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+
+  // the term and vote must be saved first
+  Ready *ready;
+  n->Campaign(&ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ(r->state_, StateLeader);
+  EXPECT_FALSE(ready->sendFirst);
+  EXPECT_EQ((int)ready->entries.size(), 1);
+  EXPECT_TRUE(ready->committedEntries.empty());
+  s->Append(ready->entries);
+  n->Advance();
+
+  n->PollReady(&ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->committedEntries.size(), 1);
+  n->Advance();
+
+  n->Propose("a", &ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_TRUE(ready->sendFirst);
+  EXPECT_EQ((int)ready->entries.size(), 1);
+  EXPECT_TRUE(ready->committedEntries.empty());
+  uint64_t index = ready->entries[0]->index();
+  s->Append(ready->entries);
+  n->Advance();
+  EXPECT_EQ(r->raftLog_->committed_, index);
+
+  delete n;
+}
+
+// TestNodeReadyArena ensures that the messages of a Ready are allocated from
+// one arena, and messages produced before Advance survive it to the next Ready.
+TEST(nodeTests, TestNodeReadyArena) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  r->becomeFollower(1, 2);
+  NodeImpl *n = new NodeImpl(defaultLogger, r); 
+
+  Ready *ready;
+  n->Propose("a", &ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  google::protobuf::Arena *arena = ready->messages[0]->GetArena();
+  EXPECT_TRUE(arena != NULL);
+
+  // the Ready has not been advanced yet
+  Ready *nready;
+  n->Propose("b", &nready);
+  EXPECT_TRUE(nready == NULL);
+  n->Advance();
+
+  n->Tick(&ready);
+  EXPECT_TRUE(ready != NULL);
+  EXPECT_EQ((int)ready->messages.size(), 1);
+  Message *msg = ready->messages[0];
+  EXPECT_TRUE(msg->GetArena() != NULL);
+  EXPECT_TRUE(msg->GetArena() != arena);
+  EXPECT_EQ(msg->type(), MsgProp);
+  EXPECT_EQ(msg->entries(0).data(), "b");
+  n->Advance();
+
+  delete n;
+}
+
+// TestNodeShareAppendEntries ensures that the MsgApps of a Ready refer to
+// the entries of the log rather than copies of them.
+TEST(nodeTests, TestNodeShareAppendEntries) {
+  Logger *defaultLogger = new DefaultLogger();
+  MemoryStorage *s = new MemoryStorage(defaultLogger);
+  vector<uint64_t> peers = {1, 2, 3};
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+  r->becomeCandidate();
+  r->becomeLeader();
+  NodeImpl *n = new NodeImpl(defaultLogger, r);
+
+  Ready *ready;
+  n->Propose("a", &ready);
+  EXPECT_TRUE(ready != NULL);
+  const Entry *last = ready->entries.back().get();
+  EXPECT_EQ(last->data(), "a");
+  vector<Message*> apps;
+  size_t i;
+  for (i = 0; i < ready->messages.size(); ++i) {
+    if (ready->messages[i]->type() == MsgApp) {
+      apps.push_back(ready->messages[i]);
+    }
+  }
+  EXPECT_EQ((int)apps.size(), 2);
+  for (i = 0; i < apps.size(); ++i) {
+    const Message *msg = apps[i];
+    EXPECT_EQ(&msg->entries(msg->entries_size() - 1), last) << "to: " << msg->to();
+  }
+
+  // the entries outlive the messages released by Advance
+  s->Append(ready->entries);
+  n->Advance();
+  EXPECT_EQ(last->data(), "a");
+
+  delete n;
+}
+
 // TestNodeProposeAddDuplicateNode ensures that two proposes to add the same node should
 // not affect the later propose to add new node.
 void applyReadyEntries(Ready* ready, EntryVec* readyEntries, MemoryStorage *s, NodeImpl *n) {
@@ -203,7 +842,7 @@ void applyReadyEntries(Ready* ready, EntryVec* readyEntries, MemoryStorage *s, N
   s->Append(ready->entries);
   Ready *nready;
   for (i = 0; i < ready->entries.size(); ++i) {
-    const Entry& entry = ready->entries[i];
+    const Entry& entry = *ready->entries[i];
     
     readyEntries->push_back(entry);
     if (entry.type() == EntryNormal || entry.type() == EntryConfChange) {
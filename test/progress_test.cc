@@ -168,3 +168,208 @@ TEST(progressTests, TestInflightFreeFirstOne) {
     EXPECT_EQ(true, deepEqualInflights(ins, wantIns));
   }
 }
+
+TEST(progressTests, TestProgressReinit) {
+  Progress pr(5, 10, &kDefaultLogger);
+  pr.setMatch(4);
+  pr.recentActive_ = true;
+  pr.becomeReplicate();
+  int i;
+  for (i = 0; i < 10; ++i) {
+    pr.inflights_.add(i);
+  }
+  EXPECT_TRUE(pr.inflights_.full());
+
+  pr.reinit(8, 20);
+
+  EXPECT_EQ(pr.match_, 0);
+  EXPECT_EQ(pr.next_, 8);
+  EXPECT_EQ(pr.state_, ProgressStateProbe);
+  EXPECT_FALSE(pr.paused_);
+  EXPECT_FALSE(pr.recentActive_);
+  EXPECT_EQ(pr.pendingSnapshot_, 0);
+  EXPECT_EQ(pr.inflights_.count_, 0);
+  EXPECT_EQ(pr.inflights_.size_, 20);
+  EXPECT_FALSE(pr.inflights_.full());
+}
+
+TEST(progressTests, TestInflightsBytes) {
+  inflights ins(10, &kDefaultLogger, 100);
+
+  ins.add(1, 40);
+  ins.add(2, 40);
+  EXPECT_FALSE(ins.full());
+  ins.add(3, 40);
+  // the bytes exceed the limit before the count does
+  EXPECT_TRUE(ins.full());
+  EXPECT_EQ(ins.bytes_, 120);
+
+  ins.freeTo(2);
+  EXPECT_FALSE(ins.full());
+  EXPECT_EQ(ins.bytes_, 40);
+
+  // a single message larger than the limit is still allowed
+  ins.freeTo(3);
+  ins.add(4, 1000);
+  EXPECT_TRUE(ins.full());
+  ins.freeFirstOne();
+  EXPECT_EQ(ins.bytes_, 0);
+
+  ins.add(5, 60);
+  ins.reinit(10, 50);
+  EXPECT_EQ(ins.bytes_, 0);
+  EXPECT_FALSE(ins.full());
+
+  // without a limit the sizes are not kept
+  inflights unlimited(10, &kDefaultLogger);
+  unlimited.add(1, 40);
+  EXPECT_TRUE(unlimited.sizes_.empty());
+  EXPECT_EQ(unlimited.bytes_, 0);
+  ins.reinit(10, 0);
+  EXPECT_TRUE(ins.sizes_.empty());
+}
+
+// TestFlowControl ensures that the window grows while the round trip stays
+// at its lowest, and the window then the message size shrink once the
+// messages queue up.
+TEST(progressTests, TestFlowControl) {
+  Progress pr(1, 64, &kDefaultLogger);
+  // the send times are only kept for the flow control
+  EXPECT_TRUE(pr.inflights_.sentAt_.empty());
+  pr.enableFlowControl(4, 1000, 8000);
+  EXPECT_EQ((int)pr.inflights_.sentAt_.size(), 64);
+  pr.becomeReplicate();
+  EXPECT_EQ(pr.inflights_.limit_, 4);
+  EXPECT_EQ(pr.sizePerMsg(1 << 20), 8000);
+
+  uint64_t now = 1000000, index = 0;
+  int round;
+  // a fast link, the window doubles each round trip up to the max
+  for (round = 0; round < 8; ++round) {
+    pr.inflights_.add(++index, 100, now);
+    now += 1000;
+    pr.ackTo(index, now);
+  }
+  EXPECT_EQ(pr.flow_.minRtt_, 1000);
+  EXPECT_EQ(pr.inflights_.limit_, 64);
+  EXPECT_FALSE(pr.inflights_.full());
+
+  // the messages queue up
+  for (round = 0; round < 64; ++round) {
+    pr.inflights_.add(++index, 100, now);
+    now += 10000;
+    pr.ackTo(index, now);
+  }
+  EXPECT_FALSE(pr.flow_.slowStart_);
+  EXPECT_EQ(pr.inflights_.limit_, 4);
+  EXPECT_EQ(pr.sizePerMsg(1 << 20), 1000);
+
+  // back to a fast link, the size grows back before the window
+  for (round = 0; round < 64 && pr.sizePerMsg(1 << 20) < 8000; ++round) {
+    pr.inflights_.add(++index, 100, now);
+    now += 1000;
+    pr.ackTo(index, now);
+    EXPECT_EQ(pr.inflights_.limit_, 4);
+  }
+  EXPECT_EQ(pr.sizePerMsg(1 << 20), 8000);
+  for (round = 0; round < 64; ++round) {
+    pr.inflights_.add(++index, 100, now);
+    now += 1000;
+    pr.ackTo(index, now);
+  }
+  EXPECT_GT(pr.inflights_.limit_, 4);
+
+  // probing restarts from the min window, keeping the round trip
+  pr.becomeProbe();
+  pr.becomeReplicate();
+  EXPECT_EQ(pr.inflights_.limit_, 4);
+  EXPECT_EQ(pr.flow_.minRtt_, 1000);
+}
+
+// TestQuorumTracker ensures that the tracked quorum index is the one of the
+// sorted match indexes whatever the order of the updates.
+TEST(progressTests, TestQuorumTracker) {
+  srand(1);
+  const int voters = 9;
+  quorumTracker tracker;
+  vector<Progress*> prs;
+  int i;
+  for (i = 0; i < voters; ++i) {
+    prs.push_back(new Progress(1, 10, &kDefaultLogger));
+    prs[i]->setMatch(rand() % 4);
+    tracker.add(prs[i]);
+  }
+
+  int round;
+  for (round = 0; round < 1000; ++round) {
+    Progress *pr = prs[rand() % voters];
+    pr->maybeUpdate(pr->match_ + rand() % 3);
+
+    vector<uint64_t> matches;
+    for (i = 0; i < voters; ++i) {
+      matches.push_back(prs[i]->match_);
+    }
+    sort(matches.begin(), matches.end(), greater<uint64_t>());
+    EXPECT_EQ(tracker.matches_, matches) << "round: " << round;
+    EXPECT_EQ(tracker.quorumIndex(voters / 2 + 1), matches[voters / 2]);
+  }
+
+  // setMatch moves the index in the tracker, down as well as up
+  prs[1]->setMatch(0);
+  vector<uint64_t> matches;
+  for (i = 0; i < voters; ++i) {
+    matches.push_back(prs[i]->match_);
+  }
+  sort(matches.begin(), matches.end(), greater<uint64_t>());
+  EXPECT_EQ(tracker.matches_, matches);
+
+  // a progress removed is not tracked any more
+  tracker.remove(prs[0]);
+  EXPECT_EQ((int)tracker.matches_.size(), voters - 1);
+  prs[0]->maybeUpdate(prs[0]->match_ + 1);
+  EXPECT_EQ((int)tracker.matches_.size(), voters - 1);
+
+  for (i = 0; i < voters; ++i) {
+    delete prs[i];
+  }
+}
+
+// TestProgressTable ensures that the progress table keeps the peers ordered
+// by id, and that setting an existing peer reuses and reinits its entry.
+TEST(progressTests, TestProgressTable) {
+  progressTable prs;
+  uint64_t ids[] = {5, 1, 3, 2, 4};
+  size_t i;
+  for (i = 0; i < 5; ++i) {
+    Progress *pr = prs.set(ids[i], ids[i] * 10, 10, &kDefaultLogger);
+    pr->setMatch(ids[i]);
+  }
+
+  EXPECT_EQ((int)prs.size(), 5);
+  for (i = 0; i < prs.size(); ++i) {
+    EXPECT_EQ(prs.id(i), i + 1);
+    EXPECT_EQ(prs.at(i)->match_, i + 1);
+    EXPECT_EQ(prs.at(i)->next_, (i + 1) * 10);
+    EXPECT_EQ(prs[i + 1], prs.at(i));
+  }
+  EXPECT_TRUE(prs[6] == NULL);
+  EXPECT_FALSE(prs.contains(0));
+
+  Progress *pr = prs[3];
+  pr->becomeReplicate();
+  pr->inflights_.add(40);
+  EXPECT_EQ(prs.set(3, 100, 10, &kDefaultLogger), pr);
+  EXPECT_EQ(pr->match_, 0);
+  EXPECT_EQ(pr->next_, 100);
+  EXPECT_EQ(pr->state_, ProgressStateProbe);
+  EXPECT_EQ(pr->inflights_.count_, 0);
+
+  prs.erase(3);
+  prs.erase(6);
+  vector<uint64_t> wids = {1, 2, 4, 5};
+  EXPECT_EQ(prs.ids_, wids);
+  EXPECT_EQ(prs[4]->match_, 4);
+
+  prs.clear();
+  EXPECT_TRUE(prs.empty());
+}
@@ -203,3 +203,120 @@ TEST(raftFlowController, TestMsgAppFlowControlRecvHeartbeat) {
 
   delete r;
 }
+
+// TestMsgAppFlowControlBytes ensures:
+// 1. msgApp can fill the sending window until its bytes reach maxInflightBytes
+// 2. when the window is full, no more msgApp can be sent.
+// 3. a msgAppResp releases the bytes of the acked msgApps.
+TEST(raftFlowController, TestMsgAppFlowControlBytes) {
+  vector<uint64_t> peers = {1,2};
+  Storage *s = new MemoryStorage(&kDefaultLogger);
+  Config *c = newTestConfig(1, peers, 5, 1, s);
+  c->maxInflightBytes = 4 * 8;
+  raft *r = newRaft(c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  Progress *pr2 = r->progressMap_[2];
+
+  // force the progress to be in replicate state
+  pr2->becomeReplicate();
+  // fill in the inflights window, 8 bytes per message
+  int i;
+  for (i = 0; i < 4; ++i) {
+    EXPECT_FALSE(pr2->inflights_.full());
+    {
+      EntryVec entries = {initEntry(0,0,"somedata")};
+      Message msg = initMessage(1,1,MsgProp,&entries);
+      r->step(msg);
+    }
+
+    MessageVec msgs;
+    r->readMessages(&msgs);
+    EXPECT_EQ((int)msgs.size(), 1);
+  }
+
+  // ensure 1
+  EXPECT_TRUE(pr2->inflights_.full());
+  EXPECT_EQ(pr2->inflights_.bytes_, 4 * 8);
+  EXPECT_EQ((int)pr2->inflights_.count_, 4);
+
+  // ensure 2
+  {
+    EntryVec entries = {initEntry(0,0,"somedata")};
+    Message msg = initMessage(1,1,MsgProp,&entries);
+    r->step(msg);
+  }
+  MessageVec msgs;
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 0);
+
+  // ensure 3: ack the first 2 msgApps after the empty entry of the leader
+  {
+    Message msg;
+    msg.set_from(2);
+    msg.set_to(1);
+    msg.set_type(MsgAppResp);
+    msg.set_term(r->term_);
+    msg.set_index(3);
+    r->step(msg);
+  }
+  // the held back entry is sent at once
+  EXPECT_EQ(pr2->inflights_.bytes_, 2 * 8 + 8);
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 1);
+}
+
+// TestMsgAppFlowControlAdaptive ensures:
+// 1. with adaptiveInflight the window starts from minInflightMsgs
+// 2. the window grows as the msgApps are acked at the lowest round trip
+TEST(raftFlowController, TestMsgAppFlowControlAdaptive) {
+  vector<uint64_t> peers = {1,2};
+  Storage *s = new MemoryStorage(&kDefaultLogger);
+  manualClock clock;
+  Config *c = newTestConfig(1, peers, 5, 1, s);
+  c->adaptiveInflight = true;
+  c->minInflightMsgs = 2;
+  c->clock = &clock;
+  raft *r = newRaft(c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  Progress *pr2 = r->progressMap_[2];
+  pr2->becomeReplicate();
+
+  // ensure 1
+  int i;
+  for (i = 0; i < 3; ++i) {
+    EntryVec entries = {initEntry(0,0,"somedata")};
+    Message msg = initMessage(1,1,MsgProp,&entries);
+    r->step(msg);
+  }
+  MessageVec msgs;
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 2);
+  EXPECT_TRUE(pr2->inflights_.full());
+
+  // ensure 2
+  int round;
+  for (round = 0; round < 4; ++round) {
+    clock.now_ += 1000;
+    Message resp;
+    resp.set_from(2);
+    resp.set_to(1);
+    resp.set_type(MsgAppResp);
+    resp.set_term(r->term_);
+    resp.set_index(r->raftLog_->lastIndex());
+    r->step(resp);
+    r->readMessages(&msgs);
+
+    for (i = 0; i < 8; ++i) {
+      EntryVec entries = {initEntry(0,0,"somedata")};
+      Message msg = initMessage(1,1,MsgProp,&entries);
+      r->step(msg);
+    }
+    r->readMessages(&msgs);
+  }
+  EXPECT_EQ(pr2->flow_.minRtt_, 1000);
+  EXPECT_GE(pr2->inflights_.limit_, 8);
+  // none of the last proposals is held back
+  EXPECT_EQ((int)msgs.size(), 8);
+}
@@ -1116,23 +1116,24 @@ TEST(raftPaperTests, TestFollowerCheckMsgApp) {
     uint64_t windex;
     bool wreject;
     uint64_t wrejectHint;
+    uint64_t wlogTerm;
 
-    tmp(uint64_t t, uint64_t i, uint64_t wi, bool wr, uint64_t wrh)
-      : term(t), index(i), windex(wi), wreject(wr), wrejectHint(wrh) {}
+    tmp(uint64_t t, uint64_t i, uint64_t wi, bool wr, uint64_t wrh, uint64_t wlt)
+      : term(t), index(i), windex(wi), wreject(wr), wrejectHint(wrh), wlogTerm(wlt) {}
   };
 
   vector<tmp> tests;
 
   // match with committed entries
-  tests.push_back(tmp(0, 0, 1, false, 0));
-  tests.push_back(tmp(entries[0].term(), entries[0].index(), 1, false, 0));
+  tests.push_back(tmp(0, 0, 1, false, 0, 0));
+  tests.push_back(tmp(entries[0].term(), entries[0].index(), 1, false, 0, 0));
   // match with uncommitted entries
-  tests.push_back(tmp(entries[1].term(), entries[1].index(), 2, false, 0));
+  tests.push_back(tmp(entries[1].term(), entries[1].index(), 2, false, 0, 0));
 
   // unmatch with existing entry
-  tests.push_back(tmp(entries[0].term(), entries[1].index(), entries[1].index(), true, 2));
+  tests.push_back(tmp(entries[0].term(), entries[1].index(), entries[1].index(), true, 1, 1));
   // unexisting entry
-  tests.push_back(tmp(entries[1].term() + 1, entries[1].index() + 1, entries[1].index() + 1, true, 2));
+  tests.push_back(tmp(entries[1].term() + 1, entries[1].index() + 1, entries[1].index() + 1, true, 2, 2));
   
   size_t i;
   for (i = 0; i < tests.size(); ++i) {
@@ -1174,6 +1175,7 @@ TEST(raftPaperTests, TestFollowerCheckMsgApp) {
       msg->set_index(t.windex);
       msg->set_reject(t.wreject);
       msg->set_rejecthint(t.wrejectHint);
+      msg->set_logterm(t.wlogTerm);
       wmsgs.push_back(msg);
     }
 
@@ -233,7 +233,7 @@ TEST(raftTests, TestProgressMaybeDecr) {
   for (i = 0; i < SIZEOF_ARRAY(tests); ++i) {
     tmp &t = tests[i];
     Progress p(t.n, 256, &kDefaultLogger);
-    p.match_ = t.m;
+    p.setMatch(t.m);
     p.state_ = t.state;
 
     bool g = p.maybeDecrTo(t.rejected, t.last);
@@ -2395,7 +2395,7 @@ TEST(raftTests, TestRaftFreesReadOnlyMem) {
 
   r->raftLog_->commitTo(r->raftLog_->lastIndex());
 
-  string ctx = "ctx";
+  string ctx = "ctx", roundCtx;
   MessageVec msgs;
 
   // leader starts linearizable read request.
@@ -2411,10 +2411,11 @@ TEST(raftTests, TestRaftFreesReadOnlyMem) {
     r->readMessages(&msgs);
     EXPECT_EQ((int)msgs.size(), 1);
     EXPECT_EQ(msgs[0]->type(), MsgHeartbeat);
-    EXPECT_EQ(msgs[0]->context(), ctx);
-    EXPECT_EQ((int)r->readOnly_->readIndexQueue_.size(), 1);
-    EXPECT_EQ((int)r->readOnly_->pendingReadIndex_.size(), 1);
-    EXPECT_NE(r->readOnly_->pendingReadIndex_.find(ctx), r->readOnly_->pendingReadIndex_.end());
+    // the heartbeat carries the context of the round, not the one of the request
+    roundCtx = msgs[0]->context();
+    EXPECT_FALSE(roundCtx.empty());
+    EXPECT_NE(roundCtx, ctx);
+    EXPECT_EQ((int)r->readOnly_->pending(), 1);
   }
   // heartbeat responses from majority of followers (1 in this case)
   // acknowledge the authority of the leader.
@@ -2423,12 +2424,157 @@ TEST(raftTests, TestRaftFreesReadOnlyMem) {
     Message m;
     m.set_from(2);
     m.set_type(MsgHeartbeatResp);
-    m.set_context(ctx);
+    m.set_context(roundCtx);
     r->step(m);
 
-    EXPECT_EQ((int)r->readOnly_->readIndexQueue_.size(), 0);
-    EXPECT_EQ((int)r->readOnly_->pendingReadIndex_.size(), 0);
-    EXPECT_EQ(r->readOnly_->pendingReadIndex_.find(ctx), r->readOnly_->pendingReadIndex_.end());
+    EXPECT_EQ((int)r->readOnly_->pending(), 0);
+    EXPECT_FALSE(r->readOnly_->roundInFlight());
+  }
+}
+
+// TestReadIndexBatched ensures that the read only requests arriving while a
+// heartbeat round is in flight share the next round, and that a round
+// acked by a quorum confirms its requests in the order they arrived.
+TEST(raftTests, TestReadIndexBatched) {
+  vector<uint64_t> peers = {1,2,3};
+  raft *r = newTestRaft(1, peers, 10, 1, new MemoryStorage(&kDefaultLogger));
+  r->becomeCandidate();
+  r->becomeLeader();
+  r->raftLog_->commitTo(r->raftLog_->lastIndex());
+
+  MessageVec msgs;
+  r->readMessages(&msgs);
+
+  vector<string> ctxs = {"ctx1", "ctx2", "ctx3", "ctx4"};
+  size_t i;
+  for (i = 0; i < ctxs.size(); ++i) {
+    Message m;
+    m.set_from(1);
+    m.set_type(MsgReadIndex);
+    m.add_entries()->set_data(ctxs[i]);
+    r->step(m);
+  }
+  // only the first request starts a round, a heartbeat to each follower
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 2);
+  string round1 = msgs[0]->context();
+
+  Message ack;
+  ack.set_from(2);
+  ack.set_type(MsgHeartbeatResp);
+  ack.set_context(round1);
+  r->step(ack);
+  EXPECT_EQ((int)r->readStates_.size(), 1);
+  EXPECT_EQ(r->readStates_[0]->requestCtx_, "ctx1");
+  r->readStates_.clear();
+
+  // the requests queued behind it share the next round, the follower
+  // which is behind is sent its entries as well
+  r->readMessages(&msgs);
+  string round2;
+  int heartbeats = 0;
+  for (i = 0; i < msgs.size(); ++i) {
+    if (msgs[i]->type() == MsgHeartbeat) {
+      round2 = msgs[i]->context();
+      ++heartbeats;
+    }
+  }
+  EXPECT_EQ(heartbeats, 2);
+  EXPECT_NE(round1, round2);
+
+  // a late ack of the first round confirms nothing more
+  ack.set_from(3);
+  r->step(ack);
+  EXPECT_TRUE(r->readStates_.empty());
+
+  ack.set_context(round2);
+  r->step(ack);
+  EXPECT_EQ((int)r->readStates_.size(), 3);
+  for (i = 0; i < r->readStates_.size(); ++i) {
+    EXPECT_EQ(r->readStates_[i]->requestCtx_, ctxs[i + 1]);
+    EXPECT_EQ(r->readStates_[i]->index_, r->raftLog_->committed_);
+  }
+  r->readStates_.clear();
+  EXPECT_EQ((int)r->readOnly_->pending(), 0);
+
+  delete r;
+}
+
+// TestReadOnlyRing ensures that the read only requests keep their order
+// while the ring buffer wraps around and grows, and that an ack of a round
+// counts for the earlier rounds in flight.
+TEST(raftTests, TestReadOnlyRing) {
+  readOnly ro(ReadOnlySafe, &kDefaultLogger);
+  uint64_t next = 0, want = 0;
+  vector<readIndexStatus*> rss;
+  Message req, ack;
+  ack.set_type(MsgHeartbeatResp);
+
+  int i, round;
+  for (round = 0; round < 8; ++round) {
+    // a round in flight with another one queued behind it
+    for (i = 0; i < 10 + round * 3; ++i) {
+      ro.addRequest(next++, req);
+    }
+    string ctx1 = ro.nextRound();
+    for (i = 0; i < 5; ++i) {
+      ro.addRequest(next++, req);
+    }
+    EXPECT_TRUE(ro.hasUnsentRequest());
+    string ctx2 = ro.nextRound();
+    EXPECT_FALSE(ro.hasUnsentRequest());
+
+    // follower 2 acks the later round, follower 3 the earlier
+    ack.set_from(2);
+    ack.set_context(ctx2);
+    EXPECT_EQ(ro.recvAck(ack), 2);
+    ack.set_from(3);
+    ack.set_context(ctx1);
+    EXPECT_EQ(ro.recvAck(ack), 3);
+
+    rss.clear();
+    ro.advance(ack, &rss);
+    ack.set_context(ctx2);
+    ro.advance(ack, &rss);
+    EXPECT_EQ(rss.size(), next - want);
+    size_t j;
+    for (j = 0; j < rss.size(); ++j) {
+      EXPECT_EQ(rss[j]->index_, want++);
+    }
+    EXPECT_EQ((int)ro.pending(), 0);
+    EXPECT_FALSE(ro.roundInFlight());
+    EXPECT_EQ(ro.lastRoundCtx(), "");
+  }
+  // a stale ack confirms nothing
+  EXPECT_EQ(ro.recvAck(ack), 0);
+}
+
+// TestReadOnlyManyAckers ensures that every follower acking a round counts,
+// however many there are, and that the followers of a finished round take no
+// room in the later ones.
+TEST(raftTests, TestReadOnlyManyAckers) {
+  readOnly ro(ReadOnlySafe, &kDefaultLogger);
+  vector<readIndexStatus*> rss;
+  Message req, ack;
+  ack.set_type(MsgHeartbeatResp);
+
+  uint64_t from = 2;
+  int round;
+  for (round = 0; round < 3; ++round) {
+    ro.addRequest(round, req);
+    ack.set_context(ro.nextRound());
+    int i;
+    for (i = 0; i < 100; ++i) {
+      ack.set_from(from++);
+      EXPECT_EQ(ro.recvAck(ack), i + 2) << "round: " << round;
+    }
+    // an ack repeated counts once
+    EXPECT_EQ(ro.recvAck(ack), 101);
+
+    rss.clear();
+    ro.advance(ack, &rss);
+    EXPECT_EQ((int)rss.size(), 1);
+    EXPECT_FALSE(ro.roundInFlight());
   }
 }
 
@@ -3250,6 +3396,8 @@ TEST(raftTests, TestReadOnlyOptionLease) {
   }
 }
 
+// TestReadOnlyOptionLeaseWithoutCheckQuorum ensures that the leader holds no
+// lease without checkQuorum, and serves the read as ReadOnlySafe.
 TEST(raftTests, TestReadOnlyOptionLeaseWithoutCheckQuorum) {
   vector<uint64_t> peers;
   vector<stateMachine*> sts;
@@ -3304,10 +3452,126 @@ TEST(raftTests, TestReadOnlyOptionLeaseWithoutCheckQuorum) {
     net->send(&msgs);
   }
   ReadState *s = b->readStates_[0];
-  EXPECT_EQ(s->index_, kEmptyPeerId);
+  EXPECT_EQ(s->index_, a->raftLog_->committed_);
   EXPECT_EQ(s->requestCtx_, ctx);
 }
 
+// TestReadOnlyOptionLeaseClock ensures that:
+// 1. the leader without the lease serves a read as ReadOnlySafe, its heartbeats
+//    carry the time they are sent at
+// 2. once a quorum acked them, the leader serves the reads locally until
+//    leaseDuration less maxClockDrift has passed since they were sent
+// 3. the leader does not use the lease while transferring the leadership
+TEST(raftTests, TestReadOnlyOptionLeaseClock) {
+  vector<uint64_t> peers = {1,2,3};
+  manualClock clock;
+  clock.now_ = 1000;
+  Config *c = newTestConfig(1, peers, 10, 1, new MemoryStorage(&kDefaultLogger));
+  c->readOnlyOption = ReadOnlyLeaseBased;
+  c->checkQuorum = true;
+  c->leaseDuration = 100;
+  c->maxClockDrift = 10;
+  c->clock = &clock;
+  raft *r = newRaft(c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  {
+    Message msg;
+    msg.set_from(2);
+    msg.set_to(1);
+    msg.set_type(MsgAppResp);
+    msg.set_term(r->term_);
+    msg.set_index(r->raftLog_->lastIndex());
+    r->step(msg);
+  }
+  uint64_t committed = r->raftLog_->committed_;
+  EXPECT_EQ(committed, 1);
+  MessageVec msgs;
+  r->readMessages(&msgs);
+
+  Message read;
+  read.set_from(1);
+  read.set_to(1);
+  read.set_type(MsgReadIndex);
+
+  // ensure 1
+  read.add_entries()->set_data("ctx1");
+  r->step(read);
+  EXPECT_TRUE(r->readStates_.empty());
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 2);
+  size_t i;
+  for (i = 0; i < msgs.size(); ++i) {
+    EXPECT_EQ(msgs[i]->type(), MsgHeartbeat);
+    EXPECT_EQ(msgs[i]->leasesentat(), 1000);
+  }
+  {
+    Message msg;
+    msg.set_from(2);
+    msg.set_to(1);
+    msg.set_type(MsgHeartbeatResp);
+    msg.set_term(r->term_);
+    msg.set_leasesentat(1000);
+    msg.set_context(msgs[0]->context());
+    r->step(msg);
+  }
+  EXPECT_EQ((int)r->readStates_.size(), 1);
+  EXPECT_EQ(r->readStates_[0]->requestCtx_, "ctx1");
+  r->readStates_.clear();
+  r->readMessages(&msgs);
+
+  // ensure 2
+  clock.now_ = 1089;
+  read.mutable_entries(0)->set_data("ctx2");
+  r->step(read);
+  EXPECT_EQ((int)r->readStates_.size(), 1);
+  EXPECT_EQ(r->readStates_[0]->index_, committed);
+  EXPECT_EQ(r->readStates_[0]->requestCtx_, "ctx2");
+  r->readStates_.clear();
+  r->readMessages(&msgs);
+  EXPECT_TRUE(msgs.empty());
+
+  clock.now_ = 1090;
+  read.mutable_entries(0)->set_data("ctx3");
+  r->step(read);
+  EXPECT_TRUE(r->readStates_.empty());
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 2);
+
+  // ensure 3
+  {
+    Message msg;
+    msg.set_from(3);
+    msg.set_to(1);
+    msg.set_type(MsgHeartbeatResp);
+    msg.set_term(r->term_);
+    msg.set_leasesentat(1090);
+    r->step(msg);
+  }
+  r->readMessages(&msgs);
+  EXPECT_TRUE(r->inLease());
+  r->leadTransferee_ = 3;
+  EXPECT_FALSE(r->inLease());
+
+  delete r;
+}
+
+// TestLeaseConfig ensures that a maxClockDrift which leaves no lease is rejected.
+TEST(raftTests, TestLeaseConfig) {
+  vector<uint64_t> peers = {1,2,3};
+  Config *c = newTestConfig(1, peers, 10, 1, new MemoryStorage(&kDefaultLogger));
+  c->leaseDuration = 100;
+  c->maxClockDrift = 100;
+  EXPECT_TRUE(newRaft(c) == NULL);
+
+  c->maxClockDrift = 99;
+  raft *r = newRaft(c);
+  EXPECT_TRUE(r != NULL);
+  EXPECT_EQ(r->leaseTimeout_, 1);
+
+  delete r;
+}
+
 // TestReadOnlyForNewLeader ensures that a leader only accepts MsgReadIndex message
 // when it commits at least one log entry at it term.
 // TODO
@@ -3554,6 +3818,102 @@ TEST(raftTests, TestLeaderAppResp) {
 
 }
 
+// TestFastLogRejection ensures that a follower rejecting a MsgApp hints the
+// last index of its log that may match, along with its term, and that the
+// leader skips the entries of the conflicting terms of both logs in one probe.
+TEST(raftTests, TestFastLogRejection) {
+  struct tmp {
+    EntryVec leaderLog;
+    EntryVec followerLog;
+    uint64_t rejectHintIndex;
+    uint64_t rejectHintTerm;
+    uint64_t nextAppendIndex;
+    uint64_t nextAppendTerm;
+  } tests[] = {
+    // the follower has a longer divergent tail of a smaller term
+    {
+      .leaderLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,4),
+                    initEntry(5,4), initEntry(6,4), initEntry(7,4)},
+      .followerLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,3),
+                      initEntry(5,3), initEntry(6,3), initEntry(7,3), initEntry(8,3),
+                      initEntry(9,3), initEntry(10,3), initEntry(11,3)},
+      .rejectHintIndex = 7, .rejectHintTerm = 3,
+      .nextAppendIndex = 3, .nextAppendTerm = 2,
+    },
+    // the follower has a shorter divergent tail
+    {
+      .leaderLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,4),
+                    initEntry(5,4), initEntry(6,4), initEntry(7,4)},
+      .followerLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,3),
+                      initEntry(5,3)},
+      .rejectHintIndex = 5, .rejectHintTerm = 3,
+      .nextAppendIndex = 3, .nextAppendTerm = 2,
+    },
+    // the follower has a divergent tail of a larger term
+    {
+      .leaderLog = {initEntry(1,1), initEntry(2,1), initEntry(3,1), initEntry(4,1),
+                    initEntry(5,4), initEntry(6,4), initEntry(7,4)},
+      .followerLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,2),
+                      initEntry(5,2), initEntry(6,2), initEntry(7,5)},
+      .rejectHintIndex = 6, .rejectHintTerm = 2,
+      .nextAppendIndex = 4, .nextAppendTerm = 1,
+    },
+    // the follower only matches the first entry
+    {
+      .leaderLog = {initEntry(1,1), initEntry(2,2), initEntry(3,2), initEntry(4,4),
+                    initEntry(5,4), initEntry(6,4), initEntry(7,4)},
+      .followerLog = {initEntry(1,1), initEntry(2,1), initEntry(3,1), initEntry(4,1)},
+      .rejectHintIndex = 4, .rejectHintTerm = 1,
+      .nextAppendIndex = 1, .nextAppendTerm = 1,
+    },
+  };
+
+  size_t i;
+  for (i = 0; i < SIZEOF_ARRAY(tests); ++i) {
+    tmp &t = tests[i];
+    vector<uint64_t> peers = {1, 2};
+
+    MemoryStorage *s1 = new MemoryStorage(&kDefaultLogger);
+    s1->Append(t.leaderLog);
+    HardState hs;
+    hs.set_term(5);
+    s1->SetHardState(hs);
+    raft *leader = newTestRaft(1, peers, 10, 1, s1);
+    leader->becomeCandidate();
+    leader->becomeLeader();
+    MessageVec msgs;
+    leader->readMessages(&msgs);
+
+    MemoryStorage *s2 = new MemoryStorage(&kDefaultLogger);
+    s2->Append(t.followerLog);
+    raft *follower = newTestRaft(2, peers, 10, 1, s2);
+    follower->becomeFollower(leader->term_, 1);
+
+    leader->sendAppend(2);
+    leader->readMessages(&msgs);
+    EXPECT_EQ((int)msgs.size(), 1) << "i: " << i;
+    follower->step(*msgs[0]);
+
+    follower->readMessages(&msgs);
+    EXPECT_EQ((int)msgs.size(), 1) << "i: " << i;
+    Message resp = *msgs[0];
+    EXPECT_EQ(resp.type(), MsgAppResp) << "i: " << i;
+    EXPECT_TRUE(resp.reject()) << "i: " << i;
+    EXPECT_EQ(resp.rejecthint(), t.rejectHintIndex) << "i: " << i;
+    EXPECT_EQ(resp.logterm(), t.rejectHintTerm) << "i: " << i;
+
+    leader->step(resp);
+    leader->readMessages(&msgs);
+    EXPECT_EQ((int)msgs.size(), 1) << "i: " << i;
+    EXPECT_EQ(msgs[0]->type(), MsgApp) << "i: " << i;
+    EXPECT_EQ(msgs[0]->index(), t.nextAppendIndex) << "i: " << i;
+    EXPECT_EQ(msgs[0]->logterm(), t.nextAppendTerm) << "i: " << i;
+
+    delete leader;
+    delete follower;
+  }
+}
+
 // When the leader receives a heartbeat tick, it should
 // send a MsgApp with m.Index = 0, m.LogTerm=0 and empty entries.
 TEST(raftTests, TestBcastBeat) {
@@ -3583,10 +3943,10 @@ TEST(raftTests, TestBcastBeat) {
   }
   r->appendEntry(&entries);
   // slow follower
-  r->progressMap_[2]->match_ = 5;
+  r->progressMap_[2]->setMatch(5);
   r->progressMap_[2]->next_ = 6;
   // normal follower
-  r->progressMap_[3]->match_ = r->raftLog_->lastIndex();
+  r->progressMap_[3]->setMatch(r->raftLog_->lastIndex());
   r->progressMap_[3]->next_ = r->raftLog_->lastIndex() + 1;
 
   {
@@ -3889,7 +4249,7 @@ TEST(raftTests, TestRecvMsgUnreachable) {
 	r->becomeLeader();
 
 	// set node 2 to state replicate
-	r->progressMap_[2]->match_ = 3;
+	r->progressMap_[2]->setMatch(3);
 	r->progressMap_[2]->becomeReplicate();
 	r->progressMap_[2]->optimisticUpdate(5);
 
@@ -4279,6 +4639,254 @@ TEST(raftTests, TestRemoveNode) {
   EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
 }
 
+// TestLearnerElectionTimeout verifies that the learner should not start election
+// even when times out.
+TEST(raftTests, TestLearnerElectionTimeout) {
+  vector<uint64_t> peers, learners;
+  peers.push_back(1);
+  learners.push_back(2);
+  raft *n1 = newTestLearnerRaft(1, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+  raft *n2 = newTestLearnerRaft(2, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+
+  n1->becomeFollower(1, kEmptyPeerId);
+  n2->becomeFollower(1, kEmptyPeerId);
+
+  EXPECT_FALSE(n2->promotable());
+  EXPECT_TRUE(n2->isLearner());
+
+  // n2 is a learner. Learner should not start election even when times out.
+  n2->randomizedElectionTimeout_ = n2->electionTimeout_;
+  int i;
+  for (i = 0; i < n2->electionTimeout_; ++i) {
+    n2->tick();
+  }
+  EXPECT_EQ(n2->state_, StateFollower);
+
+  Message msg;
+  msg.set_from(2);
+  msg.set_to(2);
+  msg.set_type(MsgHup);
+  n2->step(msg);
+  EXPECT_EQ(n2->state_, StateFollower);
+
+  delete n1;
+  delete n2;
+}
+
+// TestLearnerReplication tests that a learner receives the entries of the
+// leader, but the leader commits them without waiting for it.
+TEST(raftTests, TestLearnerReplication) {
+  vector<uint64_t> peers, learners;
+  peers.push_back(1);
+  learners.push_back(2);
+  raft *n1 = newTestLearnerRaft(1, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+  raft *n2 = newTestLearnerRaft(2, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+
+  vector<stateMachine*> sms;
+  sms.push_back(new raftStateMachine(n1));
+  sms.push_back(new raftStateMachine(n2));
+  network *net = newNetwork(sms);
+
+  EXPECT_EQ(n1->quorum(), 1);
+
+  // the leader does not wait for the learner to commit
+  net->isolate(2);
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgHup);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  EXPECT_EQ(n1->state_, StateLeader);
+  uint64_t committed = n1->raftLog_->committed_;
+  EXPECT_EQ(committed, 1);
+
+  // the learner catches up once it is reachable
+  net->recover();
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgProp);
+    msg.add_entries()->set_data("somedata");
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  EXPECT_EQ(n1->raftLog_->committed_, committed + 1);
+  EXPECT_EQ(n2->raftLog_->committed_, n1->raftLog_->committed_);
+  EXPECT_EQ(n1->progressMap_[2]->match_, n1->raftLog_->committed_);
+  EXPECT_EQ(n2->state_, StateFollower);
+
+  // the leader does not transfer the leadership to a learner
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(2);
+    msg.set_to(1);
+    msg.set_type(MsgTransferLeader);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  EXPECT_EQ(n1->leadTransferee_, kEmptyPeerId);
+  EXPECT_EQ(n1->state_, StateLeader);
+
+  delete net;
+}
+
+// TestLearnerPromotion verifies that a learner promoted to a voter counts
+// for the quorum and can campaign.
+TEST(raftTests, TestLearnerPromotion) {
+  vector<uint64_t> peers, learners;
+  peers.push_back(1);
+  learners.push_back(2);
+  raft *n1 = newTestLearnerRaft(1, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+  raft *n2 = newTestLearnerRaft(2, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+
+  vector<stateMachine*> sms;
+  sms.push_back(new raftStateMachine(n1));
+  sms.push_back(new raftStateMachine(n2));
+  network *net = newNetwork(sms);
+
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgHup);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  EXPECT_EQ(n1->state_, StateLeader);
+
+  // the learner catches up on a proposal, a single voter leader does not
+  // broadcast when it is elected
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgProp);
+    msg.add_entries()->set_data("somedata");
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  uint64_t match = n1->progressMap_[2]->match_;
+  EXPECT_EQ(match, n1->raftLog_->lastIndex());
+
+  n1->addNode(2);
+  n2->addNode(2);
+  EXPECT_FALSE(n1->progressMap_[2]->isLearner_);
+  EXPECT_EQ(n1->progressMap_[2]->match_, match);
+  EXPECT_EQ(n1->quorum(), 2);
+  EXPECT_TRUE(n2->promotable());
+
+  // a voter can not be demoted to a learner
+  n1->addLearner(2);
+  EXPECT_FALSE(n1->progressMap_[2]->isLearner_);
+
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(2);
+    msg.set_to(2);
+    msg.set_type(MsgHup);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  EXPECT_EQ(n1->state_, StateFollower);
+  EXPECT_EQ(n2->state_, StateLeader);
+
+  delete net;
+}
+
+// TestAddLearner tests that addLearner could update nodes correctly.
+TEST(raftTests, TestAddLearner) {
+  MemoryStorage *s = new MemoryStorage(&kDefaultLogger);
+  vector<uint64_t> peers;
+  peers.push_back(1);
+  raft *r = newTestRaft(1, peers, 10, 1, s);
+
+  r->addLearner(2);
+  vector<uint64_t> nodes, wnodes;
+  r->learnerNodes(&nodes);
+  wnodes.push_back(2);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+  EXPECT_TRUE(r->progressMap_[2]->isLearner_);
+  EXPECT_EQ(r->quorum(), 1);
+
+  r->nodes(&nodes);
+  wnodes.clear();
+  wnodes.push_back(1);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+
+  r->removeNode(2);
+  r->learnerNodes(&nodes);
+  EXPECT_TRUE(nodes.empty());
+
+  delete r;
+}
+
+// TestRemoveLastVoterWithLearner tests that removing the last voter while a
+// learner remains does not try to commit on an empty quorum.
+TEST(raftTests, TestRemoveLastVoterWithLearner) {
+  vector<uint64_t> peers, learners;
+  peers.push_back(1);
+  learners.push_back(2);
+  raft *r = newTestLearnerRaft(1, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+  r->becomeCandidate();
+  r->becomeLeader();
+  uint64_t committed = r->raftLog_->committed_;
+
+  r->removeNode(1);
+  vector<uint64_t> nodes, wnodes;
+  r->nodes(&nodes);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+  r->learnerNodes(&nodes);
+  wnodes.push_back(2);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+  EXPECT_FALSE(r->maybeCommit());
+  EXPECT_EQ(r->raftLog_->committed_, committed);
+
+  delete r;
+}
+
+// TestRestoreWithLearner restores a snapshot which contains learners.
+TEST(raftTests, TestRestoreWithLearner) {
+  Snapshot ss;
+  ss.mutable_metadata()->set_index(11);
+  ss.mutable_metadata()->set_term(11);
+  ss.mutable_metadata()->mutable_conf_state()->add_nodes(1);
+  ss.mutable_metadata()->mutable_conf_state()->add_nodes(2);
+  ss.mutable_metadata()->mutable_conf_state()->add_learners(3);
+
+  vector<uint64_t> peers, learners;
+  peers.push_back(1);
+  peers.push_back(2);
+  learners.push_back(3);
+  raft *r = newTestLearnerRaft(3, peers, learners, 10, 1, new MemoryStorage(&kDefaultLogger));
+
+  EXPECT_TRUE(r->restore(ss));
+  EXPECT_EQ(r->raftLog_->lastIndex(), ss.metadata().index());
+
+  vector<uint64_t> nodes, wnodes;
+  r->nodes(&nodes);
+  wnodes.push_back(1);
+  wnodes.push_back(2);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+  r->learnerNodes(&nodes);
+  wnodes.clear();
+  wnodes.push_back(3);
+  EXPECT_TRUE(isDeepEqualNodes(nodes, wnodes));
+  EXPECT_TRUE(r->isLearner());
+  EXPECT_EQ(r->quorum(), 2);
+
+  delete r;
+}
+
 TEST(raftTests, TestPromotable) {
   struct tmp {
     vector<uint64_t> peers;
@@ -5201,3 +5809,166 @@ TEST(raftTests, TestTransferNonMember) {
 
   EXPECT_EQ(r->state_, StateFollower);
 }
+
+void quiesceConfig(Config *c) {
+  c->quiesce = true;
+}
+
+// TestQuiesce ensures that an idle leader quiesces the group, the quiescent
+// members neither heartbeat nor campaign, and a proposal wakes them up.
+TEST(raftTests, TestQuiesce) {
+  network *net = newNetworkWithConfig(quiesceConfig, {NULL, NULL, NULL});
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgHup);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+
+  raft *leader = (raft*)net->peers[1]->data();
+  EXPECT_EQ(leader->state_, StateLeader);
+
+  // the next heartbeat is the quiesce heartbeat
+  leader->tick();
+  MessageVec readMsgs;
+  leader->readMessages(&readMsgs);
+  EXPECT_EQ((int)readMsgs.size(), 2);
+  vector<Message> msgs;
+  size_t i;
+  for (i = 0; i < readMsgs.size(); ++i) {
+    EXPECT_TRUE(isQuiesceHeartbeat(*readMsgs[i]));
+    msgs.push_back(*readMsgs[i]);
+  }
+  net->send(&msgs);
+
+  uint64_t id;
+  for (id = 1; id <= 3; ++id) {
+    raft *r = (raft*)net->peers[id]->data();
+    EXPECT_TRUE(r->quiescent_) << "id: " << id;
+    int j;
+    for (j = 0; j < 2 * r->electionTimeout_; ++j) {
+      r->tick();
+    }
+    r->readMessages(&readMsgs);
+    EXPECT_TRUE(readMsgs.empty()) << "id: " << id;
+    EXPECT_EQ(r->state_, id == 1 ? StateLeader : StateFollower);
+  }
+
+  uint64_t lastIndex = leader->raftLog_->lastIndex();
+  {
+    msgs.clear();
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgProp);
+    msg.add_entries()->set_data("somedata");
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+  for (id = 1; id <= 3; ++id) {
+    raft *r = (raft*)net->peers[id]->data();
+    EXPECT_FALSE(r->quiescent_) << "id: " << id;
+    EXPECT_EQ(r->raftLog_->lastIndex(), lastIndex + 1);
+  }
+  delete net;
+}
+
+// TestQuiesceWake ensures that a quiescent follower woken up by the
+// application campaigns after the election timeout.
+TEST(raftTests, TestQuiesceWake) {
+  network *net = newNetworkWithConfig(quiesceConfig, {NULL, NULL, NULL});
+  {
+    vector<Message> msgs;
+    Message msg;
+    msg.set_from(1);
+    msg.set_to(1);
+    msg.set_type(MsgHup);
+    msgs.push_back(msg);
+    net->send(&msgs);
+  }
+
+  raft *leader = (raft*)net->peers[1]->data();
+  leader->tick();
+  MessageVec readMsgs;
+  leader->readMessages(&readMsgs);
+  vector<Message> msgs;
+  size_t i;
+  for (i = 0; i < readMsgs.size(); ++i) {
+    msgs.push_back(*readMsgs[i]);
+  }
+  net->send(&msgs);
+
+  raft *r = (raft*)net->peers[2]->data();
+  EXPECT_TRUE(r->quiescent_);
+  r->wake();
+  EXPECT_FALSE(r->quiescent_);
+  int j;
+  for (j = 0; j < 2 * r->electionTimeout_; ++j) {
+    r->tick();
+  }
+  EXPECT_EQ(r->state_, StateCandidate);
+  delete net;
+}
+
+// TestLeaderParallelAppend ensures that with parallelAppend the leader
+// replicates its entries before they are stable, and only counts itself
+// towards the commit quorum once they are.
+TEST(raftTests, TestLeaderParallelAppend) {
+  MemoryStorage *s = new MemoryStorage(&kDefaultLogger);
+  Config *c = newTestConfig(1, {1, 2, 3}, 10, 1, s);
+  c->parallelAppend = true;
+  raft *r = newRaft(c);
+  r->becomeCandidate();
+  r->becomeLeader();
+  uint64_t li = r->raftLog_->lastIndex();
+  EXPECT_EQ(r->progressMap_[1]->match_, 0);
+
+  MessageVec msgs;
+  r->readMessages(&msgs);
+  Message resp;
+  resp.set_from(2);
+  resp.set_to(1);
+  resp.set_type(MsgAppResp);
+  resp.set_term(r->term_);
+  resp.set_index(li);
+  r->step(resp);
+  // the leader entry is not stable yet
+  EXPECT_EQ(r->raftLog_->committed_, 0);
+
+  SharedEntryVec ents;
+  r->raftLog_->unstableEntries(&ents);
+  s->Append(ents);
+  r->stableTo(li, r->term_);
+  EXPECT_EQ(r->progressMap_[1]->match_, li);
+  EXPECT_EQ(r->raftLog_->committed_, li);
+  r->readMessages(&msgs);
+  EXPECT_EQ((int)msgs.size(), 2);
+  size_t i;
+  for (i = 0; i < msgs.size(); ++i) {
+    EXPECT_EQ(msgs[i]->type(), MsgApp);
+    EXPECT_EQ(msgs[i]->commit(), li);
+  }
+
+  // a proposal is replicated at once
+  Message prop;
+  prop.set_from(1);
+  prop.set_to(1);
+  prop.set_type(MsgProp);
+  prop.add_entries()->set_data("somedata");
+  r->step(prop);
+  r->readMessages(&msgs);
+  // 3 is still probed
+  EXPECT_EQ((int)msgs.size(), 1);
+  EXPECT_EQ(msgs[0]->to(), 2);
+  EXPECT_EQ(msgs[0]->entries_size(), 1);
+  EXPECT_EQ(r->progressMap_[1]->match_, li);
+
+  // stable to an overwritten entry is ignored
+  r->stableTo(li + 1, r->term_ + 1);
+  EXPECT_EQ(r->progressMap_[1]->match_, li);
+
+  delete r;
+}
@@ -126,7 +126,8 @@ network* newNetworkWithConfig(ConfigFun fun, vector<stateMachine*> peers) {
       rf = (raft *)p->data();
       rf->id_ = id;
       for (j = 0; j < size; ++j) {
-        rf->progressMap_[peerAddrs[j]] = new Progress(0, 256, &kDefaultLogger);
+        Progress *pr = rf->progressMap_[peerAddrs[j]];
+        rf->setProgress(peerAddrs[j], 0, 0, pr != NULL && pr->isLearner_);
       }
       rf->reset(rf->term_);
       net->peers[id] = p;
@@ -224,6 +225,13 @@ raft* newTestRaft(uint64_t id, const vector<uint64_t>& peers, int election, int
   return newRaft(newTestConfig(id, peers, election, hb, s));
 }
 
+raft* newTestLearnerRaft(uint64_t id, const vector<uint64_t>& peers, const vector<uint64_t>& learners,
+                        int election, int hb, Storage *s) {
+  Config *c = newTestConfig(id, peers, election, hb, s);
+  c->learners = learners;
+  return newRaft(c);
+}
+
 Config* newTestConfig(uint64_t id, const vector<uint64_t>& peers, int election, int hb, Storage *s) {
   Config *c = new Config();
   c->id = id;
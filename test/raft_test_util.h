@@ -85,10 +85,24 @@ struct blackHole : public stateMachine {
   void* data() { return NULL; } 
 };
 
+// manualClock is a Clock moved forward by hand
+class manualClock : public Clock {
+public:
+  manualClock() : now_(1) {}
+
+  uint64_t Now() {
+    return now_;
+  }
+
+  uint64_t now_;
+};
+
 typedef void (*ConfigFun)(Config*);
 
 extern Config* newTestConfig(uint64_t id, const vector<uint64_t>& peers, int election, int hb, Storage *s);
 extern raft* newTestRaft(uint64_t id, const vector<uint64_t>& peers, int election, int hb, Storage *s);
+extern raft* newTestLearnerRaft(uint64_t id, const vector<uint64_t>& peers, const vector<uint64_t>& learners,
+                               int election, int hb, Storage *s);
 extern network* newNetworkWithConfig(ConfigFun fun, vector<stateMachine*> peers);
 extern network* newNetwork(const vector<stateMachine*>& peers);
 extern void nextEnts(raft *r, MemoryStorage *s, EntryVec *entries);
@@ -104,6 +118,16 @@ initEntry(uint64_t index=0, uint64_t term=0,const string data = "") {
   return entry;
 }
 
+static inline SharedEntryVec
+initSharedEntries(const EntryVec& entries) {
+  SharedEntryVec shared;
+  size_t i;
+  for (i = 0; i < entries.size(); ++i) {
+    shared.push_back(SharedEntry(new Entry(entries[i])));
+  }
+  return shared;
+}
+
 static inline Message 
 initMessage(uint64_t from=0, uint64_t to=0, const MessageType typ=MsgHup, EntryVec *entries = NULL, uint64_t index = 0) { 
     Message msg;
@@ -138,7 +162,7 @@ static inline Progress
 initProgress(uint64_t next, int maxInfilght, Logger *logger, ProgressState state, uint64_t match, uint64_t pendingSnapshot = 0) { 
   Progress progress(next, maxInfilght, logger);
   progress.state_ = state;
-  progress.match_ = match;
+  progress.setMatch(match);
   progress.pendingSnapshot_ = pendingSnapshot;
 
   return progress;
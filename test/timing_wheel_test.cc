@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) lichuang
+ */
+
+#include <gtest/gtest.h>
+#include "libraft.h"
+#include "base/timing_wheel.h"
+
+using namespace libraft;
+
+// advanceTo advances the wheel to tick and returns the tick each timer fired at
+static void
+advanceTo(timingWheel *wheel, uint64_t tick, map<timer*, uint64_t> *fired) {
+  while (wheel->now() < tick) {
+    vector<timer*> expired;
+    wheel->advance(&expired);
+    size_t i;
+    for (i = 0; i < expired.size(); ++i) {
+      EXPECT_FALSE(expired[i]->scheduled());
+      EXPECT_EQ(fired->count(expired[i]), 0);
+      (*fired)[expired[i]] = wheel->now();
+    }
+  }
+}
+
+// TestTimingWheelFire ensures that the timers fire exactly at their deadlines
+// over all the levels of the wheel.
+TEST(timingWheelTests, TestTimingWheelFire) {
+  uint64_t deadlines[] = {
+    1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 100000, 262143, 262144, 300001, 16777217,
+  };
+  size_t n = sizeof(deadlines) / sizeof(deadlines[0]);
+  vector<timer*> timers;
+  timingWheel wheel;
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    timers.push_back(new timer(NULL));
+    wheel.schedule(timers[i], deadlines[i]);
+  }
+  EXPECT_EQ(wheel.size(), n);
+
+  map<timer*, uint64_t> fired;
+  advanceTo(&wheel, deadlines[n - 1], &fired);
+  EXPECT_EQ(wheel.size(), 0);
+  for (i = 0; i < n; ++i) {
+    EXPECT_EQ(fired[timers[i]], deadlines[i]) << "i: " << i;
+    delete timers[i];
+  }
+}
+
+// TestTimingWheelScheduleFromNow ensures that the deadlines are honoured
+// whatever the current tick of the wheel is.
+TEST(timingWheelTests, TestTimingWheelScheduleFromNow) {
+  timingWheel wheel;
+  map<timer*, uint64_t> fired;
+  advanceTo(&wheel, 4000, &fired);
+
+  uint64_t deltas[] = {1, 10, 60, 64, 100, 4000, 4096, 5000, 300000};
+  size_t n = sizeof(deltas) / sizeof(deltas[0]);
+  vector<timer*> timers;
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    timers.push_back(new timer(NULL));
+    wheel.schedule(timers[i], wheel.now() + deltas[i]);
+  }
+  advanceTo(&wheel, 4000 + deltas[n - 1], &fired);
+  for (i = 0; i < n; ++i) {
+    EXPECT_EQ(fired[timers[i]], 4000 + deltas[i]) << "i: " << i;
+    delete timers[i];
+  }
+}
+
+// TestTimingWheelReschedule ensures that rescheduled and cancelled timers
+// fire only at their last deadline or never.
+TEST(timingWheelTests, TestTimingWheelReschedule) {
+  timingWheel wheel;
+  timer t1(NULL), t2(NULL), t3(NULL);
+  wheel.schedule(&t1, 10);
+  wheel.schedule(&t2, 100);
+  wheel.schedule(&t3, 20);
+  EXPECT_EQ(wheel.size(), 3);
+
+  wheel.schedule(&t1, 200);
+  wheel.schedule(&t2, 5);
+  wheel.cancel(&t3);
+  EXPECT_FALSE(t3.scheduled());
+  EXPECT_EQ(wheel.size(), 2);
+
+  map<timer*, uint64_t> fired;
+  advanceTo(&wheel, 300, &fired);
+  EXPECT_EQ(fired[&t1], 200);
+  EXPECT_EQ(fired[&t2], 5);
+  EXPECT_EQ(fired.count(&t3), 0);
+
+  // the passed deadlines fire at the next tick
+  wheel.schedule(&t3, 100);
+  advanceTo(&wheel, 301, &fired);
+  EXPECT_EQ(fired[&t3], 301);
+}
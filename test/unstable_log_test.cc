@@ -46,7 +46,7 @@ TEST(unstableLogTests, TestUnstableMaybeFirstIndex) {
   size_t i;
   for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
     unstableLog unstable;
-    unstable.entries_ = tests[i].entries;
+    unstable.entries_ = initSharedEntries(tests[i].entries);
     unstable.offset_  = tests[i].offset;
     unstable.snapshot_  = tests[i].snapshot;
     unstable.logger_  = NULL;
@@ -96,7 +96,7 @@ TEST(unstableLogTests, TestMaybeLastIndex) {
   size_t i;
   for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
     unstableLog unstable;
-    unstable.entries_ = tests[i].entries;
+    unstable.entries_ = initSharedEntries(tests[i].entries);
     unstable.offset_  = tests[i].offset;
     unstable.snapshot_  = tests[i].snapshot;
     unstable.logger_  = NULL;
@@ -177,7 +177,7 @@ TEST(unstableLogTests, TestUnstableMaybeTerm) {
   size_t i;
   for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
     unstableLog unstable;
-    unstable.entries_ = tests[i].entries;
+    unstable.entries_ = initSharedEntries(tests[i].entries);
     unstable.offset_  = tests[i].offset;
     unstable.snapshot_  = tests[i].snapshot;
     unstable.logger_  = NULL;
@@ -195,7 +195,7 @@ TEST(unstableLogTests, TestUnstableMaybeTerm) {
 
 TEST(unstableLogTests, TestUnstableRestore) {
   unstableLog unstable;
-  unstable.entries_ = {initEntry(5,1)};;
+  unstable.entries_ = initSharedEntries({initEntry(5,1)});
   unstable.offset_  = 5;
   unstable.snapshot_  = newSnapshot(4,1);
   unstable.logger_  = NULL;
@@ -298,7 +298,7 @@ TEST(unstableLogTests, TestUnstableStableTo) {
   size_t i;
   for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
     unstableLog unstable;
-    unstable.entries_ = tests[i].entries;
+    unstable.entries_ = initSharedEntries(tests[i].entries);
     unstable.offset_  = tests[i].offset;
     unstable.snapshot_  = tests[i].snapshot;
     unstable.logger_  = NULL;
@@ -365,7 +365,7 @@ TEST(unstableLogTests, TestUnstableTruncateAndAppend) {
   size_t i;
   for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
     unstableLog unstable;
-    unstable.entries_ = tests[i].entries;
+    unstable.entries_ = initSharedEntries(tests[i].entries);
     unstable.offset_  = tests[i].offset;
     unstable.snapshot_  = tests[i].snapshot;
     unstable.logger_  = &kDefaultLogger;
@@ -374,8 +374,76 @@ TEST(unstableLogTests, TestUnstableTruncateAndAppend) {
     EXPECT_EQ(unstable.offset_, tests[i].woffset) << "i: " << i << ", woffset: " << tests[i].woffset;
     EXPECT_TRUE(isDeepEqualEntries(unstable.entries_, tests[i].wentries)) << "i: " << i;
 
+    // the moving version must give the same result
+    unstableLog moved;
+    moved.entries_ = initSharedEntries(tests[i].entries);
+    moved.offset_  = tests[i].offset;
+    moved.snapshot_  = NULL;
+    moved.logger_  = &kDefaultLogger;
+
+    EntryVec toappend = tests[i].toappend;
+    moved.truncateAndAppend(&toappend);
+    EXPECT_TRUE(toappend.empty()) << "i: " << i;
+    EXPECT_EQ(moved.offset_, tests[i].woffset) << "i: " << i << ", woffset: " << tests[i].woffset;
+    EXPECT_TRUE(isDeepEqualEntries(moved.entries_, tests[i].wentries)) << "i: " << i;
+
     if (tests[i].snapshot != NULL) {
       delete tests[i].snapshot;
     }     
   }
 }
+
+// TestUnstableInProgress ensures that the entries handed out to be persisted
+// are not returned again, unless they are overwritten.
+TEST(unstableLogTests, TestUnstableInProgress) {
+  struct tmp {
+    EntryVec toappend;
+    uint64_t stableIndex, stableTerm;
+    EntryVec wnext;
+  } tests[] = {
+    // new entries after the ones in progress
+    {
+      .toappend = {initEntry(8,1),},
+      .stableIndex = 0, .stableTerm = 0,
+      .wnext = {initEntry(8,1),},
+    },
+    // the entries in progress are overwritten
+    {
+      .toappend = {initEntry(6,2),},
+      .stableIndex = 0, .stableTerm = 0,
+      .wnext = {initEntry(6,2),},
+    },
+    // stable to an entry in progress
+    {
+      .toappend = {initEntry(8,1),},
+      .stableIndex = 6, .stableTerm = 1,
+      .wnext = {initEntry(8,1),},
+    },
+    // stable to the overwritten entries
+    {
+      .toappend = {initEntry(7,2),initEntry(8,2),},
+      .stableIndex = 7, .stableTerm = 1,
+      .wnext = {initEntry(7,2),initEntry(8,2),},
+    },
+  };
+
+  size_t i;
+  for (i = 0;i < SIZEOF_ARRAY(tests); ++i) {
+    unstableLog unstable;
+    unstable.entries_ = initSharedEntries({initEntry(5,1),initEntry(6,1),initEntry(7,1),});
+    unstable.offset_  = 5;
+    unstable.logger_  = &kDefaultLogger;
+
+    unstable.acceptInProgress();
+    SharedEntryVec next;
+    unstable.nextEntries(&next);
+    EXPECT_TRUE(next.empty()) << "i: " << i;
+
+    unstable.truncateAndAppend(tests[i].toappend);
+    if (tests[i].stableIndex != 0) {
+      unstable.stableTo(tests[i].stableIndex, tests[i].stableTerm);
+    }
+    unstable.nextEntries(&next);
+    EXPECT_TRUE(isDeepEqualEntries(next, tests[i].wnext)) << "i: " << i;
+  }
+}